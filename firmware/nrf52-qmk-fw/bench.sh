@@ -0,0 +1,86 @@
+#!/usr/bin/env bash
+#
+# 키 입력 지연 벤치 — native_sim 으로 트레이스를 재생하고 BENCH 줄을 모은다(docs/PORTING-NOTES.md §7.2)
+#
+#   ./bench.sh                  src/sim/traces/*.txt 전부 + 콤보 인덱스 벤치(bench/combo.jsonl)
+#                               + 레이어 캐시 벤치(bench/layer.jsonl) + VIA 처리량 벤치(bench/via.jsonl)
+#                               + 탭/홀드 벡터·벤치(bench/tap.jsonl)
+#   ./bench.sh my_trace.txt     특정 트레이스만
+#
+# 산출:
+#   bench/<trace>.jsonl         키마다 한 줄 + 마지막 줄 summary (접두어 "BENCH " 를 뗀 JSON)
+#   bench/<trace>.hid           HID 줄 — 리졸버(.hid)와 순정 탭 엔진(.vendor.hid)이 같아야 한다
+#   화면                        트레이스마다 summary 한 줄
+#
+# 먼저 ./build.sh native_sim. 노브(QMK_TASK_PERIOD_MS, DEBOUNCE, TAPPING_TERM)를 바꿔 비교하려면
+# 바꾸고 다시 빌드한 뒤 bench/ 를 다른 이름으로 옮겨 두고 돌린다 — summary 의 config 에 조건이 찍힌다.
+#
+# [EEPROM 은 매번 새로] VIA 로 바꾼 디바운스 등이 이전 실행의 eeprom 파일에서 따라오면 같은 빌드끼리도
+# 결과가 달라진다. 실행마다 빈 파일로 시작한다.
+set -e
+
+APP="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+EXE="$APP/build/native_sim/zephyr/zephyr.exe"
+OUT="$APP/bench"
+
+if [ ! -x "$EXE" ]; then
+  echo "먼저 빌드: ./build.sh native_sim"
+  exit 1
+fi
+
+TRACES=("$@")
+COMBO=0
+if [ ${#TRACES[@]} -eq 0 ]; then
+  TRACES=("$APP"/src/sim/traces/*.txt)
+  COMBO=1
+fi
+
+mkdir -p "$OUT"
+EE="$(mktemp)"
+trap 'rm -f "$EE"' EXIT
+
+for trace in "${TRACES[@]}"; do
+  name="$(basename "$trace" .txt)"
+  rm -f "$EE"
+  "$EXE" --bench --matrix-script="$trace" --eeprom="$EE" | sed -n 's/^BENCH //p' > "$OUT/$name.jsonl"
+  printf '%-12s %s\n' "$name" "$(tail -n 1 "$OUT/$name.jsonl")"
+
+  # 같은 트레이스를 순정 탭/홀드 엔진으로 — HID 줄(시각 포함)이 리졸버와 같아야 한다(--tap-vendor).
+  rm -f "$EE"
+  "$EXE" --matrix-script="$trace" --eeprom="$EE" | sed -n '/^HID /p' > "$OUT/$name.hid"
+  rm -f "$EE"
+  "$EXE" --tap-vendor --matrix-script="$trace" --eeprom="$EE" | sed -n '/^HID /p' > "$OUT/$name.vendor.hid"
+  if ! cmp -s "$OUT/$name.hid" "$OUT/$name.vendor.hid"; then
+    echo "$name: 탭 리졸버와 순정 엔진의 리포트가 다르다"
+    diff "$OUT/$name.vendor.hid" "$OUT/$name.hid" | head -n 20
+    exit 1
+  fi
+done
+
+# 콤보 후보 인덱스 — 트레이스 없이 부팅 뒤 벤치 스레드가 합성 콤보 16/64/256 개로 재고 끝낸다(bench.c).
+if [ $COMBO -eq 1 ]; then
+  rm -f "$EE"
+  "$EXE" --combo-bench --eeprom="$EE" | sed -n 's/^BENCH //p' > "$OUT/combo.jsonl"
+  sed 's/^/combo        /' "$OUT/combo.jsonl"
+fi
+
+# 레이어 조회 캐시 — 보드 키맵으로 8 레이어 MO 롤, 캐시 켬/끔(bench.c).
+if [ $COMBO -eq 1 ]; then
+  rm -f "$EE"
+  "$EXE" --layer-bench --eeprom="$EE" | sed -n 's/^BENCH //p' > "$OUT/layer.jsonl"
+  sed 's/^/layer        /' "$OUT/layer.jsonl"
+fi
+
+# VIA 처리량 — 키맵 전체를 순정 명령(28B 왕복)과 벌크로 읽고 써서 1ms 프레임 기준 시간을 잰다(via_bench.c).
+if [ $COMBO -eq 1 ]; then
+  rm -f "$EE"
+  "$EXE" --via-bench --eeprom="$EE" | sed -n 's/^BENCH //p' > "$OUT/via.jsonl"
+  sed 's/^/via          /' "$OUT/via.jsonl"
+fi
+
+# 탭/홀드 리졸버 — QMK 탭핑 벡터 + 순정 엔진과의 무작위 차분, 롤오버/홈로우 모드 이벤트당 비용(tap_vectors.c).
+if [ $COMBO -eq 1 ]; then
+  rm -f "$EE"
+  "$EXE" --tap-vectors --tap-bench --eeprom="$EE" | sed -n 's/^BENCH //p' > "$OUT/tap.jsonl"
+  sed 's/^/tap          /' "$OUT/tap.jsonl"
+fi
@@ -6,8 +6,9 @@
 #   ./build.sh wish65          wish65 릴리스
 #   ./build.sh wish65 -d       wish65 개발(콘솔)
 #   ./build.sh wish60 -d -p    pristine 재빌드
+#   ./build.sh native_sim      리눅스 프로세스(wish40 로직, 하드웨어 없음)
 #
-# 산출물: build/<board>[-debug]/zephyr/zephyr.uf2
+# 산출물: build/<board>[-debug]/zephyr/zephyr.uf2  (native_sim 은 zephyr.exe)
 #
 # [보드별 빌드 폴더] 한 폴더를 공유하면 보드를 바꿀 때마다 pristine 이 필요하고, 그때
 # 다른 보드의 산출물이 지워진다(실제로 겪었다). 보드/빌드타입마다 폴더를 나누면 그럴 일이 없고
@@ -34,7 +35,7 @@ for arg in "$@"; do
     -d|--debug)    DEBUG=y ;;
     -p|--pristine) PRISTINE=always ;;
     -h|--help)
-      sed -n '2,17p' "${BASH_SOURCE[0]}" | sed 's/^# \{0,1\}//'
+      sed -n '2,18p' "${BASH_SOURCE[0]}" | sed 's/^# \{0,1\}//'
       echo "사용 가능한 보드: $(ls -1 "$APP/boards/baram")"
       exit 0 ;;
     -*) echo "알 수 없는 옵션: $arg"; exit 1 ;;
@@ -42,6 +43,17 @@ for arg in "$@"; do
   esac
 done
 
+# native_sim 은 Zephyr 의 시뮬레이터 보드다 — boards/baram 에 없고 SoC 도 없다. 64비트 변형을 쓴다
+# (32비트 기본형은 호스트에 gcc-multilib 이 있어야 한다). docs/PORTING-NOTES.md §7.2
+if [ "$BOARD" = "native_sim" ]; then
+  BUILD="$APP/build/$BOARD${DEBUG:+-debug}"
+  cd "$APP"
+  "$TC/bin/west" build -b native_sim/native/64 -d "$BUILD" -p "$PRISTINE" --no-sysbuild . ${DEBUG:+-- -DDEBUG_CONSOLE=y}
+  echo
+  echo "산출물: ${BUILD#$APP/}/zephyr/zephyr.exe"
+  exit 0
+fi
+
 if [ ! -d "$APP/boards/baram/$BOARD" ]; then
   echo "보드가 없다: $BOARD"
   echo "사용 가능: $(ls -1 "$APP/boards/baram" | tr '\n' ' ')"
@@ -13,6 +13,7 @@
 void apInit(void)
 {
   usbInit();
+  bootProfMark(BOOT_PROF_USB);
 
   moduleInit();
 }
@@ -30,6 +31,7 @@ void apMain(void)
   while(1)
   {
     qmkUpdate();   // keyboard_task(): 매트릭스 스캔 → 액션 처리 → host_driver 전송
+    bootProfMark(BOOT_PROF_LOOP);   // 첫 회차만 기록된다
 
     if (qmkIsIdle())
     {
@@ -50,8 +52,9 @@ void apMain(void)
     else
     {
       // 활성 구간: QMK 디바운스·탭핑이 여기서 돈다. 주기는 키보드 config.h 에서 조정한다.
+      // 마우스키 이동 중엔 transport 주기로 바뀐다(qmkGetTickMs).
       // (RTOS: USB/로그/CLI 스레드에 CPU 양보 — 없으면 그 스레드들이 굶는다)
-      k_msleep(QMK_TASK_PERIOD_MS);
+      qmkWaitTick(qmkGetTickMs());
     }
 
 #ifdef AP_USE_HEARTBEAT_LED
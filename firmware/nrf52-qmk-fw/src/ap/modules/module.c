@@ -27,8 +27,9 @@ bool moduleInit(void)
 {
   bool ret;
 
-  info.count = ((int)&_emodule - (int)&_smodule)/sizeof(module_t);
+  // 포인터 차로 센다 — (int) 캐스트는 native_sim/native/64 에서 주소를 자른다.
   info.p_module = (module_t *)&_smodule;
+  info.count    = (module_t *)&_emodule - info.p_module;
 
   logPrintf("[  ] moduleInit()\n");
   logPrintf("       count : %d\n", info.count);
@@ -19,6 +19,11 @@
 
 #define DYNAMIC_KEYMAP_LAYER_COUNT  8
 
+// EEPROM 맨 끝 1KB = 콤보/탭댄스/키 오버라이드 동적 표(port/via/dynamic_feature.c, port/port.h 의 맵).
+// 매크로 버퍼의 끝을 당겨 자리를 낸다 — 키맵 주소는 안 바뀐다.
+#define DYNAMIC_FEATURE_EEPROM_SIZE 1024
+#define DYNAMIC_KEYMAP_EEPROM_MAX_ADDR (TOTAL_EEPROM_BYTE_COUNT - DYNAMIC_FEATURE_EEPROM_SIZE - 1)
+
 // 매트릭스 (DTS kbd_matrix 노드의 개수와 반드시 일치: wish40 = 4 x 12)
 // row2col 이라 Zephyr 의 구동측(col-gpios) = QMK row 다 — wish60 과 같은 방향이므로
 // MATRIX_DRIVE_IS_QMK_COL 은 **필요 없다**(그건 wish65 처럼 col2row 인 보드용).
@@ -80,6 +85,21 @@
 #define ENABLE_RGB_MATRIX_RAINBOW_BEACON
 #define ENABLE_RGB_MATRIX_RAINBOW_PINWHEELS
 #define ENABLE_RGB_MATRIX_PIXEL_FLOW
+// wish40 은 **per-key** 라 키 반응형이 의미가 있다(위 목록은 언더글로우 보드 ramune60 기준).
+// 키를 안 치는 동안은 안 그리고, 다 식으면 RGB 도 잔다 — port/rgb_matrix/rgb_reactive.h.
+// post_config.h 는 include 되지 않으므로 KEYPRESSES / FRAMEBUFFER 를 직접 켠다.
+// VIA 효과 목록은 .inc 순서라 HEATMAP -> REACTIVE_SIMPLE -> SPLASH 가 PIXEL_FLOW 뒤에 붙는다.
+#define RGB_MATRIX_KEYPRESSES
+#define RGB_MATRIX_FRAMEBUFFER_EFFECTS
+#define ENABLE_RGB_MATRIX_TYPING_HEATMAP
+#define ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
+#define ENABLE_RGB_MATRIX_SPLASH
+// 인디케이터 — wish40 은 Caps LED 가 없다(DTS caps_led 없음). per-key RGB 로 보인다(port/rgb_indicator.h).
+// Caps = LShift(23), 레이어 1 = LT1/Tab(22), 레이어 2 = LT2//(33), 레이어를 올린 동안 BLE 프로파일 = Q~T(1~5).
+// 효과가 꺼져 있어도 켜지고 그동안 레일 전체(42 x ~0.45mA)가 켜진다. idle 소등이면 같이 꺼진다.
+#define RGB_INDICATOR_CAPS_LED      23
+#define RGB_INDICATOR_LAYER_LEDS    { NO_LED, 22, 33 }
+#define RGB_INDICATOR_BLE_LEDS      { 1, 2, 3, 4, 5 }
 
 // HOLD_ON_OTHER_KEY_PRESS 를 **런타임 콜백**으로 받는다 (config.cmake 의 HOLD_OKP_RUNTIME).
 // 이게 없으면 action_tapping.c 의 TAP_GET_HOLD_ON_OTHER_KEY_PRESS 가 상수 false 로 굳어
@@ -29,6 +29,10 @@
 #define ID_QMK_BLE_CHANNEL      16   // BLE 프로파일 (신규)
 #define ID_QMK_DEBOUNCE_CHANNEL 17   // 디바운스 시간 (신규)
 #define ID_QMK_HOLD_OKP_CHANNEL 18   // HOLD_ON_OTHER_KEY_PRESS (신규)
+#define ID_QMK_DYNAMIC_CHANNEL  19   // 콤보/탭댄스/키 오버라이드 동적 표 (신규)
+
+// 벌크 전송은 채널이 아니라 **명령 ID**(0xB0~, via_command_kb)로 들어온다 — port/via/via_bulk.h.
+// 부팅 프로파일 조회도 같은 경로다(0xB7) — port/via/sys_port.h.
 
 // EEPROM 설정을 읽어 적용. qmkInit() 에서 activityInit() 뒤에 호출.
 void viaPortInit(void);
@@ -17,6 +17,10 @@ set(DEBOUNCE_TYPE sym_defer_pk)
 set(DEBOUNCE_RUNTIME ON)
 set(HOLD_OKP_RUNTIME ON)
 
+# 콤보/탭댄스/키 오버라이드를 VIA 로 편집(port/via/dynamic_feature.c). EEPROM 은 config.h 의
+# DYNAMIC_FEATURE_EEPROM_SIZE — 끄더라도 그 예약은 남겨 둔다(매크로 버퍼 끝이 왔다 갔다 하지 않게).
+set(DYNAMIC_FEATURE_ENABLE ON)
+
 # 언더글로우(네오픽셀 16개). DTS: led_strip + ext_power.
 #
 # RGBLIGHT 가 아니라 RGB_MATRIX 를 쓴다 — LED 마다 물리 좌표(x,y)를 알아서 위치 기반 효과
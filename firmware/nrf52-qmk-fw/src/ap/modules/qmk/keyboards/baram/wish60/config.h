@@ -19,6 +19,11 @@
 
 #define DYNAMIC_KEYMAP_LAYER_COUNT  8
 
+// EEPROM 맨 끝 1KB = 콤보/탭댄스/키 오버라이드 동적 표(port/via/dynamic_feature.c, port/port.h 의 맵).
+// 매크로 버퍼의 끝을 당겨 자리를 낸다 — 키맵 주소는 안 바뀐다.
+#define DYNAMIC_FEATURE_EEPROM_SIZE 1024
+#define DYNAMIC_KEYMAP_EEPROM_MAX_ADDR (TOTAL_EEPROM_BYTE_COUNT - DYNAMIC_FEATURE_EEPROM_SIZE - 1)
+
 // 매트릭스 (DTS kscan/keys 노드의 row/col 개수와 반드시 일치: wish60 = 5 x 15)
 #define MATRIX_ROWS                 5
 #define MATRIX_COLS                 15
@@ -4,6 +4,8 @@
 #include "ble_cfg.h"
 #include "debounce_cfg.h"
 #include "hold_okp.h"
+#include "dynamic_feature.h"
+#include "via_bulk.h"
 #include "quantum.h"
 #include "via.h"
 
@@ -19,6 +21,16 @@ void viaPortInit(void)
 #ifdef HOLD_OKP_RUNTIME
   hold_okp_init();
 #endif
+#ifdef DYNAMIC_FEATURE_ENABLE
+  dynamic_feature_init();
+#endif
+}
+
+// QMK via.c 의 weak 훅 오버라이드(명령 단위) — 가로채는 규약은 port/via/via_bulk.h.
+bool via_command_kb(uint8_t *data, uint8_t length)
+{
+  return via_bulk_command(data, length) || via_qmk_boot_prof_command(data, length) ||
+         via_qmk_wake_stat_command(data, length);
 }
 
 // QMK via.c 의 weak 훅 오버라이드. 채널만 보고 각 기능으로 넘긴다.
@@ -42,6 +54,13 @@ void via_custom_value_command_kb(uint8_t *data, uint8_t length)
     return;
   }
 #endif
+#ifdef DYNAMIC_FEATURE_ENABLE
+  if (*channel_id == ID_QMK_DYNAMIC_CHANNEL)
+  {
+    via_qmk_dynamic_feature_command(data, length);
+    return;
+  }
+#endif
 
   if (*channel_id == ID_QMK_POWER_CHANNEL)
   {
@@ -1,6 +1,8 @@
 #include "quantum.h"
 #include "rgb_matrix.h"
 #include "ws2812.h"
+#include "rgb_limiter.h"
+#include "rgb_indicator.h"
 #include "qmk/qmk.h"
 #include <zephyr/device.h>
 
@@ -50,19 +52,28 @@ static void rgb_matrix_ws2812_set_color_all(uint8_t r, uint8_t g, uint8_t b)
  * 순서라, 검은 프레임을 쏘는 이 flush 안에서는 아직 false 다. 그리고 이게 검정을 쏘는
  * **유일한** 기회다(그 뒤 루프는 잔다). -> qmkIsSuspended() 를 쓴다.
  *
+ * 효과가 꺼져 있어도 인디케이터 오버레이가 있으면 레일을 켜 둔다(port/rgb_indicator.h).
+ * 끌 때는 오버레이도 지운다 — 안 지우면 마지막 "검은" 프레임에 인디케이터가 남는다.
+ *
  * 끌 때 순서: 검은색을 먼저 쏘고 전원을 내린다(ws2812SetPower 주석 참고).
+ * 켤 때는 기다리지 않는다 — 레일은 워크 큐에서 올라오고 이 루프는 막히지 않는다(ws2812.c).
  * 전원/SPI 를 실제로 다루는 건 hw/driver/ws2812.c 다 — 여기는 "언제" 만 정한다.
  */
 static void rgb_matrix_ws2812_flush(void)
 {
-  bool want_on = rgb_matrix_is_enabled() && !qmkIsSuspended();
+  bool want_on = (rgb_matrix_is_enabled() || rgb_indicator_is_active()) && !qmkIsSuspended();
 
   if (want_on)
   {
     ws2812SetPower(true);
   }
+  else
+  {
+    ws2812SetOverlay(NULL, 0);
+  }
 
-  ws2812Refresh();   // 전원이 꺼져 있으면 알아서 건너뛴다
+  rgb_limiter_apply();   // 전류 예산을 넘으면 이번 전송만 줄인다(port/rgb_limiter.h)
+  ws2812Refresh();       // 꺼져 있으면 건너뛰고, 올라오는 중이면 레일이 안정된 뒤 나간다
 
   if (!want_on)
   {
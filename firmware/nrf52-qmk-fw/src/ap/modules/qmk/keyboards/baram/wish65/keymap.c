@@ -31,3 +31,10 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
         { KC_TRNS, KC_TRNS, KC_TRNS, KC_NO,   KC_NO,   KC_NO,   KC_TRNS, KC_NO,   KC_NO,   KC_NO,   KC_TRNS, KC_TRNS, KC_NO,   KC_TRNS, KC_TRNS, KC_TRNS }
     }
 };
+
+/*
+ * 콤보 — 기본은 비어 있다. 콤보에 든 키는 COMBO_TERM 동안 붙잡혔다가 나가므로(그 키의 타이핑 지연)
+ * 키맵이 기본으로 걸지 않는다. 넣는 법: `const uint16_t PROGMEM jk[] = {KC_J, KC_K, COMBO_END};` +
+ * `COMBO(jk, KC_ESC)`. 후보 인덱스/판정 데드라인은 port/combo/combo_port.h.
+ */
+combo_t key_combos[] = {};
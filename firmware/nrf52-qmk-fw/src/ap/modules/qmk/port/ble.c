@@ -17,6 +17,7 @@
 #include "battery.h"
 #include "qmk/qmk.h"
 #include "cli.h"
+#include "boot_prof.h"
 
 #if CLI_USE(HW_BLE)
 static void cliBle(cli_args_t *args);
@@ -25,7 +26,7 @@ static void cliBle(cli_args_t *args);
 /*
  * BLE HID (HOG) — NCS BT_HIDS 사용. (ZMK 는 GATT 를 직접 짜지만 NCS 는 기성 서비스 제공)
  *
- * 리포트 맵: 키보드(ID1)+LED out, System(ID3), Consumer(ID4).
+ * 리포트 맵: 키보드(ID1)+LED out, 마우스(ID2), System(ID3), Consumer(ID4), VIA raw HID(ID9, in/out 32B).
  * USB 쪽(usb_hid.c 의 exk 디스크립터)과 Report ID 규약을 맞춰 QMK 코드가 동일하게 동작한다.
  * HOG 에서는 각 리포트가 별도 characteristic 이라 payload 에 Report ID 를 넣지 않는다
  * (ID 는 Report Reference 디스크립터가 가짐) → usage 2바이트만 전송.
@@ -35,32 +36,46 @@ static void cliBle(cli_args_t *args);
 
 #define BLE_KBD_REPORT_LEN          8   // mods + reserved + keys[6]
 #define BLE_EXTRA_REPORT_LEN        2   // usage16
+#define BLE_MOUSE_REPORT_LEN        5   // buttons + x + y + wheel + pan (report_mouse_t)
 #define BLE_LED_REPORT_LEN          1
+#define BLE_VIA_REPORT_LEN          32  // QMK RAW_EPSIZE — USB VIA 인터페이스와 같은 크기
 
 #define BLE_REP_ID_KEYS             1
+#define BLE_REP_ID_MOUSE            2
 #define BLE_REP_ID_SYSTEM           3
 #define BLE_REP_ID_CONSUMER         4
+#define BLE_REP_ID_VIA              9   // QMK report.h 의 REPORT_ID_* (1~8) 와 겹치지 않게
+
+// 마우스는 QMK 구조체를 그대로 싣는다 — MOUSE_EXTENDED_REPORT 를 켜면 배치가 달라진다.
+BUILD_ASSERT(sizeof(report_mouse_t) == BLE_MOUSE_REPORT_LEN, "report_mouse_t 배치가 report_map 과 다르다");
 
 enum
 {
   BLE_INP_KEYS_IDX = 0,
   BLE_INP_SYSTEM_IDX,
   BLE_INP_CONSUMER_IDX,
+  BLE_INP_VIA_IDX,
+  BLE_INP_MOUSE_IDX,
 };
 
 enum
 {
   BLE_OUTP_LED_IDX = 0,
+  BLE_OUTP_VIA_IDX,
 };
 
 BT_HIDS_DEF(hids_obj,
             BLE_LED_REPORT_LEN,
             BLE_KBD_REPORT_LEN,
             BLE_EXTRA_REPORT_LEN,
-            BLE_EXTRA_REPORT_LEN);
+            BLE_EXTRA_REPORT_LEN,
+            BLE_VIA_REPORT_LEN,
+            BLE_VIA_REPORT_LEN,
+            BLE_MOUSE_REPORT_LEN);
 
 static uint8_t         led_state;
-static bool            is_init = false;
+static bool            is_init = false;   // 메인 루프만 쓴다(bleUpdate) — 준비 신호는 stack_ready
+static atomic_t        stack_ready;       // ble_ready()(워크큐)가 settings_load() 뒤에 세운다
 
 /*
  * 프로파일 (ZMK app/src/ble.c 패턴).
@@ -247,6 +262,28 @@ static const uint8_t report_map[] = {
   0x91, 0x01,       /*   Output (Const)       : padding */
   0xC0,
 
+  /* Mouse (Report ID 2) — usb_hid.c hid_report_mouse_desc 와 같은 배치 */
+  0x05, 0x01,       /* Usage Page (Generic Desktop) */
+  0x09, 0x02,       /* Usage (Mouse) */
+  0xA1, 0x01,
+  0x85, BLE_REP_ID_MOUSE,
+  0x09, 0x01,       /*   Usage (Pointer) */
+  0xA1, 0x00,
+  0x05, 0x09, 0x19, 0x01, 0x29, 0x08,
+  0x15, 0x00, 0x25, 0x01,
+  0x95, 0x08, 0x75, 0x01,
+  0x81, 0x02,       /*     Input (Data,Var,Abs) : buttons */
+  0x05, 0x01, 0x09, 0x30, 0x09, 0x31, 0x09, 0x38,
+  0x15, 0x81, 0x25, 0x7F,
+  0x95, 0x03, 0x75, 0x08,
+  0x81, 0x06,       /*     Input (Data,Var,Rel) : x, y, wheel */
+  0x05, 0x0C, 0x0A, 0x38, 0x02,
+  0x15, 0x81, 0x25, 0x7F,
+  0x95, 0x01, 0x75, 0x08,
+  0x81, 0x06,       /*     Input (Data,Var,Rel) : AC Pan */
+  0xC0,
+  0xC0,
+
   /* System control (Report ID 3) */
   0x05, 0x01,       /* Usage Page (Generic Desktop) */
   0x09, 0x80,       /* Usage (System Control) */
@@ -268,6 +305,21 @@ static const uint8_t report_map[] = {
   0x95, 0x01, 0x75, 0x10,
   0x81, 0x00,
   0xC0,
+
+  /* VIA raw HID (Report ID 9) — usb_hid.c hid_report_via_desc 와 같은 usage(0xFF60/0x61) */
+  0x06, 0x60, 0xFF, /* Usage Page (Vendor Defined) */
+  0x09, 0x61,       /* Usage (Vendor Defined) */
+  0xA1, 0x01,
+  0x85, BLE_REP_ID_VIA,
+  0x09, 0x62,       /*   Data to host */
+  0x15, 0x00, 0x26, 0xFF, 0x00,
+  0x95, BLE_VIA_REPORT_LEN, 0x75, 0x08,
+  0x81, 0x02,
+  0x09, 0x63,       /*   Data from host */
+  0x15, 0x00, 0x26, 0xFF, 0x00,
+  0x95, BLE_VIA_REPORT_LEN, 0x75, 0x08,
+  0x91, 0x02,
+  0xC0,
 };
 // clang-format on
 
@@ -311,7 +363,7 @@ static void led_outp_rep_handler(struct bt_hids_rep *rep, struct bt_conn *conn,
   if (led_state != rep->data[0])
   {
     led_state = rep->data[0];
-    qmkWake();   // led_task() 가 폴링한다 — 루프가 자고 있으면 반영이 안 된다
+    qmkWake(WAKE_REASON_HOST_LED);   // led_task() 가 폴링한다 — 루프가 자고 있으면 반영이 안 된다
   }
 }
 
@@ -320,6 +372,119 @@ static void boot_kb_outp_rep_handler(struct bt_hids_rep *rep, struct bt_conn *co
   led_outp_rep_handler(rep, conn, write);
 }
 
+/*
+ * VIA over BLE — 호스트가 VIA output 리포트를 쓰면 여기로 온다(BT RX 스레드).
+ *
+ * [버퍼] rep->data 는 HIDS 가 가진 리포트 저장소라 다음 write 가 덮는다. 수신 콜백(via_hid.c)이
+ * 그 자리에서 **공유 풀 버퍼로 한 번** 복사하고, 그 뒤로는 포인터만 넘어간다 — 키보드 리포트
+ * 경로와 공유하는 버퍼가 없다. 처리는 메인 루프(via_hid_task)가 한다.
+ * [세션] conn ref 는 여기서 바로 잡고(via_lock), 연결 파라미터 요청만 시스템 워크큐로 미룬다 —
+ * BT RX 스레드에서 L2CAP 시그널링 버퍼를 기다리면 수신이 선다.
+ * [응답 대상] 요청이 온 conn 으로 돌려준다. 활성 프로파일이 아닌 호스트가 VIA 를 열어도 된다.
+ *
+ * VIA 패킷이 오면 빠른 연결 파라미터(7.5ms, latency 0)를 요청하고, BLE_VIA_SESSION_MS 동안
+ * 조용하면 prj.conf 의 기본값으로 되돌린다. 기본값(latency 30)이면 호스트→디바이스 write 가
+ * 최대 ~465ms 늦게 와서 VIA 로딩이 수십 초 걸린다. 세션이 끝나면 idle 전력은 원래대로다.
+ */
+#define BLE_VIA_SESSION_MS    3000
+
+static bool (*ble_via_receive_cb)(uint8_t *data, uint8_t length);
+static struct bt_conn   *via_conn;    // 쓰기는 BT RX 스레드/워크큐, 읽기는 메인 루프 — via_lock
+static struct k_spinlock via_lock;
+
+static void ble_via_param_work_handler(struct k_work *work);
+static void ble_via_idle_work_handler(struct k_work *work);
+static K_WORK_DEFINE(ble_via_param_work, ble_via_param_work_handler);
+static K_WORK_DELAYABLE_DEFINE(ble_via_idle_work, ble_via_idle_work_handler);
+
+// 락 안에서 ref 를 잡아 돌려준다. 없으면 NULL. 호출자가 unref.
+static struct bt_conn *ble_via_conn_get(void)
+{
+  struct bt_conn  *conn;
+  k_spinlock_key_t key = k_spin_lock(&via_lock);
+
+  conn = (via_conn != NULL) ? bt_conn_ref(via_conn) : NULL;
+  k_spin_unlock(&via_lock, key);
+  return conn;
+}
+
+static void ble_via_session_touch(struct bt_conn *conn)
+{
+  struct bt_conn  *old   = NULL;
+  bool             start = false;
+  k_spinlock_key_t key   = k_spin_lock(&via_lock);
+
+  if (via_conn != conn)
+  {
+    old      = via_conn;
+    via_conn = bt_conn_ref(conn);
+    start    = true;
+  }
+  k_spin_unlock(&via_lock, key);
+
+  if (old != NULL)
+  {
+    bt_conn_unref(old);
+  }
+  if (start)
+  {
+    k_work_submit(&ble_via_param_work);   // 새 세션 -> 빠른 파라미터(워크큐에서)
+  }
+  k_work_reschedule(&ble_via_idle_work, K_MSEC(BLE_VIA_SESSION_MS));
+}
+
+static void ble_via_param_work_handler(struct k_work *work)
+{
+  struct bt_conn *conn = ble_via_conn_get();
+
+  if (conn == NULL)
+  {
+    return;
+  }
+
+  int err = bt_conn_le_param_update(conn, BT_LE_CONN_PARAM(6, 6, 0, CONFIG_BT_PERIPHERAL_PREF_TIMEOUT));
+  logPrintf("[  ] ble via session start (fast conn param %d)\n", err);
+  bt_conn_unref(conn);
+}
+
+static void ble_via_idle_work_handler(struct k_work *work)
+{
+  struct bt_conn  *conn;
+  k_spinlock_key_t key = k_spin_lock(&via_lock);
+
+  conn     = via_conn;
+  via_conn = NULL;
+  k_spin_unlock(&via_lock, key);
+
+  if (conn == NULL)
+  {
+    return;
+  }
+
+  bt_conn_le_param_update(conn, BT_LE_CONN_PARAM(CONFIG_BT_PERIPHERAL_PREF_MIN_INT,
+                                                 CONFIG_BT_PERIPHERAL_PREF_MAX_INT,
+                                                 CONFIG_BT_PERIPHERAL_PREF_LATENCY,
+                                                 CONFIG_BT_PERIPHERAL_PREF_TIMEOUT));
+  bt_conn_unref(conn);
+  logPrintf("[  ] ble via session end\n");
+}
+
+static void via_outp_rep_handler(struct bt_hids_rep *rep, struct bt_conn *conn, bool write)
+{
+  if (!write)
+  {
+    return;
+  }
+
+  ble_via_session_touch(conn);
+
+  if (ble_via_receive_cb != NULL)
+  {
+    // 풀이 비면 false — GATT write 는 이미 응답이 나갔으니 되돌릴 수 없다. via_hid.c 가 센다.
+    ble_via_receive_cb(rep->data, MIN(rep->size, BLE_VIA_REPORT_LEN));
+  }
+}
+
 /*
  * settings(NVS) 저장. 키 이름은 ZMK 와 같은 규약을 쓴다.
  *   ble/profiles/<n> : 해당 프로파일의 peer 주소
@@ -430,6 +595,10 @@ uint8_t bleProfileGetActive(void)
  */
 static bool adv_running = false;
 
+// 메인 루프(프로파일 전환)와 BT RX 스레드(연결/해제/페어링)가 같이 부른다. 재귀 mutex 라 connected() 가
+// 잡은 채로 다시 들어와도 된다.
+static K_MUTEX_DEFINE(adv_lock);
+
 static void ble_advertising_update(void)
 {
   bool want_adv;
@@ -440,10 +609,13 @@ static void ble_advertising_update(void)
     return;
   }
 
+  k_mutex_lock(&adv_lock, K_FOREVER);
+
   want_adv = bleProfileIsOpen(active_profile) || !bleProfileIsConnected(active_profile);
 
   if (want_adv == adv_running)
   {
+    k_mutex_unlock(&adv_lock);
     return;
   }
 
@@ -453,6 +625,7 @@ static void ble_advertising_update(void)
     if (err && err != -EALREADY)
     {
       logPrintf("[E_] ble adv start (%d)\n", err);
+      k_mutex_unlock(&adv_lock);
       return;
     }
     if (!ble_loop_muted())
@@ -467,20 +640,26 @@ static void ble_advertising_update(void)
     if (err && err != -EALREADY)
     {
       logPrintf("[E_] ble adv stop (%d)\n", err);
+      k_mutex_unlock(&adv_lock);
       return;
     }
     logPrintf("[  ] ble adv stop (profile %d connected)\n", active_profile);
   }
 
   adv_running = want_adv;
+  k_mutex_unlock(&adv_lock);
 }
 
 /*
  * TX power — Zephyr 표준 VS HCI 로 설정한다(§ble.h 주석 참고).
  * 핸들 종류마다 따로 걸어야 한다: 광고(ADV)와 **연결(CONN)은 별개**다.
  * 그래서 새 연결이 생길 때마다 connected() 에서 다시 적용한다.
+ *
+ * 0dBm 도 명시적으로 건다. 한 번도 정하지 않았을 때(tx_power_set == false)만 컨트롤러 기본값에 맡긴다 —
+ * 예전엔 0 을 "안 정함" 으로 겸해서, +8dBm 에서 0dBm 프리셋으로 내리면 이미 맺힌 연결은 +8 에 남았다.
  */
 static int8_t tx_power_dbm = 0;
+static bool   tx_power_set = false;
 
 static int ble_tx_power_apply(uint8_t handle_type, uint16_t handle, int8_t dbm)
 {
@@ -521,9 +700,9 @@ static void ble_tx_power_apply_conn(struct bt_conn *conn)
 {
   uint16_t handle;
 
-  if (tx_power_dbm == 0)
+  if (!tx_power_set)
   {
-    return;   // 0dBm = 컨트롤러 기본값 → 굳이 명령을 보내지 않는다
+    return;   // 정한 적이 없다 → 컨트롤러 기본값 그대로
   }
   if (bt_hci_get_conn_handle(conn, &handle) == 0)
   {
@@ -534,6 +713,12 @@ static void ble_tx_power_apply_conn(struct bt_conn *conn)
 bool bleSetTxPower(int8_t dbm)
 {
   tx_power_dbm = dbm;
+  tx_power_set = true;
+
+  if (!is_init)
+  {
+    return true;   // 스택 준비 전(부팅 중) — bleUpdate() 가 적용한다
+  }
 
   // 광고에 적용. 연결에는 각 conn 마다 따로 걸어야 한다.
   if (ble_tx_power_apply(BT_HCI_VS_LL_HANDLE_TYPE_ADV, 0, dbm) != 0)
@@ -584,8 +769,10 @@ static void connected(struct bt_conn *conn, uint8_t err)
 
   // 여러 호스트가 동시에 붙을 수 있다. conn 을 우리가 붙들지 않고(ref 안 함) 필요할 때
   // 활성 프로파일 주소로 조회한다 -> 프로파일 전환이 곧 전송 대상 전환이 된다.
+  k_mutex_lock(&adv_lock, K_FOREVER);
   adv_running = false;   // 연결되면 컨트롤러가 광고를 멈춘다
   ble_advertising_update();
+  k_mutex_unlock(&adv_lock);
 
   k_work_schedule(&bas_work, K_NO_WAIT);   // 연결 직후 1회 + 이후 60초 주기
 }
@@ -729,12 +916,28 @@ static void hid_init(void)
   inp->id    = BLE_REP_ID_CONSUMER;
   init_param.inp_rep_group_init.cnt++;
 
+  inp        = &init_param.inp_rep_group_init.reports[BLE_INP_VIA_IDX];
+  inp->size  = BLE_VIA_REPORT_LEN;
+  inp->id    = BLE_REP_ID_VIA;
+  init_param.inp_rep_group_init.cnt++;
+
+  inp        = &init_param.inp_rep_group_init.reports[BLE_INP_MOUSE_IDX];
+  inp->size  = BLE_MOUSE_REPORT_LEN;
+  inp->id    = BLE_REP_ID_MOUSE;
+  init_param.inp_rep_group_init.cnt++;
+
   outp          = &init_param.outp_rep_group_init.reports[BLE_OUTP_LED_IDX];
   outp->size    = BLE_LED_REPORT_LEN;
   outp->id      = BLE_REP_ID_KEYS;
   outp->handler = led_outp_rep_handler;
   init_param.outp_rep_group_init.cnt++;
 
+  outp          = &init_param.outp_rep_group_init.reports[BLE_OUTP_VIA_IDX];
+  outp->size    = BLE_VIA_REPORT_LEN;
+  outp->id      = BLE_REP_ID_VIA;
+  outp->handler = via_outp_rep_handler;
+  init_param.outp_rep_group_init.cnt++;
+
   init_param.is_kb                     = true;
   init_param.boot_kb_outp_rep_handler  = boot_kb_outp_rep_handler;
 
@@ -745,25 +948,21 @@ static void hid_init(void)
   }
 }
 
-bool bleInit(void)
+/*
+ * bt_enable() 콜백 — **시스템 워크큐**에서 불린다. 스택 초기화(HCI 왕복)와 본딩 로드(settings_load,
+ * NVS 스캔)가 여기까지의 몫이라, 이걸 메인 스레드에서 기다리면 매트릭스/USB 가 그만큼 늦게 뜬다.
+ *
+ * 여기선 **로드까지만** 하고 메인 루프를 깨운다. 나머지(이름, is_init, TX power, 광고)는 bleUpdate() 가
+ * 메인 루프에서 한다 — is_init / active_profile 을 메인 루프가 락 없이 읽으므로 그 둘을 바꾸는 쪽도
+ * 메인 루프여야 한다. settings_load() 가 active_profile 을 쓰는 동안엔 is_init 이 false 라 메인 루프가
+ * 프로파일을 건드리지 않고(bleProfileSelect 거절), stack_ready 는 로드가 끝난 뒤에 선다.
+ */
+static void ble_ready(int err)
 {
-  int err;
-
-  hid_init();
-
-  for (int i = 0; i < BLE_PROFILE_COUNT; i++)
-  {
-    bt_addr_le_copy(&profiles[i].peer, BT_ADDR_LE_ANY);
-  }
-
-  bt_conn_auth_cb_register(&auth_cb);
-  bt_conn_auth_info_cb_register(&auth_info_cb);
-
-  err = bt_enable(NULL);
   if (err)
   {
     logPrintf("[E_] bt_enable (%d)\n", err);
-    return false;
+    return;
   }
 
   // 본딩 정보 로드 (BT_SETTINGS, storage_partition/NVS)
@@ -772,6 +971,17 @@ bool bleInit(void)
     settings_load();
   }
 
+  atomic_set(&stack_ready, 1);
+  qmkWake(WAKE_REASON_BLE);
+}
+
+void bleUpdate(void)
+{
+  if (is_init || !atomic_get(&stack_ready))
+  {
+    return;
+  }
+
   /*
    * BLE 이름 = 키보드 config.h 의 KBD_NAME + 주소 유래 해시 (USB 제품명과 같은 출처).
    *
@@ -784,14 +994,44 @@ bool bleInit(void)
   ble_name_init();
 
   is_init = true;
+
+  // 준비 전에 들어온 TX power(ble_cfg.c 가 부팅 때 건다)를 여기서 적용한다.
+  if (tx_power_set)
+  {
+    ble_tx_power_apply(BT_HCI_VS_LL_HANDLE_TYPE_ADV, 0, tx_power_dbm);
+  }
   ble_advertising_update();
 
+  bootProfMark(BOOT_PROF_BLE);
+  logPrintf("[OK] bleInit() %s profile %d/%d %s\n", name_buf, active_profile, BLE_PROFILE_COUNT,
+            bleProfileIsOpen(active_profile) ? "(open)" : "(bonded)");
+}
+
+bool bleInit(void)
+{
+  int err;
+
+  hid_init();
+
+  for (int i = 0; i < BLE_PROFILE_COUNT; i++)
+  {
+    bt_addr_le_copy(&profiles[i].peer, BT_ADDR_LE_ANY);
+  }
+
+  bt_conn_auth_cb_register(&auth_cb);
+  bt_conn_auth_info_cb_register(&auth_info_cb);
+
+  // 콜백을 주면 bt_enable() 은 바로 돌아오고 나머지는 ble_ready() / bleUpdate() 가 한다(qmkInit 부팅 순서 참고).
+  err = bt_enable(ble_ready);
+  if (err)
+  {
+    logPrintf("[E_] bt_enable (%d)\n", err);
+    return false;
+  }
+
 #if CLI_USE(HW_BLE)
   cliAdd("ble", cliBle);
 #endif
-
-  logPrintf("[OK] bleInit() %s profile %d/%d %s\n", name_buf, active_profile, BLE_PROFILE_COUNT,
-            bleProfileIsOpen(active_profile) ? "(open)" : "(bonded)");
   return true;
 }
 
@@ -837,17 +1077,78 @@ bool bleSendExtra(report_extra_t *report)
   return ble_send(idx, (const uint8_t *)&report->usage, BLE_EXTRA_REPORT_LEN);
 }
 
+bool bleSendMouse(report_mouse_t *report)
+{
+  // report_mouse_t 그대로(MOUSE_SHARED_EP 가 아니라 Report ID 필드가 없다)
+  return ble_send(BLE_INP_MOUSE_IDX, (const uint8_t *)report, BLE_MOUSE_REPORT_LEN);
+}
+
+uint32_t bleGetConnIntervalUs(void)
+{
+  struct bt_conn     *conn;
+  struct bt_conn_info info;
+  uint32_t            interval_us = 0;
+
+  if (!is_init)
+  {
+    return 0;
+  }
+
+  conn = ble_profile_conn(active_profile);
+  if (conn == NULL)
+  {
+    return 0;
+  }
+  if (bt_conn_get_info(conn, &info) == 0)
+  {
+    interval_us = info.le.interval * 1250U;   // 단위 1.25ms
+  }
+  bt_conn_unref(conn);
+
+  return interval_us;
+}
+
 uint8_t bleGetKbdLeds(void)
 {
   return led_state;
 }
 
+void bleSetViaReceiveFunc(bool (*func)(uint8_t *data, uint8_t length))
+{
+  ble_via_receive_cb = func;
+}
+
+// 메인 루프(via_hid_task → raw_hid_send)에서 불린다. 세션이 그 사이 끝나도 conn 이 살아 있도록
+// 락 안에서 ref 를 잡고 보낸다.
+bool bleSendVia(uint8_t *data, uint8_t len)
+{
+  struct bt_conn *conn;
+  int             err;
+
+  if (!is_init)
+  {
+    return false;
+  }
+
+  conn = ble_via_conn_get();
+  if (conn == NULL)
+  {
+    return false;
+  }
+
+  // ATT MTU 가 35(32B + 헤더 3B) 미만이면 실패한다. prj.conf 의 BT_L2CAP_TX_MTU 참고.
+  err = bt_hids_inp_rep_send(&hids_obj, conn, BLE_INP_VIA_IDX, data, MIN(len, BLE_VIA_REPORT_LEN), NULL);
+  bt_conn_unref(conn);
+  return err == 0;
+}
+
 
 // ---- 프로파일 전환 --------------------------------------------------------------
 
 bool bleProfileSelect(uint8_t index)
 {
-  if (index >= BLE_PROFILE_COUNT || index == active_profile)
+  // 스택 준비 전엔 settings_load() 가 active_profile 을 덮으므로 받지 않는다.
+  if (!is_init || index >= BLE_PROFILE_COUNT || index == active_profile)
   {
     return false;
   }
@@ -877,7 +1178,7 @@ bool bleProfilePrev(void)
 
 bool bleProfileClear(uint8_t index)
 {
-  if (index >= BLE_PROFILE_COUNT || bleProfileIsOpen(index))
+  if (!is_init || index >= BLE_PROFILE_COUNT || bleProfileIsOpen(index))
   {
     return false;   // 범위 밖이거나 이미 비어있음
   }
@@ -906,6 +1207,11 @@ bool bleProfileClearActive(void)
 
 void bleProfileClearAll(void)
 {
+  if (!is_init)
+  {
+    return;
+  }
+
   // 연결부터 끊는다(본딩만 지우면 호스트는 붙어 있다고 믿는 어긋난 상태가 된다).
   for (int i = 0; i < BLE_PROFILE_COUNT; i++)
   {
@@ -956,6 +1262,7 @@ void cliBle(cli_args_t *args)
                 bleProfileIsConnected(i) ? "connected" : "");
     }
     cliPrintf("advertising    : %s\n", adv_running ? "yes" : "no");
+    cliPrintf("via session    : %s\n", via_conn != NULL ? "active" : "-");
 
     if (loop_cnt > 0)
     {
@@ -8,9 +8,10 @@
  * BLE HID (HOG) — NCS BT_HIDS 기반.
  * 리포트 구성(USB exk 와 동일한 Report ID 규약):
  *   ID 1 : 키보드 (mods + reserved + keys[6], 8B) + LED output
+ *   ID 2 : 마우스 (buttons + x + y + wheel + pan, 5B — USB mouse 인터페이스와 같은 배치)
  *   ID 3 : System control (usage16)
  *   ID 4 : Consumer control (usage16)
- * (마우스는 ID 2 로 확장 예정)
+ *   ID 9 : VIA raw HID (in/out 32B, usage page 0xFF60) — 케이블 없이 VIA 설정
  */
 
 // 호스트 프로파일 개수. ZMK 기본값과 동일(CONFIG_BT_MAX_PAIRED 와 맞출 것).
@@ -18,16 +19,29 @@
 
 bool bleInit(void);
 
+// 메인 루프(qmkUpdate)에서. 스택이 준비되면(본딩 로드 끝) 한 번 광고/TX power 를 올린다. 그 뒤론 바로 돌아온다.
+void bleUpdate(void);
+
 // 현재 BLE 로 리포트를 보낼 수 있는 상태인지(활성 프로파일이 연결됨)
 bool bleIsConnected(void);
 
 // QMK host_driver(port/driver_ble.c) 가 호출하는 전송 API
 bool bleSendKeyboard(report_keyboard_t *report);
 bool bleSendExtra(report_extra_t *report);
+bool bleSendMouse(report_mouse_t *report);
+
+// 활성 프로파일 연결의 connection interval(us). 연결이 없으면 0.
+// 리포트가 실제로 나가는 주기라 마우스키 반복 주기를 여기에 맞춘다(port/mousekey_port.c).
+uint32_t bleGetConnIntervalUs(void);
 
 // 호스트가 보낸 LED 상태(CapsLock 등)
 uint8_t bleGetKbdLeds(void);
 
+// VIA raw HID. 수신 콜백은 시스템 워크큐에서 불린다(복사만 할 것). 응답(bleSendVia)은 메인 루프에서
+// 부르고, 요청이 온 연결로 나간다.
+void    bleSetViaReceiveFunc(bool (*func)(uint8_t *data, uint8_t length));
+bool    bleSendVia(uint8_t *data, uint8_t len);
+
 
 /*
  * 프로파일 — 호스트 5대 전환 (ZMK app/src/ble.c 패턴).
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 콤보(quantum/process_keycode/process_combo.c)의 **후보 인덱스 + 데드라인 내보내기 + 비용 계측**.
+ *
+ * 순정 process_combo() 는 키 이벤트마다 콤보 표 **전체**를 돈다 — 콤보마다 키 목록을 끝까지 훑고,
+ * 콤보와 상관없는 키가 와도 clear_combos() 가 다시 전체를 돈다. 콤보 수에 비례하는 비용이 매 키에 붙는다.
+ *
+ * process_combo_wrapper.c 가 원본을 감싸 컴파일하고 process_combo() 만 바꾼다:
+ *  - 키코드 -> 그 키를 가진 콤보 목록(정렬된 (키코드, 콤보) 쌍, 이진 탐색)을 표가 바뀔 때 한 번 만든다.
+ *    이벤트마다 **그 키를 가진 콤보만** 순정 process_single_combo() 에 넘긴다 — 콤보 순서도 그대로라
+ *    판정은 순정과 같다(키를 안 가진 콤보는 순정에서도 첫 줄에서 빠진다).
+ *  - 상태를 건드린 콤보를 비트마스크로 기억해 두고, 리셋은 그 콤보만 한다(순정 clear_combos 는 전체).
+ *  - 콤보 수가 COMBO_PORT_MAX 를 넘거나 쌍이 COMBO_PORT_INDEX_MAX 를 넘으면 순정 경로로 돈다.
+ *
+ * 콤보 판정(COMBO_TERM)도 탭/홀드처럼 **틱이 와야** 끝난다 — combo_port_wait_ms() 를 port/deadline 에
+ * 등록해 그 시각에 루프를 깨운다.
+ */
+
+#ifndef COMBO_PORT_MAX
+#define COMBO_PORT_MAX          256                     // 인덱스가 다루는 콤보 수
+#endif
+#ifndef COMBO_PORT_INDEX_MAX
+#define COMBO_PORT_INDEX_MAX    (COMBO_PORT_MAX * 3)    // (키코드, 콤보) 쌍 — 콤보당 평균 3키
+#endif
+
+struct combo_t;
+
+void     combo_port_init(void);
+
+// 콤보 표를 바꾼다(NULL = 키맵의 key_combos). 인덱스를 다시 만들고 진행 중이던 판정은 버린다.
+void     combo_port_set_table(struct combo_t *p_tbl, uint16_t count);
+void     combo_port_rebuild(void);
+
+// 콤보 판정이 걸려 있으면 판정 시각까지 남은 ms(최소 1). 0 = 기다릴 판정 없음.
+uint32_t combo_port_wait_ms(void);
+
+// true = 순정 전수 검사로 돈다(인덱스와 비용 비교용 — CLI `combo scan`, native_sim `--combo-bench`).
+void     combo_port_set_scan(bool enable);
+bool     combo_port_is_indexed(void);
@@ -0,0 +1,410 @@
+/*
+ * 순정 process_combo.c 를 **감싸서** 컴파일한다 — port/tapping/action_tapping_wrapper.c 와 같은 방식이다.
+ *
+ * 원본을 include 하므로 그 안의 static(process_single_combo, timer, longest_term, 버퍼)을 여기서 쓴다.
+ * 바꾸는 건 process_combo() 하나다 — 콤보 표 전체 대신 후보 인덱스가 준 콤보만 돈다(combo_port.h).
+ * 콤보 하나의 판정(process_single_combo), 버퍼/적용(apply_combos), 타임아웃(combo_task)은 원본 그대로다.
+ *
+ * qmk/CMakeLists.txt 는 원본 대신 이 파일을 목록에 넣는다. port/combo/ 하위에 둔 이유는 debounce/tapping 과
+ * 같다(port/*.c glob 이 재귀가 아니다).
+ */
+#include "combo_port.h"
+#include "quantum.h"   // process_combo.h 의 원래 이름 선언을 먼저 — 아래 rename 은 원본 정의에만 걸린다
+
+#define process_combo  process_combo_vendor
+#include "../../quantum/process_keycode/process_combo.c"
+#undef process_combo
+
+#include "cli.h"
+#include "micros.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if CLI_USE(HW_COMBO)
+static void cliCombo(cli_args_t *args);
+#endif
+
+typedef struct
+{
+  uint16_t keycode;
+  uint16_t combo_index;
+} combo_key_t;
+
+static combo_t    *table         = NULL;   // NULL = 키맵의 key_combos(combo_get_raw)
+static uint16_t    table_cnt     = 0;
+static combo_key_t index_tbl[COMBO_PORT_INDEX_MAX];   // (키코드, 콤보) 오름차순
+static uint16_t    index_cnt     = 0;
+static uint16_t    index_src_cnt = 0;      // 인덱스를 만들 때의 combo_count()
+static bool        index_ok      = false;
+static bool        scan_on       = false;
+static uint32_t    touched[(COMBO_PORT_MAX + 31) / 32];   // 상태를 건드렸을 수 있는 콤보
+
+static uint32_t stat_events   = 0;   // 틱이 아닌 이벤트(눌림/뗌)
+static uint32_t stat_cand     = 0;   // 이벤트마다 넘긴 후보 콤보 수의 합
+static uint32_t stat_cand_max = 0;
+static uint32_t stat_total_us = 0;
+static uint32_t stat_max_us   = 0;
+
+
+/*
+ * 콤보 표 — keymap_introspection.c 의 weak 정의를 덮는다. 키맵의 key_combos 가 기본이고,
+ * combo_port_set_table() 로 다른 표(VIA 로 편집한 표, 벤치용 합성 표)로 바꾼다.
+ */
+uint16_t combo_count(void)
+{
+  return (table != NULL) ? table_cnt : combo_count_raw();
+}
+
+combo_t *combo_get(uint16_t combo_idx)
+{
+  return (table != NULL) ? &table[combo_idx] : combo_get_raw(combo_idx);
+}
+
+static int combo_key_cmp(const void *a, const void *b)
+{
+  const combo_key_t *ka = (const combo_key_t *)a;
+  const combo_key_t *kb = (const combo_key_t *)b;
+
+  if (ka->keycode != kb->keycode)
+  {
+    return (ka->keycode > kb->keycode) ? 1 : -1;
+  }
+  return (ka->combo_index > kb->combo_index) - (ka->combo_index < kb->combo_index);
+}
+
+// 다음 리셋이 이 콤보들을 전부 훑게 한다 — 인덱스 밖에서 상태가 바뀌었을 수 있을 때.
+static void combo_port_touch_all(uint16_t count)
+{
+  memset(touched, 0, sizeof(touched));
+  for (uint16_t i = 0; i < count && i < COMBO_PORT_MAX; i++)
+  {
+    touched[i / 32] |= (1UL << (i % 32));
+  }
+}
+
+void combo_port_rebuild(void)
+{
+  uint16_t count = combo_count();
+
+  index_cnt = 0;
+  index_ok  = (count <= COMBO_PORT_MAX);
+
+  for (uint16_t idx = 0; idx < count && index_ok; idx++)
+  {
+    const uint16_t *keys = combo_get(idx)->keys;
+
+    for (uint8_t k = 0;; k++)
+    {
+      uint16_t key = pgm_read_word(&keys[k]);
+
+      if (key == COMBO_END)
+      {
+        break;
+      }
+      if (index_cnt >= COMBO_PORT_INDEX_MAX)
+      {
+        index_ok = false;
+        break;
+      }
+      index_tbl[index_cnt].keycode     = key;
+      index_tbl[index_cnt].combo_index = idx;
+      index_cnt++;
+    }
+  }
+
+  if (index_ok)
+  {
+    qsort(index_tbl, index_cnt, sizeof(combo_key_t), combo_key_cmp);
+
+    // 한 콤보에 같은 키가 두 번 있으면 후보로 두 번 넘기게 된다 — 순정은 콤보당 한 번만 본다.
+    uint16_t out = 0;
+
+    for (uint16_t i = 0; i < index_cnt; i++)
+    {
+      if (out == 0 || combo_key_cmp(&index_tbl[out - 1], &index_tbl[i]) != 0)
+      {
+        index_tbl[out++] = index_tbl[i];
+      }
+    }
+    index_cnt = out;
+  }
+  else
+  {
+    index_cnt = 0;
+  }
+  index_src_cnt = count;
+  combo_port_touch_all(count);
+}
+
+void combo_port_set_table(combo_t *p_tbl, uint16_t count)
+{
+  // 진행 중이던 판정은 옛 표의 인덱스를 들고 있다 — 버린다. 버퍼의 키는 일반 키로 내보낸다(유실 방지).
+#ifndef COMBO_NO_TIMER
+  timer = 0;
+#endif
+  combo_buffer_read = combo_buffer_write;
+  dump_key_buffer();
+  longest_term = 0;
+
+  table     = p_tbl;
+  table_cnt = (p_tbl != NULL) ? count : 0;
+  combo_port_rebuild();
+}
+
+void combo_port_set_scan(bool enable)
+{
+  scan_on = enable;
+  combo_port_touch_all(combo_count());   // 순정 경로가 바꾼 상태를 다음 리셋이 훑도록
+}
+
+bool combo_port_is_indexed(void)
+{
+  return index_ok && !scan_on;
+}
+
+// 순정 clear_combos() 와 같다 — 건드린 콤보만 본다. 활성 콤보는 뗄 때까지 상태를 들고 있으므로 남겨 둔다.
+static void combo_port_clear(void)
+{
+  longest_term = 0;
+
+  for (uint16_t w = 0; w < ARRAY_SIZE(touched); w++)
+  {
+    uint32_t bits = touched[w];
+
+    while (bits != 0)
+    {
+      uint16_t idx   = (uint16_t)(w * 32 + __builtin_ctz(bits));
+      combo_t *combo = combo_get(idx);
+
+      bits &= bits - 1;
+      if (!COMBO_ACTIVE(combo))
+      {
+        RESET_COMBO_STATE(combo);
+        touched[w] &= ~(1UL << (idx % 32));
+      }
+    }
+  }
+}
+
+static uint16_t combo_port_find(uint16_t keycode)
+{
+  uint16_t lo = 0;
+  uint16_t hi = index_cnt;
+
+  while (lo < hi)
+  {
+    uint16_t mid = (uint16_t)((lo + hi) / 2);
+
+    if (index_tbl[mid].keycode < keycode)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/*
+ * 순정 process_combo() 와 줄 단위로 같다 — 다른 곳은 두 군데뿐이다:
+ *  1) 콤보 루프가 인덱스의 후보만 돈다(콤보 번호 오름차순 — 순정과 같은 순서).
+ *  2) 리셋이 combo_port_clear() 다(건드린 콤보만).
+ * 순정의 no_combo_keys_pressed 는 계산만 하고 쓰지 않아 뺐다.
+ */
+static bool combo_port_process(uint16_t keycode, keyrecord_t *record, uint16_t *p_cand)
+{
+  bool is_combo_key = false;
+
+  if (keycode == QK_COMBO_ON && record->event.pressed)
+  {
+    combo_enable();
+    return true;
+  }
+  if (keycode == QK_COMBO_OFF && record->event.pressed)
+  {
+    combo_disable();
+    return true;
+  }
+  if (keycode == QK_COMBO_TOGGLE && record->event.pressed)
+  {
+    combo_toggle();
+    return true;
+  }
+
+#ifdef COMBO_ONLY_FROM_LAYER
+  keycode = keymap_key_to_keycode(COMBO_ONLY_FROM_LAYER, record->event.key);
+#else
+  uint8_t highest_layer = get_highest_layer(layer_state | default_layer_state);
+  uint8_t ref_layer     = combo_ref_from_layer(highest_layer);
+  if (ref_layer != highest_layer)
+  {
+    keycode = keymap_key_to_keycode(ref_layer, record->event.key);
+  }
+#endif
+
+  for (uint16_t i = combo_port_find(keycode); i < index_cnt && index_tbl[i].keycode == keycode; i++)
+  {
+    uint16_t idx = index_tbl[i].combo_index;
+
+    touched[idx / 32] |= (1UL << (idx % 32));
+    is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+    (*p_cand)++;
+  }
+
+  if (record->event.pressed && is_combo_key)
+  {
+#ifndef COMBO_NO_TIMER
+#ifdef COMBO_STRICT_TIMER
+    if (!timer)
+    {
+      timer = timer_read();
+    }
+#else
+    timer = timer_read();
+#endif
+#endif
+    if (key_buffer_size < COMBO_KEY_BUFFER_LENGTH)
+    {
+      key_buffer[key_buffer_size++] = (queued_record_t){
+        .record      = *record,
+        .keycode     = keycode,
+        .combo_index = -1,
+      };
+    }
+  }
+  else
+  {
+    if (combo_buffer_read != combo_buffer_write)
+    {
+      apply_combos();   // 순정 — 안에서 clear_combos()(전체)를 부르지만 콤보가 발동할 때뿐이다
+    }
+    else
+    {
+      dump_key_buffer();
+#ifndef COMBO_NO_TIMER
+      timer = 0;
+#endif
+      combo_port_clear();
+    }
+  }
+  return !is_combo_key;
+}
+
+bool process_combo(uint16_t keycode, keyrecord_t *record)
+{
+  uint16_t cand  = 0;
+  uint32_t start = micros();
+  bool     ret;
+
+  // 표가 인덱스 없이 바뀌었으면(set_table 을 안 거친 경우) 여기서라도 맞춘다.
+  if (combo_count() != index_src_cnt)
+  {
+    combo_port_rebuild();
+  }
+
+  if (index_ok && !scan_on)
+  {
+    ret = combo_port_process(keycode, record, &cand);
+  }
+  else
+  {
+    ret  = process_combo_vendor(keycode, record);
+    cand = combo_count();
+  }
+
+  uint32_t elapsed = micros() - start;
+
+  if (IS_EVENT(record->event))
+  {
+    stat_events++;
+    stat_cand     += cand;
+    stat_total_us += elapsed;
+    if (cand > stat_cand_max)
+    {
+      stat_cand_max = cand;
+    }
+    if (elapsed > stat_max_us)
+    {
+      stat_max_us = elapsed;
+    }
+  }
+  return ret;
+}
+
+/*
+ * 순정 combo_task() 는 timer 가 서 있고 longest_term 을 **넘으면**(>) 버퍼를 적용/배출한다.
+ * 콤보 키를 누른 채 판정을 기다리는 동안은 매트릭스가 안 쉬어 루프가 돌지만, 키를 떼고 남은 timer
+ * (longest_term 0)는 틱 하나가 치워야 한다 — 안 깨면 다음 키까지 남고 16비트 시각이 감긴다.
+ */
+uint32_t combo_port_wait_ms(void)
+{
+#ifndef COMBO_NO_TIMER
+  if (!b_combo_enable || timer == 0)
+  {
+    return 0;
+  }
+
+  uint16_t elapsed = timer_elapsed(timer);
+
+  return (elapsed > longest_term) ? 1 : (uint32_t)(longest_term - elapsed) + 1;
+#else
+  return 0;
+#endif
+}
+
+void combo_port_init(void)
+{
+  combo_port_rebuild();
+
+#if CLI_USE(HW_COMBO)
+  cliAdd("combo", cliCombo);
+#endif
+}
+
+
+#if CLI_USE(HW_COMBO)
+void cliCombo(cli_args_t *args)
+{
+  bool ret = false;
+
+  if (args->argc == 1 && args->isStr(0, "info"))
+  {
+    cliPrintf("enabled     : %s\n", is_combo_enabled() ? "on" : "off");
+    cliPrintf("table       : %s, %d combos\n", table != NULL ? "custom" : "keymap", combo_count());
+    cliPrintf("index       : %d / %d pairs, %s\n", index_cnt, COMBO_PORT_INDEX_MAX,
+              scan_on ? "scan (forced)" : (index_ok ? "indexed" : "scan (too many)"));
+    cliPrintf("deadline    : %d ms\n", combo_port_wait_ms());
+    cliPrintf("events      : %d, candidates avg %d.%02d, max %d\n", stat_events,
+              stat_events ? stat_cand / stat_events : 0, stat_events ? (stat_cand * 100 / stat_events) % 100 : 0,
+              stat_cand_max);
+    cliPrintf("cost        : avg %d us, max %d us\n", stat_events ? stat_total_us / stat_events : 0, stat_max_us);
+    ret = true;
+  }
+
+  if (args->argc == 2 && args->isStr(0, "scan"))
+  {
+    combo_port_set_scan(args->isStr(1, "on"));
+    cliPrintf("scan %s\n", scan_on ? "on" : "off");
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "clear"))
+  {
+    stat_events   = 0;
+    stat_cand     = 0;
+    stat_cand_max = 0;
+    stat_total_us = 0;
+    stat_max_us   = 0;
+    ret = true;
+  }
+
+  if (ret == false)
+  {
+    cliPrintf("combo info\n");
+    cliPrintf("combo scan [on | off]\n");
+    cliPrintf("combo clear\n");
+  }
+}
+#endif
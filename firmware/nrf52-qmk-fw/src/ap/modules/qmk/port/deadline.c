@@ -0,0 +1,94 @@
+#include "deadline.h"
+#include "hw_def.h"
+#include "cli.h"
+
+#if CLI_USE(HW_DEADLINE)
+static void cliDeadline(cli_args_t *args);
+#endif
+
+typedef struct
+{
+  deadline_wait_func_t wait_func;
+} deadline_t;
+
+static bool       is_init = false;
+static deadline_t deadline_tbl[WAKE_REASON_MAX];
+
+
+static void deadline_init(void)
+{
+  is_init = true;
+
+#if CLI_USE(HW_DEADLINE)
+  cliAdd("deadline", cliDeadline);
+#endif
+}
+
+void deadline_register(wake_reason_t reason, deadline_wait_func_t func)
+{
+  if (!is_init)
+  {
+    deadline_init();
+  }
+  if (reason < WAKE_REASON_MAX)
+  {
+    deadline_tbl[reason].wait_func = func;
+  }
+}
+
+uint32_t deadline_next_ms(wake_reason_t *p_reason)
+{
+  uint32_t      wait_ms = 0;
+  wake_reason_t reason  = WAKE_REASON_OTHER;
+
+  // 동률이면 enum 앞쪽 이유로 센다(어차피 같은 회차에 둘 다 처리된다).
+  for (uint8_t i = 0; i < WAKE_REASON_MAX; i++)
+  {
+    if (deadline_tbl[i].wait_func == NULL)
+    {
+      continue;
+    }
+
+    uint32_t ms = deadline_tbl[i].wait_func();
+
+    if (ms != 0 && (wait_ms == 0 || ms < wait_ms))
+    {
+      wait_ms = ms;
+      reason  = (wake_reason_t)i;
+    }
+  }
+
+  if (p_reason != NULL)
+  {
+    *p_reason = reason;
+  }
+  return wait_ms;
+}
+
+
+#if CLI_USE(HW_DEADLINE)
+void cliDeadline(cli_args_t *args)
+{
+  bool ret = false;
+
+  if (args->argc == 1 && args->isStr(0, "info"))
+  {
+    for (uint8_t i = 0; i < WAKE_REASON_MAX; i++)
+    {
+      deadline_t *p_dl = &deadline_tbl[i];
+
+      if (p_dl->wait_func == NULL)
+      {
+        continue;
+      }
+      cliPrintf("%-10s : %8d ms\n", wakeStatGetName((wake_reason_t)i), p_dl->wait_func());
+    }
+    ret = true;
+  }
+
+  if (ret == false)
+  {
+    cliPrintf("deadline info\n");
+  }
+}
+#endif
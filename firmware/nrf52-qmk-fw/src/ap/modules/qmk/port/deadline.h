@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "wake_stat.h"
+
+/*
+ * idle 데드라인 레지스트리 — "T 에 깨워 달라" 를 한 곳에 모은다.
+ *
+ * 메인 루프는 키가 하나도 안 눌리면 qmkWaitActivity(qmkGetIdleWaitMs()) 로 잔다(§2.6). 잠든 동안
+ * QMK 의 시간 기반 기능은 멈춘다 — 그래서 그런 기능은 다음 시각을 여기 알리고, qmkGetIdleWaitMs() 는
+ * 그중 가장 이른 것까지만 잔다. 시각 사이에는 여전히 CPU 가 잔다(2ms 폴링으로 돌아가지 않는다).
+ *
+ * 출처는 deadline_register() 로 "지금 기준 남은 ms" 를 계산해 주는 함수를 건다(activity, EEPROM flush,
+ * RGB 프레임, 탭/홀드, 콤보, 탭댄스). 상태가 바뀌어도 따로 알릴 필요가 없다. 키는 wake_reason_t 다 —
+ * 이유마다 데드라인 하나, 깨어남 회계에도 그 이름으로 남는다. 순정 코드의 static 타이머는 래퍼가
+ * 원본을 include 해 직접 읽는다(port/tapping, port/combo, port/tap_dance).
+ *
+ * 메인 스레드(qmkUpdate 안) 전용이다 — ISR/다른 스레드는 qmkWake() 로 깨운다.
+ */
+
+typedef uint32_t (*deadline_wait_func_t)(void);   // 남은 ms, 0 = 기다릴 것 없음
+
+void     deadline_register(wake_reason_t reason, deadline_wait_func_t func);
+
+// 가장 이른 데드라인까지 남은 ms(최소 1). 0 = 없음(무한 대기). p_reason 에 그 이유.
+uint32_t deadline_next_ms(wake_reason_t *p_reason);
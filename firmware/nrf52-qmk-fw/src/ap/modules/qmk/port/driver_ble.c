@@ -2,6 +2,7 @@
 #include "host_driver.h"
 #include "report.h"
 #include "ble.h"
+#include "boot_prof.h"
 
 /*
  * BLE 출력용 host_driver_t.
@@ -16,7 +17,15 @@ static uint8_t ble_keyboard_leds(void)
 
 static void ble_send_keyboard(report_keyboard_t *report)
 {
-  bleSendKeyboard(report);
+  if (!bleSendKeyboard(report))
+  {
+    host_report_invalidate();   // driver_usb.c 와 같다 — 다음 리포트는 중복이어도 나간다
+    return;
+  }
+  if (report->mods || report->keys[0])
+  {
+    bootProfMark(BOOT_PROF_FIRST_KEY);   // driver_usb.c 와 같은 판정
+  }
 }
 
 static void ble_send_nkro(report_nkro_t *report)
@@ -27,8 +36,10 @@ static void ble_send_nkro(report_nkro_t *report)
 
 static void ble_send_mouse(report_mouse_t *report)
 {
-  // TODO: 마우스 리포트(ID 2)를 report map 에 추가 후 연결.
-  (void)report;
+  if (!bleSendMouse(report))
+  {
+    host_report_invalidate();
+  }
 }
 
 static void ble_send_extra(report_extra_t *report)
@@ -2,6 +2,7 @@
 #include "host_driver.h"
 #include "report.h"
 #include "usb_hid/usb_hid.h"
+#include "boot_prof.h"
 
 /*
  * USB 출력용 host_driver_t.
@@ -17,7 +18,16 @@ static uint8_t usb_keyboard_leds(void)
 
 static void usb_send_keyboard(report_keyboard_t *report)
 {
-  usbHidSendReport((uint8_t *)report, KEYBOARD_REPORT_SIZE);
+  if (!usbHidSendReport((uint8_t *)report, KEYBOARD_REPORT_SIZE))
+  {
+    host_report_invalidate();   // 못 보낸 리포트를 보낸 것으로 기억하지 않게(host.c 중복 억제)
+    return;
+  }
+  // 빈 리포트(전환 시 stuck key 해제)는 첫 키가 아니다.
+  if (report->mods || report->keys[0])
+  {
+    bootProfMark(BOOT_PROF_FIRST_KEY);
+  }
 }
 
 static void usb_send_nkro(report_nkro_t *report)
@@ -28,8 +38,10 @@ static void usb_send_nkro(report_nkro_t *report)
 
 static void usb_send_mouse(report_mouse_t *report)
 {
-  // Phase 1: 마우스 리포트 미연결.
-  (void)report;
+  if (!usbHidSendReportMouse((uint8_t *)report, sizeof(report_mouse_t)))
+  {
+    host_report_invalidate();
+  }
 }
 
 static void usb_send_extra(report_extra_t *report)
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "process_key_override.h"   // key_override_t 는 이름 없는 struct 의 typedef 라 전방 선언이 안 된다
+
+/*
+ * 키 오버라이드(quantum/process_keycode/process_key_override.c)의 **트리거 인덱스**.
+ *
+ * 순정은 키 이벤트마다 key_overrides[] 를 NULL 까지 전부 돈다(모디파이어/레이어/트리거 검사).
+ * 그런데 한 이벤트에서 켜질 수 있는 오버라이드는 트리거가 셋 중 하나인 것뿐이다 —
+ * 지금 키코드, 직전에 누른 키(last_key_down, 모디파이어 이벤트에서 켜질 때), KC_NO(모디파이어만).
+ * process_key_override_wrapper.c 가 원본을 감싸 컴파일하고, 이벤트마다 그 세 트리거의 오버라이드만
+ * **원래 순서대로** 모은 목록을 순정 판정에 넘긴다 — 먼저 맞는 것이 이기는 규칙도 그대로다.
+ *
+ * 목록은 키맵의 key_overrides(정적, 앞) + key_override_port_set_table() 의 표(VIA 동적 표, 뒤)다.
+ */
+
+#ifndef KEY_OVERRIDE_PORT_MAX
+#define KEY_OVERRIDE_PORT_MAX   32      // 정적 + 동적 합계. 순서를 비트마스크(uint32_t)로 든다
+#endif
+
+void key_override_port_init(void);
+
+// 동적 표를 바꾼다(NULL/0 = 없음). 인덱스를 다시 만들고 켜져 있던 오버라이드는 끈다.
+void key_override_port_set_table(const key_override_t *p_tbl, uint8_t count);
@@ -0,0 +1,139 @@
+/*
+ * 순정 process_key_override.c 를 **감싸서** 컴파일한다 — port/combo/process_combo_wrapper.c 와 같은 방식이다.
+ *
+ * 원본은 key_overrides(NULL 종료 포인터 배열)를 처음부터 끝까지 돈다. 원본 안의 그 이름을
+ * 이벤트마다 채우는 후보 목록(key_overrides_cand)으로 바꿔 컴파일한다 — 판정 코드는 한 줄도 안 바뀌고
+ * 도는 목록만 짧아진다(key_override_port.h). 키맵이 정의하는 key_overrides 는 아래에서 다시 weak 로 둔다.
+ *
+ * qmk/CMakeLists.txt 는 원본 대신 이 파일을 목록에 넣는다. port/key_override/ 하위에 둔 이유는 combo 와
+ * 같다(port/*.c glob 이 재귀가 아니다).
+ */
+#include "quantum.h"   // process_key_override.h 의 원래 이름 선언을 먼저 — 아래 rename 은 원본 정의에만 걸린다
+#include "key_override_port.h"
+
+#define process_key_override  process_key_override_vendor
+#define key_overrides         key_overrides_cand
+#include "../../quantum/process_keycode/process_key_override.c"
+#undef process_key_override
+#undef key_overrides
+
+#include "log.h"
+
+_Static_assert(KEY_OVERRIDE_PORT_MAX <= 32, "order mask is uint32_t");
+
+typedef struct
+{
+  uint16_t trigger;
+  uint8_t  order;     // list_tbl[] 의 번호 = 순정 목록에서의 순서
+} ko_key_t;
+
+// 키맵의 정적 오버라이드(NULL 종료). 순정과 같은 이름/같은 weak 규칙이다.
+__attribute__((weak)) const key_override_t **key_overrides = NULL;
+
+static const key_override_t *dyn_tbl = NULL;
+static uint8_t               dyn_cnt = 0;
+
+static const key_override_t *list_tbl[KEY_OVERRIDE_PORT_MAX];        // 정적 -> 동적 순
+static ko_key_t              index_tbl[KEY_OVERRIDE_PORT_MAX];       // (트리거, 순서) 오름차순
+static uint8_t               list_cnt = 0;
+static const key_override_t *cand_tbl[KEY_OVERRIDE_PORT_MAX + 1];    // 이벤트마다 채운다(NULL 종료)
+
+
+static void key_override_port_rebuild(void)
+{
+  list_cnt = 0;
+
+  for (uint8_t i = 0; key_overrides != NULL && key_overrides[i] != NULL; i++)
+  {
+    if (list_cnt >= KEY_OVERRIDE_PORT_MAX)
+    {
+      break;
+    }
+    list_tbl[list_cnt++] = key_overrides[i];
+  }
+  for (uint8_t i = 0; i < dyn_cnt; i++)
+  {
+    if (list_cnt >= KEY_OVERRIDE_PORT_MAX)
+    {
+      logPrintf("[E_] key override: over %d, rest ignored\n", KEY_OVERRIDE_PORT_MAX);
+      break;
+    }
+    list_tbl[list_cnt++] = &dyn_tbl[i];
+  }
+
+  // 삽입 정렬 — 최대 32개, 표가 바뀔 때만 돈다.
+  for (uint8_t i = 0; i < list_cnt; i++)
+  {
+    ko_key_t key = {list_tbl[i]->trigger, i};
+    uint8_t  j   = i;
+
+    while (j > 0 && index_tbl[j - 1].trigger > key.trigger)
+    {
+      index_tbl[j] = index_tbl[j - 1];
+      j--;
+    }
+    index_tbl[j] = key;
+  }
+}
+
+// trigger 를 가진 오버라이드들의 순서 비트. 같은 트리거끼리는 순서 오름차순으로 붙어 있다.
+static uint32_t key_override_port_find(uint16_t trigger)
+{
+  uint8_t  lo   = 0;
+  uint8_t  hi   = list_cnt;
+  uint32_t mask = 0;
+
+  while (lo < hi)
+  {
+    uint8_t mid = (lo + hi) / 2;
+
+    if (index_tbl[mid].trigger < trigger)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+  for (; lo < list_cnt && index_tbl[lo].trigger == trigger; lo++)
+  {
+    mask |= 1UL << index_tbl[lo].order;
+  }
+  return mask;
+}
+
+bool process_key_override(const uint16_t keycode, const keyrecord_t *const record)
+{
+  // 순정이 이번 이벤트에서 켤 수 있는 건 트리거가 keycode / last_key_down / KC_NO 인 것뿐이다
+  // (try_activating_override 의 should_activate). 눌림이면 순정이 last_key_down 을 keycode 로 먼저
+  // 바꾸지만 keycode 는 이미 넣었으므로 이전 값을 더 넣어도 후보가 늘 뿐 판정은 같다.
+  uint32_t mask = key_override_port_find(keycode) | key_override_port_find(KC_NO) |
+                  key_override_port_find(last_key_down);
+  uint8_t  cnt  = 0;
+
+  while (mask != 0)
+  {
+    cand_tbl[cnt++] = list_tbl[__builtin_ctz(mask)];   // 낮은 순서부터 = 순정 목록 순서
+    mask &= mask - 1;
+  }
+  cand_tbl[cnt] = NULL;
+
+  key_overrides_cand = (cnt > 0) ? cand_tbl : NULL;
+  return process_key_override_vendor(keycode, record);
+}
+
+void key_override_port_set_table(const key_override_t *p_tbl, uint8_t count)
+{
+  // 켜져 있던 오버라이드가 바뀔 표 안을 가리킬 수 있다 — 먼저 끈다(대체 키도 뗀다).
+  clear_active_override(false);
+
+  dyn_tbl = p_tbl;
+  dyn_cnt = (p_tbl != NULL) ? count : 0;
+  key_override_port_rebuild();
+}
+
+void key_override_port_init(void)
+{
+  key_override_port_rebuild();
+}
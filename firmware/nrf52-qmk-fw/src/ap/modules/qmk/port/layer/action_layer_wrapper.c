@@ -0,0 +1,254 @@
+/*
+ * 순정 action_layer.c 를 **감싸서** 컴파일한다 — port/combo/process_combo_wrapper.c 와 같은 방식이다.
+ *
+ * 바꾸는 건 layer_switch_get_layer() 하나다 — 레이어를 훑는 대신 키별 캐시를 읽는다(layer_cache.h).
+ * 같은 파일 안의 호출자(store_or_get_action, layer_switch_get_action)도 rename 에 걸려 순정 쪽을
+ * 부르게 되므로, 둘은 원본 본문 그대로 여기서 다시 정의한다.
+ * 레이어 상태(layer_on/off, default layer)와 그 콜백(layer_state_set_kb)은 원본 그대로다 — 캐시는
+ * 조회할 때 layer_state | default_layer_state 를 지난번 값과 비교해 바뀐 만큼만 따라간다.
+ *
+ * qmk/CMakeLists.txt 는 원본 대신 이 파일을 목록에 넣는다. port/layer/ 하위에 둔 이유는 combo 와
+ * 같다(port/*.c glob 이 재귀가 아니다).
+ */
+#include "layer_cache.h"
+#include "quantum.h"   // action_layer.h 의 원래 이름 선언을 먼저 — 아래 rename 은 원본 정의에만 걸린다
+
+// 원본은 정의보다 먼저 부른다(store_or_get_action) — 바뀐 이름의 선언을 앞에 둔다.
+uint8_t  layer_switch_get_layer_vendor(keypos_t key);
+action_t layer_switch_get_action_vendor(keypos_t key);
+
+#define layer_switch_get_layer   layer_switch_get_layer_vendor
+#define layer_switch_get_action  layer_switch_get_action_vendor
+#define store_or_get_action      store_or_get_action_vendor
+#include "../../quantum/action_layer.c"
+#undef layer_switch_get_layer
+#undef layer_switch_get_action
+#undef store_or_get_action
+
+#include "cli.h"
+
+#if CLI_USE(HW_LAYER)
+static void cliLayer(cli_args_t *args);
+#endif
+
+static bool          cache_on     = true;
+static bool          mask_ok      = false;
+static layer_state_t cache_layers = 0;                            // top_tbl 이 맞는 레이어 상태
+static layer_state_t key_mask[MATRIX_ROWS][MATRIX_COLS];          // 키마다 투명이 아닌 레이어
+static matrix_row_t  layer_rows[MAX_LAYER][MATRIX_ROWS];          // 레이어마다 투명이 아닌 키
+static uint8_t       top_tbl[MATRIX_ROWS][MATRIX_COLS];           // 키마다 지금의 유효 레이어
+
+static uint32_t stat_lookups  = 0;
+static uint32_t stat_updates  = 0;   // 레이어 상태가 바뀌어 따라간 횟수
+static uint32_t stat_keys     = 0;   // 그때 다시 계산한 키 수의 합
+static uint32_t stat_rebuilds = 0;   // 키맵이 바뀌어 마스크를 다시 만든 횟수
+
+
+// 순정과 같은 규칙 — 켜진 레이어 중 이 키가 투명이 아닌 가장 높은 것, 없으면 0.
+static inline uint8_t layer_cache_top(uint8_t row, uint8_t col, layer_state_t layers)
+{
+  layer_state_t hit = layers & key_mask[row][col];
+
+  return (hit != 0) ? get_highest_layer(hit) : 0;
+}
+
+static void layer_cache_rebuild(layer_state_t layers)
+{
+  memset(layer_rows, 0, sizeof(layer_rows));
+
+  for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+  {
+    for (uint8_t col = 0; col < MATRIX_COLS; col++)
+    {
+      keypos_t key = MAKE_KEYPOS(row, col);
+
+      key_mask[row][col] = 0;
+      for (uint8_t layer = 0; layer < MAX_LAYER; layer++)
+      {
+        if (action_for_key(layer, key).code != ACTION_TRANSPARENT)
+        {
+          key_mask[row][col] |= (layer_state_t)1 << layer;
+          layer_rows[layer][row] |= (matrix_row_t)1 << col;
+        }
+      }
+      top_tbl[row][col] = layer_cache_top(row, col, layers);
+    }
+  }
+
+  cache_layers = layers;
+  mask_ok      = true;
+  stat_rebuilds++;
+}
+
+static void layer_cache_update(layer_state_t layers)
+{
+  layer_state_t changed = layers ^ cache_layers;
+  matrix_row_t  affected[MATRIX_ROWS] = {0};
+
+  // 바뀐 레이어에서 투명인 키는 답이 그대로다 — 투명이 아닌 키만 모은다.
+  for (uint8_t layer = 0; layer < MAX_LAYER; layer++)
+  {
+    if (changed & ((layer_state_t)1 << layer))
+    {
+      for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+      {
+        affected[row] |= layer_rows[layer][row];
+      }
+    }
+  }
+
+  for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+  {
+    matrix_row_t bits = affected[row];
+
+    while (bits != 0)
+    {
+      uint8_t col = __builtin_ctz(bits);
+
+      top_tbl[row][col] = layer_cache_top(row, col, layers);
+      bits &= bits - 1;
+      stat_keys++;
+    }
+  }
+
+  cache_layers = layers;
+  stat_updates++;
+}
+
+uint8_t layer_switch_get_layer(keypos_t key)
+{
+  // 매트릭스 밖 위치(콤보 KEYLOC_COMBO 등)는 순정으로 — 표가 없다.
+  if (!cache_on || key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS)
+  {
+    return layer_switch_get_layer_vendor(key);
+  }
+
+  layer_state_t layers = layer_state | default_layer_state;
+
+  if (!mask_ok)
+  {
+    layer_cache_rebuild(layers);
+  }
+  else if (layers != cache_layers)
+  {
+    layer_cache_update(layers);
+  }
+  stat_lookups++;
+
+  return top_tbl[key.row][key.col];
+}
+
+// 원본과 같은 본문 — layer_switch_get_layer() 만 캐시 쪽을 부른다.
+action_t layer_switch_get_action(keypos_t key)
+{
+  return action_for_key(layer_switch_get_layer(key), key);
+}
+
+action_t store_or_get_action(bool pressed, keypos_t key)
+{
+#if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
+  if (disable_action_cache)
+  {
+    return layer_switch_get_action(key);
+  }
+
+  uint8_t layer;
+
+  if (pressed)
+  {
+    layer = layer_switch_get_layer(key);
+    update_source_layers_cache(key, layer);
+  }
+  else
+  {
+    layer = read_source_layers_cache(key);
+  }
+  return action_for_key(layer, key);
+#else
+  return layer_switch_get_action(key);
+#endif
+}
+
+void layer_cache_invalidate(void)
+{
+  mask_ok = false;
+}
+
+void layer_cache_set_enable(bool enable)
+{
+  cache_on = enable;
+  mask_ok  = false;   // 꺼진 사이 키맵이 바뀌었을 수 있다
+}
+
+bool layer_cache_is_enabled(void)
+{
+  return cache_on;
+}
+
+void layer_cache_init(void)
+{
+#if CLI_USE(HW_LAYER)
+  cliAdd("layer", cliLayer);
+#endif
+}
+
+
+#if CLI_USE(HW_LAYER)
+void cliLayer(cli_args_t *args)
+{
+  bool ret = false;
+
+  if (args->argc == 1 && args->isStr(0, "info"))
+  {
+    cliPrintf("cache       : %s (%s)\n", cache_on ? "on" : "off", mask_ok ? "built" : "dirty");
+    cliPrintf("layers      : state 0x%X, default 0x%X, cached 0x%X\n", (uint32_t)layer_state,
+              (uint32_t)default_layer_state, (uint32_t)cache_layers);
+    cliPrintf("lookups     : %d\n", stat_lookups);
+    cliPrintf("updates     : %d, keys avg %d / %d, rebuilds %d\n", stat_updates,
+              stat_updates ? stat_keys / stat_updates : 0, MATRIX_ROWS * MATRIX_COLS, stat_rebuilds);
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "map"))
+  {
+    // 키별 유효 레이어 — 캐시가 순정과 같은지 눈으로 맞춰 본다(다르면 '!').
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+    {
+      for (uint8_t col = 0; col < MATRIX_COLS; col++)
+      {
+        keypos_t key    = MAKE_KEYPOS(row, col);
+        uint8_t  layer  = layer_switch_get_layer(key);
+        uint8_t  vendor = layer_switch_get_layer_vendor(key);
+
+        cliPrintf(" %d%c", layer, layer == vendor ? ' ' : '!');
+      }
+      cliPrintf("\n");
+    }
+    ret = true;
+  }
+
+  if (args->argc == 2 && args->isStr(0, "cache"))
+  {
+    layer_cache_set_enable(args->isStr(1, "on"));
+    cliPrintf("cache %s\n", cache_on ? "on" : "off");
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "clear"))
+  {
+    stat_lookups  = 0;
+    stat_updates  = 0;
+    stat_keys     = 0;
+    stat_rebuilds = 0;
+    ret = true;
+  }
+
+  if (ret == false)
+  {
+    cliPrintf("layer info\n");
+    cliPrintf("layer map\n");
+    cliPrintf("layer cache [on | off]\n");
+    cliPrintf("layer clear\n");
+  }
+}
+#endif
@@ -0,0 +1,39 @@
+/*
+ * 순정 dynamic_keymap.c 를 **감싸서** 컴파일한다 — 키맵을 바꾸는 입구에서 레이어 캐시를 무효로 한다.
+ *
+ * VIA 의 키 하나 바꾸기(set_keycode), 버퍼 쓰기(set_buffer — 순정 VIA 와 벌크 KEYMAP 영역),
+ * 공장 키맵으로 되돌리기(reset)가 여기를 지난다. 벌크 **EEPROM 영역** 쓰기는 미러에 바로 쓰므로
+ * 여기를 안 지난다 — 키맵 범위와 겹치면 port/via/via_bulk.c 가 따로 무효화한다.
+ * 투명/비투명이 바뀌었는지 따지지 않고 통째로 버린다 — 편집은 드물고, 다시 만드는 건 다음 키 한 번(레이어 x 키 수만큼 action_for_key)이다.
+ *
+ * qmk/CMakeLists.txt 는 원본 대신 이 파일을 목록에 넣는다(layer_cache.h).
+ */
+#include "layer_cache.h"
+#include "quantum.h"   // dynamic_keymap.h 의 원래 이름 선언을 먼저 — 아래 rename 은 원본 정의에만 걸린다
+
+#define dynamic_keymap_set_keycode  dynamic_keymap_set_keycode_vendor
+#define dynamic_keymap_set_buffer   dynamic_keymap_set_buffer_vendor
+#define dynamic_keymap_reset        dynamic_keymap_reset_vendor
+#include "../../quantum/dynamic_keymap.c"
+#undef dynamic_keymap_set_keycode
+#undef dynamic_keymap_set_buffer
+#undef dynamic_keymap_reset
+
+
+void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode)
+{
+  dynamic_keymap_set_keycode_vendor(layer, row, column, keycode);
+  layer_cache_invalidate();
+}
+
+void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data)
+{
+  dynamic_keymap_set_buffer_vendor(offset, size, data);
+  layer_cache_invalidate();
+}
+
+void dynamic_keymap_reset(void)
+{
+  dynamic_keymap_reset_vendor();
+  layer_cache_invalidate();
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 레이어 조회(quantum/action_layer.c 의 layer_switch_get_layer) **캐시**.
+ *
+ * 순정은 키를 누를 때마다 켜진 레이어를 위에서부터 내려가며 action_for_key() 를 부른다 — 레이어마다
+ * EEPROM 미러에서 키코드를 읽고 액션으로 바꿔 KC_TRNS 인지 본다. 위쪽 레이어가 대부분 투명(8 레이어 중
+ * 키맵이 채운 건 2~3 개)이라 MO 를 올린 채 치면 키마다 그 몇 층을 헛돈다.
+ *
+ * action_layer_wrapper.c 가 원본을 감싸 layer_switch_get_layer() 만 바꾼다:
+ *  - 키마다 "투명이 아닌 레이어" 비트마스크, 레이어마다 "투명이 아닌 키" 행 비트맵을 키맵에서 한 번 만든다.
+ *  - 키마다 지금 레이어 상태의 최상위 유효 레이어를 들고 있다. 레이어 상태가 바뀌면 **바뀐 레이어가
+ *    투명이 아닌 키만** 다시 계산한다(바뀐 레이어가 투명인 키는 답이 안 바뀐다). 조회는 배열 한 칸이다.
+ *  - 키맵이 바뀌면(dynamic_keymap 의 set_keycode / set_buffer / reset — dynamic_keymap_wrapper.c,
+ *    키맵 범위를 덮는 벌크 EEPROM 쓰기 — port/via/via_bulk.c) 마스크를 버리고 다음 조회 때 다시 만든다.
+ * 판정은 순정과 같다 — 같은 action_for_key() 결과로 만든 표다. CLI `layer cache off` 로 순정과 비교한다.
+ */
+
+void    layer_cache_init(void);
+
+// 키맵이 바뀌었다 — 다음 조회 때 마스크를 다시 만든다.
+void    layer_cache_invalidate(void);
+
+// false = 순정 경로(레이어를 위에서부터 훑는다). 비교용 — CLI `layer cache`, native_sim `--layer-bench`.
+void    layer_cache_set_enable(bool enable);
+bool    layer_cache_is_enabled(void);
@@ -18,6 +18,8 @@
  * ScrollLock 추가, 레이어 표시 등. 그런 키보드는 config.h 에 KBD_CUSTOM_INDICATOR 를 정의하고
  * keyboards/<kbd>/port/ 에 자기 led_update_kb() 를 두면 된다. 이 파일은 그때 통째로 빠진다.
  * (약한 심볼을 둘 두는 방식은 쓰지 않는다 — 링커가 임의로 골라 조용히 틀린다)
+ * Caps/레이어를 **RGB 로만** 보일 거면 led_update_kb() 를 쓸 필요도 없다 — 보드 config.h 에
+ * RGB_INDICATOR_* 를 정의하면 port/rgb_indicator.c 가 ws2812 오버레이로 보인다(wish40).
  *
  * QMK 가 배선을 다 해준다: keyboard_task() -> led_task() -> host_keyboard_leds() 로 호스트
  * LED 리포트를 읽고, 바뀌면 led_update_kb() 를 부른다. host_keyboard_leds() 는 활성
@@ -1,5 +1,7 @@
 #include "matrix.h"
 #include "debounce.h"
+#include "qmk/qmk.h"   // qmkWake / wake_stat
+#include "cli.h"
 #include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
@@ -31,8 +33,9 @@
  *    메인 루프(ap.c)가 세마포어에서 블록 → CPU sleep. 드라이버도 인터럽트 대기로 들어간다.
  *  - GRACE 는 QMK 디바운스(sym_defer_pk, DEBOUNCE=5ms)가 정착할 시간을 준다.
  *
- * 한계(의도적): 키가 안 눌린 상태에서 도는 QMK 타이머(tap dance, one-shot 만료 등)는
- * 잠든 동안 진행되지 않고 다음 키 입력에서 재개된다. 현재 키맵(MO 레이어)엔 해당 없음.
+ * 키가 안 눌린 상태에서 도는 QMK 타이머(탭/홀드 판정 등)는 port/deadline 에 다음 시각을 알려야
+ * 잠든 동안에도 제때 돈다. 알리지 않는 기능은 다음 키 입력에서야 재개된다 — tap dance/leader 를
+ * 켤 땐 데드라인을 등록하는 래퍼부터 넣을 것(§2.6).
  */
 #define MATRIX_IDLE_GRACE_MS   20
 
@@ -42,6 +45,11 @@ static volatile uint32_t     last_activity_ms;
 static volatile matrix_row_t raw_matrix[MATRIX_ROWS];   // input 콜백이 갱신
 static matrix_row_t          matrix[MATRIX_ROWS];       // 디바운스 결과
 
+#if CLI_USE(HW_MATRIX)
+static void cliMatrix(cli_args_t *args);
+static void matrix_rec_edge(uint8_t row, uint8_t col, bool pressed);
+#endif
+
 // input 콜백은 kbd-matrix 드라이버 스캔 스레드 컨텍스트에서 불린다(동기 모드).
 // raw_matrix 는 이 콜백만 쓰고 matrix_scan() 은 읽기만 하므로 lost update 는 없다.
 static void kbd_matrix_input_cb(struct input_event *evt, void *user_data)
@@ -80,9 +88,13 @@ static void kbd_matrix_input_cb(struct input_event *evt, void *user_data)
         {
           raw_matrix[qmk_row] &= ~((matrix_row_t)1 << qmk_col);
         }
+#if CLI_USE(HW_MATRIX)
+        matrix_rec_edge(qmk_row, qmk_col, evt->value != 0);
+#endif
       }
       // 메인 루프 깨우기 (잠들어 있었다면). 세마포어가 이미 차 있어도 무해.
       last_activity_ms = k_uptime_get_32();
+      wakeStatPost(WAKE_REASON_KEY);
       k_sem_give(&kbd_activity_sem);
       break;
 
@@ -115,7 +127,10 @@ INPUT_CALLBACK_DEFINE(DEVICE_DT_GET(DT_NODELABEL(kbd_matrix)), kbd_matrix_input_
                "sense-edge-mask -- update &gpio0/&gpio1 sense-edge-mask in the board DTS. " \
                "(without it: GPIOTE runs out of channels and System OFF cannot wake)");
 
+// native_sim 의 스크립트 매트릭스(baram,sim-kbd-matrix)엔 row-gpios 가 없다 — 검사할 핀도 없다.
+#if DT_NODE_HAS_PROP(DT_NODELABEL(kbd_matrix), row_gpios)
 DT_FOREACH_PROP_ELEM(DT_NODELABEL(kbd_matrix), row_gpios, ROW_SENSE_MASK_CHECK)
+#endif
 
 void matrix_init(void)
 {
@@ -123,6 +138,10 @@ void matrix_init(void)
   memset(matrix, 0, sizeof(matrix));
 
   debounce_init(MATRIX_ROWS);
+
+#if CLI_USE(HW_MATRIX)
+  cliAdd("matrix", cliMatrix);
+#endif
 }
 
 void matrix_print(void)
@@ -176,12 +195,38 @@ bool qmkIsIdle(void)
   return (k_uptime_get_32() - last_activity_ms) >= MATRIX_IDLE_GRACE_MS;
 }
 
+// raw 와 디바운스 결과가 같다 = 진행 중인 디바운스가 없다. 활성 틱을 늘려도 되는지 볼 때 쓴다(port/mousekey_port.c).
+bool qmkIsMatrixSettled(void)
+{
+  for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+  {
+    if (raw_matrix[row] != matrix[row])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 // 키 입력이 있을 때까지 블록. 이 동안 CPU 는 잠들고, kbd-matrix 드라이버는
 // 전 컬럼 구동 + row 인터럽트 대기 상태로 들어간다(눌림 시 콜백이 세마포어를 준다).
 // timeout_ms 는 activity 상태머신의 다음 데드라인(idle/sleep 전이) — 0 이면 무한.
 void qmkWaitActivity(uint32_t timeout_ms)
 {
-  k_sem_take(&kbd_activity_sem, timeout_ms == 0 ? K_FOREVER : K_MSEC(timeout_ms));
+  int ret;
+
+  wakeStatEnterSleep();
+  ret = k_sem_take(&kbd_activity_sem, timeout_ms == 0 ? K_FOREVER : K_MSEC(timeout_ms));
+  wakeStatExitSleep(ret != 0);
+}
+
+// 깨우는 쪽이 세마포어를 줘도 k_msleep 은 안 끝난다 — 그 몫은 다음 qmkWaitActivity() 가 바로 받아 센다.
+void qmkWaitTick(uint32_t ms)
+{
+  wakeStatSetDeadline(WAKE_REASON_TICK);
+  wakeStatEnterSleep();
+  k_msleep(ms);
+  wakeStatExitSleep(true);
 }
 
 uint32_t qmkGetInactiveMs(void)
@@ -189,9 +234,111 @@ uint32_t qmkGetInactiveMs(void)
   return k_uptime_get_32() - last_activity_ms;
 }
 
-void qmkWake(void)
+void qmkWake(wake_reason_t reason)
 {
   // 키 입력과 같은 경로로 깨운다. last_activity_ms 는 건드리지 않는다 —
   // 이건 "사용자 입력"이 아니므로 idle/sleep 타이머를 리셋하면 안 된다.
+  wakeStatPost(reason);
   k_sem_give(&kbd_activity_sem);
 }
+
+
+#if CLI_USE(HW_MATRIX)
+/*
+ * 트레이스 녹화 — 실제 타이핑을 native_sim 지연 벤치(§7.2.1)의 매트릭스 스크립트 형식 그대로 받는다.
+ *
+ *   matrix rec start   버퍼를 비우고 녹화 시작
+ *   matrix rec stop    멈춤
+ *   matrix rec dump    스크립트로 찍는다 -> src/sim/traces/<이름>.txt 로 저장
+ *
+ * 시각은 드라이버가 엣지를 알린 시각(QMK 디바운스 전)이다 — sim 의 스크립트 매트릭스도 같은 자리에
+ * 엣지를 넣는다. 첫 엣지를 1000ms 로 옮긴다(합성 트레이스들처럼 부팅 정착 뒤에 시작). 좌표는 이 보드의
+ * QMK (row, col) 라 같은 키보드(KEYBOARD_PATH)로 빌드한 sim 에서만 같은 키가 된다.
+ * 버퍼가 차면 거기서 멈춘다. 디버그 콘솔 빌드에만 있다.
+ */
+#define MATRIX_REC_MAX        1024
+#define MATRIX_REC_START_MS   1000
+#define MATRIX_REC_TAIL_MS    500
+
+typedef struct
+{
+  uint32_t t_ms;
+  uint8_t  row;
+  uint8_t  col;
+  bool     pressed;
+} matrix_rec_t;
+
+static matrix_rec_t      rec_buf[MATRIX_REC_MAX];
+static volatile uint32_t rec_cnt  = 0;
+static volatile bool     rec_on   = false;
+static bool              rec_full = false;
+
+// input 콜백(드라이버 스캔 스레드)만 쓴다. CLI 는 rec_on 을 내린 뒤에 읽는다.
+static void matrix_rec_edge(uint8_t row, uint8_t col, bool pressed)
+{
+  if (!rec_on)
+  {
+    return;
+  }
+  if (rec_cnt >= MATRIX_REC_MAX)
+  {
+    rec_on   = false;
+    rec_full = true;
+    return;
+  }
+  rec_buf[rec_cnt].t_ms    = k_uptime_get_32();
+  rec_buf[rec_cnt].row     = row;
+  rec_buf[rec_cnt].col     = col;
+  rec_buf[rec_cnt].pressed = pressed;
+  rec_cnt++;
+}
+
+void cliMatrix(cli_args_t *args)
+{
+  bool ret = false;
+
+  if (args->argc == 2 && args->isStr(0, "rec") && args->isStr(1, "start"))
+  {
+    rec_on   = false;
+    rec_cnt  = 0;
+    rec_full = false;
+    rec_on   = true;
+    cliPrintf("recording (max %d edges)\n", MATRIX_REC_MAX);
+    ret = true;
+  }
+
+  if (args->argc == 2 && args->isStr(0, "rec") && args->isStr(1, "stop"))
+  {
+    rec_on = false;
+    cliPrintf("stopped : %d edges%s\n", rec_cnt, rec_full ? " (buffer full)" : "");
+    ret = true;
+  }
+
+  if (args->argc == 2 && args->isStr(0, "rec") && args->isStr(1, "dump"))
+  {
+    uint32_t cnt = rec_cnt;
+
+    rec_on = false;
+    cliPrintf("# matrix rec : %d edges%s\n", cnt, rec_full ? ", buffer full" : "");
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+      const matrix_rec_t *p_rec = &rec_buf[i];
+
+      cliPrintf("%d %d %d %c\n", p_rec->t_ms - rec_buf[0].t_ms + MATRIX_REC_START_MS, p_rec->row, p_rec->col,
+                p_rec->pressed ? 'd' : 'u');
+    }
+    if (cnt > 0)
+    {
+      cliPrintf("%d exit\n", rec_buf[cnt - 1].t_ms - rec_buf[0].t_ms + MATRIX_REC_START_MS + MATRIX_REC_TAIL_MS);
+    }
+    ret = true;
+  }
+
+  if (ret == false)
+  {
+    cliPrintf("matrix rec start\n");
+    cliPrintf("matrix rec stop\n");
+    cliPrintf("matrix rec dump\n");
+  }
+}
+#endif
@@ -0,0 +1,171 @@
+#include "mousekey_port.h"
+#include "quantum.h"
+#include "mousekey.h"
+#include "host.h"
+#include "ble.h"
+#include "cli.h"
+#include "qmk/qmk.h"   // qmkIsMatrixSettled
+
+
+#if CLI_USE(HW_MOUSE)
+static void cliMouse(cli_args_t *args);
+#endif
+
+extern host_driver_t usb_driver;   // port/driver_usb.c
+extern host_driver_t ble_driver;   // port/driver_ble.c
+
+#define MOUSE_USB_PERIOD_US   1000   // DTS hid_mouse in-polling-period-us
+
+static bool     moving    = false;
+static uint32_t period_us = 0;    // 지금 transport 의 리포트 주기, 0 = 모름
+static uint32_t interval  = 0;    // 지금 적용한 반복 주기(ms), 0 = 아직 맞춘 적 없다
+#if !defined(MK_3_SPEED) && !defined(MK_KINETIC_SPEED)
+static uint8_t  base_max_speed   = MOUSEKEY_MAX_SPEED;
+static uint8_t  base_time_to_max = MOUSEKEY_TIME_TO_MAX;
+#endif
+
+
+static uint32_t mousekey_port_period_us(void)
+{
+  host_driver_t *driver = host_get_driver();
+
+  if (driver == &usb_driver)
+  {
+    return MOUSE_USB_PERIOD_US;
+  }
+  if (driver == &ble_driver)
+  {
+    return bleGetConnIntervalUs();
+  }
+  return 0;
+}
+
+// 반복 주기를 바꾸고, 리포트당 이동량/가속 리포트 수를 같은 비율로 맞춰 초당 속도를 지킨다.
+static void mousekey_port_apply(uint32_t new_interval)
+{
+  if (new_interval > UINT8_MAX)
+  {
+    new_interval = UINT8_MAX;
+  }
+  if (new_interval == interval)
+  {
+    return;
+  }
+  interval = new_interval;
+
+#if !defined(MK_3_SPEED) && !defined(MK_KINETIC_SPEED)
+  uint32_t speed = (uint32_t)base_max_speed * interval / MOUSEKEY_INTERVAL;
+  uint32_t ttm   = (uint32_t)base_time_to_max * MOUSEKEY_INTERVAL / interval;
+
+  mk_interval    = (uint8_t)interval;
+  mk_max_speed   = (uint8_t)MIN(speed, UINT8_MAX);
+  mk_time_to_max = (uint8_t)MAX(ttm, 1);
+#endif
+}
+
+void mousekey_port_init(void)
+{
+#if !defined(MK_3_SPEED) && !defined(MK_KINETIC_SPEED)
+  base_max_speed   = mk_max_speed;
+  base_time_to_max = mk_time_to_max;
+#endif
+
+#if CLI_USE(HW_MOUSE)
+  cliAdd("mouse", cliMouse);
+#endif
+}
+
+void mousekey_port_task(void)
+{
+  report_mouse_t report = mousekey_get_report();
+
+  moving = report.x || report.y || report.v || report.h;
+  if (!moving)
+  {
+    return;   // 멈춰 있으면 transport 를 묻지 않는다(BLE 는 연결 조회가 든다)
+  }
+
+  period_us = mousekey_port_period_us();
+
+  uint32_t period_ms = (period_us + 999) / 1000;
+
+#ifdef MK_3_SPEED
+  interval = MAX(period_ms, 1);   // 반복은 자체 표(mk_speed)가 정한다 — MOUSEKEY_INTERVAL 도 없다. 틱만 맞춘다
+#else
+  mousekey_port_apply(MAX(period_ms, MOUSEKEY_INTERVAL));
+#endif
+}
+
+/*
+ * 틱을 늘려도 되는가 — 눌린 키가 **전부 마우스키**이고 디바운스가 정착했을 때만.
+ * qmkWaitTick() 은 그냥 k_msleep 이라 늘린 틱 동안은 매트릭스 엣지에도 안 깬다. 다른 키(수식/레이어/
+ * 탭홀드)가 같이 눌려 있으면 그 키의 디바운스·탭핑 판정과 뗌이 연결 간격만큼 밀린다.
+ * 키코드는 누를 때 정한 레이어(source layer cache)로 본다 — MO 로 올린 레이어의 마우스키는 MO 키가
+ * 같이 눌려 있으니 어차피 늘리지 않는다.
+ */
+static bool mousekey_port_can_stretch(void)
+{
+  if (!qmkIsMatrixSettled())
+  {
+    return false;
+  }
+
+  for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+  {
+    matrix_row_t bits = matrix_get_row(row);
+
+    for (uint8_t col = 0; bits != 0; col++, bits >>= 1)
+    {
+      if ((bits & 1) && !IS_MOUSEKEY(get_event_keycode(MAKE_KEYEVENT(row, col, true), false)))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+uint32_t mousekey_port_tick_ms(void)
+{
+  if (!moving || period_us == 0)
+  {
+    return QMK_TASK_PERIOD_MS;
+  }
+
+  // 연결 간격보다 자주 돌아도 리포트는 다음 이벤트에 나간다. 반복 주기보다 길면 리포트를 거른다.
+  uint32_t tick_ms = MIN(MAX(period_us / 1000, 1), interval);
+
+  // 줄이는 쪽(USB 1ms)은 늘 괜찮다. 늘리는 쪽은 다른 키가 없을 때만.
+  if (tick_ms > QMK_TASK_PERIOD_MS && !mousekey_port_can_stretch())
+  {
+    return QMK_TASK_PERIOD_MS;
+  }
+  return tick_ms;
+}
+
+
+#if CLI_USE(HW_MOUSE)
+void cliMouse(cli_args_t *args)
+{
+  bool ret = false;
+
+  if (args->argc == 1 && args->isStr(0, "info"))
+  {
+    host_driver_t *driver = host_get_driver();
+
+    cliPrintf("transport   : %s, period %d us\n",
+              driver == &usb_driver ? "USB" : driver == &ble_driver ? "BLE" : "-", mousekey_port_period_us());
+    cliPrintf("moving      : %s, tick %d ms\n", moving ? "yes" : "no", mousekey_port_tick_ms());
+#if !defined(MK_3_SPEED) && !defined(MK_KINETIC_SPEED)
+    cliPrintf("repeat      : %d ms, max speed %d, time to max %d (base %d ms, %d, %d)\n", mk_interval,
+              mk_max_speed, mk_time_to_max, MOUSEKEY_INTERVAL, base_max_speed, base_time_to_max);
+#endif
+    ret = true;
+  }
+
+  if (ret == false)
+  {
+    cliPrintf("mouse info\n");
+  }
+}
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 마우스키 반복을 **transport 주기**에 맞춘다.
+ *
+ * 순정 mousekey_task() 는 키를 누르고 있는 동안 MOUSEKEY_INTERVAL 마다 이동 리포트를 내고(quantum/mousekey.h —
+ * 이 트리의 기본 가속 설정에선 20ms, MK_KINETIC_SPEED 10ms, MOUSEKEY_INERTIA 16ms), 루프는
+ * 키가 눌려 있으니 QMK_TASK_PERIOD_MS 로 돈다. 둘 다 transport 를 모른다:
+ *  - USB 는 호스트가 1ms 마다 가져간다 — 2ms 틱이면 리포트가 나갈 시각이 최대 1 틱 밀린다.
+ *  - BLE 는 연결 이벤트(7.5~30ms)마다 나간다 — 그보다 자주 깨거나 리포트를 내도 다음 이벤트를
+ *    기다릴 뿐이다. 2ms 틱은 그 사이 CPU 만 깨운다.
+ * 그래서 **이동/휠이 살아 있는 동안만** 활성 틱(qmkGetTickMs)과 반복 주기(mk_interval)를 transport 에 맞춘다:
+ *   USB : 틱 1ms, 반복 MOUSEKEY_INTERVAL 그대로
+ *   BLE : 틱 = 연결 간격, 반복 = max(MOUSEKEY_INTERVAL, 연결 간격)
+ * 반복이 길어지면 리포트당 이동량(mk_max_speed)을 그만큼 키우고 가속 리포트 수(mk_time_to_max)를 줄여
+ * 초당 속도와 가속 시간을 USB 와 같게 둔다. 버튼만 누르고 있거나 멈추면 원래 틱으로 돌아간다.
+ * 틱을 QMK_TASK_PERIOD_MS 보다 **늘리는 건** 눌린 키가 전부 마우스키이고 디바운스가 정착했을 때뿐이다 —
+ * qmkWaitTick() 은 매트릭스 엣지에 안 깨므로, 다른 키가 같이 눌려 있으면 그 키의 판정이 밀린다.
+ * 그 조건에서 새로 누른 키는 늘린 틱 하나(≤ 연결 간격)만큼 늦게 보인다 — BLE 리포트가 어차피 기다리는 폭이다.
+ * 키를 다 떼면 루프는 평소처럼 잔다 — 마우스키가 루프를 붙잡는 건 누르고 있는 동안뿐이다.
+ *
+ * MK_3_SPEED / MK_KINETIC_SPEED 는 반복 주기를 자체 표/시간으로 정하므로 틱만 맞춘다
+ * (MK_3_SPEED 엔 MOUSEKEY_INTERVAL 자체가 없다).
+ */
+
+void     mousekey_port_init(void);
+
+// qmkUpdate() 에서 keyboard_task() 뒤 — 이번 회차의 키 처리로 바뀐 이동 상태를 본다.
+void     mousekey_port_task(void);
+
+// 활성 구간(키 눌림)의 한 주기(ms). 이동 중이 아니거나 마우스키 아닌 키가 눌려 있으면 QMK_TASK_PERIOD_MS.
+uint32_t mousekey_port_tick_ms(void);
@@ -29,6 +29,7 @@ static bool                 dirty;
 static uint32_t             dirty_min;      // 변경 범위(포함) [dirty_min, dirty_max]
 static uint32_t             dirty_max;
 static uint32_t             last_write_ms;
+static uint32_t             flush_delay_ms = EE_FLUSH_DELAY_MS;
 static bool                 is_req_clean = false;
 
 void eeprom_init(void)
@@ -60,17 +61,23 @@ static void eeprom_flush(void)
       return;   // 실패 시 dirty 유지 → 다음 task 에서 재시도
     }
   }
-  dirty = false;
+  dirty          = false;
+  flush_delay_ms = EE_FLUSH_DELAY_MS;   // 늘린 대기는 이번 버스트에만 적용
 }
 
 void eeprom_update(void)
 {
-  if (dirty && (millis() - last_write_ms) >= EE_FLUSH_DELAY_MS)
+  if (dirty && (millis() - last_write_ms) >= flush_delay_ms)
   {
     eeprom_flush();
   }
 }
 
+void eeprom_set_flush_delay(uint32_t ms)
+{
+  flush_delay_ms = MAX(ms, EE_FLUSH_DELAY_MS);
+}
+
 bool eeprom_is_dirty(void)
 {
   return dirty;
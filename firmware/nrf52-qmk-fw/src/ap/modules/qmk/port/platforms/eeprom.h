@@ -18,6 +18,16 @@ void     eeprom_update(void);
  * 유실된다(실제로 겪음: RGB 를 끄고 전원을 껐다 켜면 다시 켜져 있었다).
  */
 bool     eeprom_is_dirty(void);
+
+/*
+ * 이번 편집 버스트의 settle 대기를 늘린다(기본 100ms 보다 짧게는 못 줄인다). flush 가 끝나면
+ * 기본값으로 돌아간다.
+ *
+ * VIA-over-BLE 용이다. USB 는 VIA 명령 사이 간격이 수 ms 라 100ms 면 편집 전체가 flush 1회로
+ * 합쳐지지만, BLE 는 연결 간격 × slave latency 만큼 명령이 늦게 와서 간격이 100ms 를 넘는다 —
+ * 그러면 키코드 하나 바꿀 때마다 플래시를 쓴다(settle-flush 무력화).
+ */
+void     eeprom_set_flush_delay(uint32_t ms);
 void     eeprom_task(void);
 void     eeprom_req_clean(void);
 uint8_t  eeprom_read_byte(const uint8_t *addr);
@@ -36,9 +36,24 @@
 #define EECONFIG_USER_DEBOUNCE ((void *)((uint32_t)EECONFIG_USER_DATABLOCK + 8))  // 4B  디바운스 시간(ms)
 #define EECONFIG_USER_HOLD_OKP ((void *)((uint32_t)EECONFIG_USER_DATABLOCK + 12)) // 4B  HOLD_ON_OTHER_KEY_PRESS
 #define EECONFIG_USER_RGB_CFG  ((void *)((uint32_t)EECONFIG_USER_DATABLOCK + 16)) // 4B  RGB 소등 타임아웃
-// 다음 빈 오프셋: 20
+#define EECONFIG_USER_RGB_LIMIT ((void *)((uint32_t)EECONFIG_USER_DATABLOCK + 20)) // 4B  RGB 전류 예산(USB/배터리)
+// 다음 빈 오프셋: 24
 //
 // [왜 POWER(+0)의 남는 rsv 바이트를 안 썼나] 기존 보드엔 rsv=0 이 magic 과 함께 이미 저장돼
 // 있다. 거기에 RGB 타임아웃을 얹으면 업그레이드 시 0 = "안 끔" 으로 읽혀 **RGB 가 영영 안 꺼진다**
 // (그 상태로 deep sleep 에 들어가면 네오픽셀이 65mA 로 계속 켜져 있다). 새 항목은 새 오프셋에
 // 자기 magic 과 함께 — 위 [규칙] 대로.
+
+/*
+ * EEPROM 끝 영역 — 콤보/탭댄스/키 오버라이드 동적 표(port/via/dynamic_feature.c).
+ *
+ * 수백 B 라 위 512B 사용자 영역에 안 들어가고, 사용자 영역을 키우면 키맵이 밀린다(위 [규칙]).
+ * 그래서 **맨 끝**에 둔다: 키보드 config.h 가 DYNAMIC_KEYMAP_EEPROM_MAX_ADDR 를 이 크기만큼 당겨
+ * 매크로 버퍼만 줄인다. 키맵 주소는 그대로라 QMK_BUILDDATE 를 올리지 않는다 — 잘리는 건 줄어든
+ * 매크로 버퍼 끝에 걸쳐 있던 매크로뿐이다. 이 영역의 유효성은 자기 헤더(magic/version)로 판별한다.
+ *
+ *   [EECONFIG | VIA | 키맵 x 레이어 | 매크로 ... MAX_ADDR] [동적 표 DYNAMIC_FEATURE_EEPROM_SIZE]
+ */
+#ifdef DYNAMIC_FEATURE_EEPROM_SIZE
+#define EECONFIG_DYNAMIC_FEATURE ((void *)(TOTAL_EEPROM_BYTE_COUNT - DYNAMIC_FEATURE_EEPROM_SIZE))
+#endif
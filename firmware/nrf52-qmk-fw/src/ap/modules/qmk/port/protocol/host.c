@@ -5,9 +5,20 @@
  * 우회했으나, 이 프로젝트는 원본 방식으로 되돌린다: 전송은 전적으로
  * host_driver_t(현재 활성 드라이버)의 함수 포인터로만 이뤄진다.
  * USB/BLE 전환은 host_set_driver(&usb_driver | &ble_driver) 로 처리한다.
+ *
+ * [중복 리포트 억제] 드라이버(transport)마다 마지막으로 보낸 리포트를 종류별로 들고, 바이트가 같으면
+ * 보내지 않는다. 같은 리포트도 USB 는 IN 전송 한 번, BLE 는 notification 한 번이고 BLE 는 그때마다
+ * slave latency 가 깨진다(§6.8). 순정 send_6kro_report() 도 직전 리포트와 비교하지만 transport 를
+ * 모르는 전역 하나라, 전환 전후나 드라이버를 직접 부른 리포트는 못 본다.
+ *  - 마우스는 **버튼만 있는 리포트**만 비교한다 — 이동/휠은 상대값이라 같은 바이트여도 매번 의미가 있다.
+ *  - 전환 때의 빈 리포트(host_keyboard_flush)는 비교 없이 **항상** 나간다.
+ *  - 드라이버가 전송에 실패하면 host_report_invalidate() 로 기억을 버린다 — 호스트가 못 받은
+ *    리포트를 "보냈다"로 들고 있으면 다음 같은 리포트가 막힌다.
+ * 비율은 CLI `host info`.
  */
 
 #include <stdint.h>
+#include <string.h>
 #include "host.h"
 #include "report.h"
 #include "keycode_config.h"
@@ -16,15 +27,117 @@
 extern keymap_config_t keymap_config;
 #endif
 
+#define HOST_DRIVER_MAX     2   // usb_driver, ble_driver
+
+enum
+{
+  HOST_REPORT_KEYBOARD,
+  HOST_REPORT_NKRO,
+  HOST_REPORT_MOUSE,
+  HOST_REPORT_EXTRA,
+  HOST_REPORT_MAX,
+};
+
+typedef struct
+{
+  host_driver_t     *driver;
+  bool               kbd_valid;
+  bool               nkro_valid;
+  bool               mouse_valid;
+  report_keyboard_t  kbd;
+  report_nkro_t      nkro;
+  uint8_t            mouse_buttons;
+} host_last_t;
+
+#if CLI_USE(HW_HOST)
+static void cliHost(cli_args_t *args);
+#endif
+
 static host_driver_t *driver;
 static uint16_t       last_system_usage   = 0;
 static uint16_t       last_consumer_usage = 0;
 
+static host_last_t    last_tbl[HOST_DRIVER_MAX];
+static uint32_t       stat_sent[HOST_REPORT_MAX];
+static uint32_t       stat_dup[HOST_REPORT_MAX];
+static uint32_t       stat_flush = 0;
+
+
+// 드라이버의 기억 칸. 처음 보는 드라이버면 빈 칸을 준다 — 칸이 모자라면 NULL(비교 없이 보낸다).
+static host_last_t *host_last_get(host_driver_t *d)
+{
+  for (uint8_t i = 0; i < HOST_DRIVER_MAX; i++)
+  {
+    if (last_tbl[i].driver == d)
+    {
+      return &last_tbl[i];
+    }
+  }
+  for (uint8_t i = 0; i < HOST_DRIVER_MAX; i++)
+  {
+    if (last_tbl[i].driver == NULL)
+    {
+      memset(&last_tbl[i], 0, sizeof(host_last_t));
+      last_tbl[i].driver = d;
+      return &last_tbl[i];
+    }
+  }
+  return NULL;
+}
+
+void host_init(void)
+{
+#if CLI_USE(HW_HOST)
+  cliAdd("host", cliHost);
+#endif
+}
+
 void host_set_driver(host_driver_t *d)
 {
   driver = d;
 }
 
+void host_report_invalidate(void)
+{
+  if (!driver) return;
+
+  host_last_t *last = host_last_get(driver);
+
+  if (last == NULL) return;
+  last->kbd_valid   = false;
+  last->nkro_valid  = false;
+  last->mouse_valid = false;
+}
+
+void host_keyboard_flush(void)
+{
+  if (!driver) return;
+
+  host_last_t      *last  = host_last_get(driver);
+  report_keyboard_t empty = {0};
+#ifdef KEYBOARD_SHARED_EP
+  empty.report_id = REPORT_ID_KEYBOARD;
+#endif
+  if (last != NULL)
+  {
+    last->kbd       = empty;
+    last->kbd_valid = true;
+  }
+  stat_flush++;
+  (*driver->send_keyboard)(&empty);
+
+  // 마우스 버튼이 눌린 채 넘어가면 그것도 이전 호스트에 남는다.
+  if (last != NULL && last->mouse_valid && last->mouse_buttons != 0)
+  {
+    report_mouse_t mouse = {0};
+#ifdef MOUSE_SHARED_EP
+    mouse.report_id = REPORT_ID_MOUSE;
+#endif
+    last->mouse_buttons = 0;
+    (*driver->send_mouse)(&mouse);
+  }
+}
+
 host_driver_t *host_get_driver(void)
 {
   return driver;
@@ -47,6 +160,19 @@ void host_keyboard_send(report_keyboard_t *report)
 #ifdef KEYBOARD_SHARED_EP
   report->report_id = REPORT_ID_KEYBOARD;
 #endif
+  host_last_t *last = host_last_get(driver);
+
+  if (last != NULL)
+  {
+    if (last->kbd_valid && memcmp(&last->kbd, report, sizeof(report_keyboard_t)) == 0)
+    {
+      stat_dup[HOST_REPORT_KEYBOARD]++;
+      return;
+    }
+    last->kbd       = *report;
+    last->kbd_valid = true;
+  }
+  stat_sent[HOST_REPORT_KEYBOARD]++;
   (*driver->send_keyboard)(report);
 }
 
@@ -54,6 +180,20 @@ void host_nkro_send(report_nkro_t *report)
 {
   if (!driver) return;
   report->report_id = REPORT_ID_NKRO;
+
+  host_last_t *last = host_last_get(driver);
+
+  if (last != NULL)
+  {
+    if (last->nkro_valid && memcmp(&last->nkro, report, sizeof(report_nkro_t)) == 0)
+    {
+      stat_dup[HOST_REPORT_NKRO]++;
+      return;
+    }
+    last->nkro       = *report;
+    last->nkro_valid = true;
+  }
+  stat_sent[HOST_REPORT_NKRO]++;
   (*driver->send_nkro)(report);
 }
 
@@ -63,12 +203,30 @@ void host_mouse_send(report_mouse_t *report)
 #ifdef MOUSE_SHARED_EP
   report->report_id = REPORT_ID_MOUSE;
 #endif
+  host_last_t *last   = host_last_get(driver);
+  bool         motion = report->x || report->y || report->v || report->h;
+
+  if (last != NULL)
+  {
+    if (!motion && last->mouse_valid && last->mouse_buttons == report->buttons)
+    {
+      stat_dup[HOST_REPORT_MOUSE]++;
+      return;
+    }
+    last->mouse_buttons = report->buttons;
+    last->mouse_valid   = true;
+  }
+  stat_sent[HOST_REPORT_MOUSE]++;
   (*driver->send_mouse)(report);
 }
 
 void host_system_send(uint16_t usage)
 {
-  if (usage == last_system_usage) return;
+  if (usage == last_system_usage)
+  {
+    stat_dup[HOST_REPORT_EXTRA]++;
+    return;
+  }
   last_system_usage = usage;
 
   if (!driver) return;
@@ -76,12 +234,17 @@ void host_system_send(uint16_t usage)
     .report_id = REPORT_ID_SYSTEM,
     .usage     = usage,
   };
+  stat_sent[HOST_REPORT_EXTRA]++;
   (*driver->send_extra)(&report);
 }
 
 void host_consumer_send(uint16_t usage)
 {
-  if (usage == last_consumer_usage) return;
+  if (usage == last_consumer_usage)
+  {
+    stat_dup[HOST_REPORT_EXTRA]++;
+    return;
+  }
   last_consumer_usage = usage;
 
   if (!driver) return;
@@ -89,6 +252,7 @@ void host_consumer_send(uint16_t usage)
     .report_id = REPORT_ID_CONSUMER,
     .usage     = usage,
   };
+  stat_sent[HOST_REPORT_EXTRA]++;
   (*driver->send_extra)(&report);
 }
 
@@ -101,3 +265,41 @@ uint16_t host_last_consumer_usage(void)
 {
   return last_consumer_usage;
 }
+
+
+#if CLI_USE(HW_HOST)
+void cliHost(cli_args_t *args)
+{
+  bool ret = false;
+
+  if (args->argc == 1 && args->isStr(0, "info"))
+  {
+    static const char *type_name[HOST_REPORT_MAX] = {"keyboard", "nkro", "mouse", "extra"};
+
+    cliPrintf("type           sent      dup   dup %%\n");
+    for (uint8_t i = 0; i < HOST_REPORT_MAX; i++)
+    {
+      uint32_t total = stat_sent[i] + stat_dup[i];
+      uint32_t bp    = total ? (uint32_t)((uint64_t)stat_dup[i] * 10000 / total) : 0;
+
+      cliPrintf("%-10s %8d %8d  %3d.%02d\n", type_name[i], stat_sent[i], stat_dup[i], bp / 100, bp % 100);
+    }
+    cliPrintf("flush      : %d (transport switch)\n", stat_flush);
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "clear"))
+  {
+    memset(stat_sent, 0, sizeof(stat_sent));
+    memset(stat_dup, 0, sizeof(stat_dup));
+    stat_flush = 0;
+    ret = true;
+  }
+
+  if (ret == false)
+  {
+    cliPrintf("host info\n");
+    cliPrintf("host clear\n");
+  }
+}
+#endif
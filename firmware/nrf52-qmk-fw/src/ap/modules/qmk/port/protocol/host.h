@@ -10,9 +10,16 @@
 
 
 /* host driver */
+void           host_init(void);
 void           host_set_driver(host_driver_t *driver);
 host_driver_t *host_get_driver(void);
 
+// 활성 드라이버로 빈 키보드 리포트를 **중복 검사 없이** 보낸다(눌린 마우스 버튼도 푼다).
+// transport 전환 직전, 이전 드라이버가 활성일 때 부른다 — stuck key 방지.
+void           host_keyboard_flush(void);
+// 활성 드라이버가 리포트를 못 보냈다 — 기억한 마지막 리포트를 버려 다음 리포트가 꼭 나가게 한다.
+void           host_report_invalidate(void);
+
 
 /* host driver interface */
 uint8_t host_keyboard_leds(void);
@@ -0,0 +1,302 @@
+#include "rgb_batch.h"
+#include "quantum.h"
+
+#ifdef RGB_MATRIX_ENABLE
+#include "rgb_matrix.h"
+#include "led_tables.h"
+#include "lib8simd.h"
+#include "log.h"
+#include "micros.h"
+#include <zephyr/toolchain.h>
+#include <lib/lib8tion/lib8tion.h>
+
+// rgb_matrix.c 의 weak 함수(CIE 보정 여부를 키보드가 덮어쓸 수 있다). 헤더엔 선언이 없다.
+RGB rgb_matrix_hsv_to_rgb(HSV hsv);
+
+BUILD_ASSERT(sizeof(RGB) == 3, "RGB 가 packed 3바이트가 아니다");
+
+
+/*
+ * HSV -> RGB 커널 — color.c hsv_to_rgb_impl() 와 같은 정수식인데 색상환 구간의 switch 를 표 한 번으로
+ * 바꿨다. 구간이 정하는 건 "r/g/b 가 v, t, p, q 중 무엇을 갖나" 뿐이다.
+ * SIMD 로는 안 한다 — 레인마다 구간이 달라 4레인으로 묶어도 LED 16~42개에선 스칼라보다 안 빠르다.
+ * 대신 효과들이 흔히 만드는 "연속으로 같은 색"(단색, 같은 hue 띠)은 한 번만 변환한다.
+ */
+enum
+{
+  SEL_V,
+  SEL_T,
+  SEL_P,
+  SEL_Q,
+};
+
+static const uint8_t hsv_region_sel[7][3] = {
+  {SEL_V, SEL_T, SEL_P},
+  {SEL_Q, SEL_V, SEL_P},
+  {SEL_P, SEL_V, SEL_T},
+  {SEL_P, SEL_Q, SEL_V},
+  {SEL_T, SEL_P, SEL_V},
+  {SEL_V, SEL_P, SEL_Q},
+  {SEL_V, SEL_T, SEL_P},   // h = 255 — 0 구간과 같다
+};
+
+static RGB hsv_to_rgb_one(HSV hsv)
+{
+  uint16_t v = MIN(hsv.v, RGB_MATRIX_MAXIMUM_BRIGHTNESS);
+  uint16_t s = hsv.s;
+  RGB      rgb;
+
+#ifdef USE_CIE1931_CURVE
+  v = pgm_read_byte(&CIE1931_CURVE[v]);
+#endif
+
+  if (s == 0)
+  {
+    rgb.r = rgb.g = rgb.b = v;
+    return rgb;
+  }
+
+  uint8_t region    = hsv.h * 6 / 255;
+  uint8_t remainder = (hsv.h * 2 - region * 85) * 3;
+  uint8_t sel[4];
+
+  sel[SEL_V] = v;
+  sel[SEL_P] = (v * (255 - s)) >> 8;
+  sel[SEL_Q] = (v * (255 - ((s * remainder) >> 8))) >> 8;
+  sel[SEL_T] = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+  const uint8_t *p_sel = hsv_region_sel[region];
+
+  rgb.r = sel[p_sel[0]];
+  rgb.g = sel[p_sel[1]];
+  rgb.b = sel[p_sel[2]];
+  return rgb;
+}
+
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (i > 0 && hsv[i].h == hsv[i - 1].h && hsv[i].s == hsv[i - 1].s && hsv[i].v == hsv[i - 1].v)
+    {
+      rgb[i] = rgb[i - 1];
+    }
+    else
+    {
+      rgb[i] = hsv_to_rgb_one(hsv[i]);
+    }
+  }
+}
+
+void scale_buffer(RGB *rgb, uint32_t count, uint8_t scale)
+{
+  scale8_buffer((uint8_t *)rgb, count * sizeof(RGB), scale);
+}
+
+
+/*
+ * 골든 비교 — 같은 입력을 스칼라(lib8tion scale8/qadd8/qsub8/blend8, rgb_matrix_hsv_to_rgb)와
+ * 커널에 넣어 바이트 단위로 맞춘다. 보드(CLI `rgb simd`)와 native_sim(`--rgb-golden`)에서 같은 코드가 돈다.
+ * 길이 67 은 워드(4) 로 안 떨어지게 골랐다 — 스칼라 꼬리까지 탄다.
+ *  - scale8 : 모든 (값, scale) 65536 조합
+ *  - HSV    : 모든 (h, s) x V 7개(상한 앞뒤 포함) — 기대값은 V 를 상한으로 자른 rgb_matrix_hsv_to_rgb
+ *  - 나머지 : 난수 입력 256 회 x 67바이트(HSV 는 같은 색이 이어지는 프레임)
+ * 시간은 42 LED(wish40) 한 프레임 = 126B 를 스칼라 루프와 커널로 각각 256 회.
+ */
+#define SELFTEST_LEN    67
+#define BENCH_LEN       126
+#define BENCH_LED       (BENCH_LEN / 3)
+#define BENCH_LOOP      256
+
+static uint32_t hsv_selftest(void)
+{
+  static const uint8_t v_tbl[] = {0, 1, 64, RGB_MATRIX_MAXIMUM_BRIGHTNESS - 1, RGB_MATRIX_MAXIMUM_BRIGHTNESS, 200, 255};
+  static HSV           hsv[256];
+  static RGB           rgb[256];
+  uint32_t             err = 0;
+
+  for (uint32_t n = 0; n < ARRAY_SIZE(v_tbl); n++)
+  {
+    for (uint32_t s = 0; s < 256; s++)
+    {
+      for (uint32_t h = 0; h < 256; h++)
+      {
+        hsv[h] = (HSV){.h = h, .s = s, .v = v_tbl[n]};
+      }
+      hsv_to_rgb_batch(hsv, rgb, 256);
+      for (uint32_t h = 0; h < 256; h++)
+      {
+        HSV capped = {.h = h, .s = s, .v = MIN(v_tbl[n], RGB_MATRIX_MAXIMUM_BRIGHTNESS)};
+        RGB ref    = rgb_matrix_hsv_to_rgb(capped);
+
+        err += (rgb[h].r != ref.r || rgb[h].g != ref.g || rgb[h].b != ref.b);
+      }
+    }
+  }
+  return err;
+}
+
+uint32_t rgb_batch_selftest(void)
+{
+  uint8_t  a[SELFTEST_LEN];
+  uint8_t  b[SELFTEST_LEN];
+  uint8_t  c[SELFTEST_LEN];
+  HSV      hsv[SELFTEST_LEN];
+  RGB      rgb[SELFTEST_LEN];
+  uint32_t err = hsv_selftest();
+
+  for (uint32_t s = 0; s < 256; s++)
+  {
+    for (uint32_t v = 0; v < 256; v += SELFTEST_LEN)
+    {
+      for (int i = 0; i < SELFTEST_LEN; i++)
+      {
+        a[i] = v + i;
+      }
+      memcpy(c, a, sizeof(a));
+      scale8_buffer(a, SELFTEST_LEN, s);
+      for (int i = 0; i < SELFTEST_LEN; i++)
+      {
+        err += (a[i] != scale8(c[i], s));
+      }
+    }
+  }
+
+  for (int n = 0; n < 256; n++)
+  {
+    uint8_t  amount = random8();
+    uint32_t sum    = 0;
+    uint8_t  dmax   = 0;
+
+    for (int i = 0; i < SELFTEST_LEN; i++)
+    {
+      c[i] = random8();
+      b[i] = random8();
+      sum += c[i];
+      dmax = MAX(dmax, abs(c[i] - b[i]));
+    }
+
+    memcpy(a, c, sizeof(a));
+    qadd8_buffer(a, b, SELFTEST_LEN);
+    for (int i = 0; i < SELFTEST_LEN; i++)
+    {
+      err += (a[i] != qadd8(c[i], b[i]));
+    }
+
+    memcpy(a, c, sizeof(a));
+    qsub8_buffer(a, b, SELFTEST_LEN);
+    for (int i = 0; i < SELFTEST_LEN; i++)
+    {
+      err += (a[i] != qsub8(c[i], b[i]));
+    }
+
+    memcpy(a, c, sizeof(a));
+    blend8_buffer(a, b, SELFTEST_LEN, amount);
+    for (int i = 0; i < SELFTEST_LEN; i++)
+    {
+      err += (a[i] != blend8(c[i], b[i], amount));
+    }
+
+    err += (sum8_buffer(c, SELFTEST_LEN) != sum);
+    err += (absdiff8_max(c, b, SELFTEST_LEN) != dmax);
+
+    // packed RGB 로 본 같은 바이트 — 픽셀의 세 채널에 scale8 (67B 중 앞 66B = 22 픽셀)
+    memcpy(rgb, c, SELFTEST_LEN / 3 * sizeof(RGB));
+    scale_buffer(rgb, SELFTEST_LEN / 3, amount);
+    for (int i = 0; i < SELFTEST_LEN / 3 * 3; i++)
+    {
+      err += (((const uint8_t *)rgb)[i] != scale8(c[i], amount));
+    }
+
+    // 같은 색이 이어지는 구간이 섞인 프레임 — 이어진 칸은 앞 칸을 복사하는 길을 탄다
+    for (int i = 0; i < SELFTEST_LEN; i++)
+    {
+      hsv[i] = (i > 0 && (random8() & 3)) ? hsv[i - 1] : (HSV){.h = random8(), .s = random8(), .v = random8()};
+    }
+    hsv_to_rgb_batch(hsv, rgb, SELFTEST_LEN);
+    for (int i = 0; i < SELFTEST_LEN; i++)
+    {
+      HSV capped = hsv[i];
+      RGB ref;
+
+      capped.v = MIN(capped.v, RGB_MATRIX_MAXIMUM_BRIGHTNESS);
+      ref      = rgb_matrix_hsv_to_rgb(capped);
+      err += (rgb[i].r != ref.r || rgb[i].g != ref.g || rgb[i].b != ref.b);
+    }
+  }
+
+  // 시간 — 같은 126B 프레임을 스칼라 / 커널로
+  static uint8_t frame[BENCH_LEN];
+  uint32_t       pre;
+  uint32_t       t_scalar;
+  uint32_t       t_simd;
+
+  memset(frame, 0xFF, sizeof(frame));
+  pre = micros();
+  for (int n = 0; n < BENCH_LOOP; n++)
+  {
+    for (int i = 0; i < BENCH_LEN; i++)
+    {
+      frame[i] = scale8(frame[i], 255);
+    }
+  }
+  t_scalar = micros() - pre;
+
+  memset(frame, 0xFF, sizeof(frame));
+  pre = micros();
+  for (int n = 0; n < BENCH_LOOP; n++)
+  {
+    scale8_buffer(frame, BENCH_LEN, 255);
+  }
+  t_simd = micros() - pre;
+
+  // HSV -> RGB 한 프레임 — 그라데이션(LED 마다 다른 색, 러너의 흔한 경우)을 LED 마다 / 배치로
+  static HSV     frame_hsv[BENCH_LED];
+  static RGB     frame_rgb[BENCH_LED];
+  uint32_t       t_hsv_scalar;
+  uint32_t       t_hsv_batch;
+
+  for (int i = 0; i < BENCH_LED; i++)
+  {
+    frame_hsv[i] = (HSV){.h = i * 6, .s = 255, .v = RGB_MATRIX_MAXIMUM_BRIGHTNESS};
+  }
+  pre = micros();
+  for (int n = 0; n < BENCH_LOOP; n++)
+  {
+    for (int i = 0; i < BENCH_LED; i++)
+    {
+      frame_rgb[i] = rgb_matrix_hsv_to_rgb(frame_hsv[i]);
+    }
+  }
+  t_hsv_scalar = micros() - pre;
+
+  pre = micros();
+  for (int n = 0; n < BENCH_LOOP; n++)
+  {
+    hsv_to_rgb_batch(frame_hsv, frame_rgb, BENCH_LED);
+  }
+  t_hsv_batch = micros() - pre;
+
+  logPrintf("[%s] lib8simd selftest, mismatch %d\n", err == 0 ? "OK" : "E_", err);
+  logPrintf("     scale8 %dB x %d : scalar %d us, batch %d us\n", BENCH_LEN, BENCH_LOOP, t_scalar, t_simd);
+  logPrintf("     hsv %d LED x %d  : scalar %d us, batch %d us (V cap %d)\n", BENCH_LED, BENCH_LOOP, t_hsv_scalar,
+            t_hsv_batch, RGB_MATRIX_MAXIMUM_BRIGHTNESS);
+  return err;
+}
+
+#else
+
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint32_t count)
+{
+}
+
+void scale_buffer(RGB *rgb, uint32_t count, uint8_t scale)
+{
+}
+
+uint32_t rgb_batch_selftest(void)
+{
+  return 0;
+}
+
+#endif
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "color.h"
+
+/*
+ * RGB 프레임 단위 배치 연산 — rgb_matrix 쪽에서 쓰는 얇은 층.
+ *
+ * 바이트 커널은 common/core/lib8simd.c(SIMD32)에 있고, ws2812.c(전송 스케일 scale8_buffer, 프레임 차분
+ * absdiff8_max, 합 sum8_buffer)와 rgb_reactive.c 가 직접 쓴다. 여기는 QMK 타입(HSV/RGB)을 받는 것과,
+ * 커널이 스칼라와 같은 값을 내는지 보는 자가검증(CLI `rgb simd`, native_sim `--rgb-golden`)을 둔다 —
+ * lib8tion/color.c 가 QMK 쪽이라 common/core 에 못 둔다.
+ */
+
+/*
+ * rgb[i] = rgb_matrix_hsv_to_rgb(hsv[i]) — 단 V 는 RGB_MATRIX_MAXIMUM_BRIGHTNESS 로 자른다.
+ *
+ * 밝기 상한은 순정에선 rgb_matrix_sethsv 에서만 걸린다. EEPROM 에서 읽은 V(상한을 낮춘 펌웨어로 올렸거나
+ * 벌크 EEPROM 쓰기로 들어온 값)는 안 잘리고 효과가 그대로 쓴다. 프레임을 이 함수로 변환하는 러너
+ * (port/rgb_matrix/rgb_matrix_wrapper.c)는 그 경우에도 상한을 넘지 않는다. 상한 아래에선 순정과 같은 값이다.
+ * 보드가 weak rgb_matrix_hsv_to_rgb() 를 덮어쓰면 이 커널과 어긋난다 — 지금 덮어쓰는 보드는 없다.
+ */
+void     hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint32_t count);
+
+// 모든 채널에 scale8 — 픽셀마다 r, g, b 에 scale8 을 부른 것과 같다(FastLED 의 nscale8x3).
+void     scale_buffer(RGB *rgb, uint32_t count, uint8_t scale);
+
+// 커널 vs 스칼라(lib8tion, color.c) 비교. 불일치 수를 돌려준다(0 = 통과). 결과/시간은 로그로.
+uint32_t rgb_batch_selftest(void);
@@ -0,0 +1,236 @@
+#include "rgb_governor.h"
+#include "quantum.h"
+
+#if defined(RGB_MATRIX_ENABLE) && defined(_USE_HW_WS2812)
+#include "rgb_matrix.h"
+#include "ws2812.h"
+#include "battery.h"
+#include "usb.h"
+#include "cli.h"
+#include "rgb_batch.h"
+#include "rgb_limiter.h"
+#include "rgb_indicator.h"
+#include "rgb_matrix/rgb_geom.h"
+#include "rgb_matrix/rgb_reactive.h"
+
+#if CLI_USE(HW_RGB)
+static void cliRgb(cli_args_t *args);
+#endif
+
+/*
+ * 하한(가장 빠른 프레임 주기).
+ *  - USB 전원: 16ms(60fps) — QMK 기본 RGB_MATRIX_LED_FLUSH_LIMIT 과 같다.
+ *  - 배터리: 33ms(30fps). 무선 연결만 보면 USB 로 충전하며 BLE 를 쓰는 경우까지 깎으므로 VBUS 를 본다.
+ *  - 배터리 잔량 부족: 66ms(15fps). 이때는 매끄러움보다 남은 시간이 중요하다.
+ * 상한 100ms 는 느린 효과가 "끊겨 보이지" 않는 선이다 — 변화량 피드백이 알아서 그 아래로 끌어내린다.
+ */
+#define GOV_MIN_MS_USB        16
+#define GOV_MIN_MS_BATTERY    33
+#define GOV_MIN_MS_LOW_BAT    66
+#define GOV_MAX_MS            100
+#define GOV_LOW_BAT_PERCENT   20
+
+/*
+ * 변화량 피드백 — 나간 프레임에서 채널 값이 최대 얼마나 움직였나(0~255).
+ *  - LOW 이하: 눈에 안 띄는 변화를 너무 자주 보낸다 -> 주기 2배
+ *  - HIGH 이상: 계단이 보인다 -> 주기 절반
+ * 둘의 비(3)가 2배보다 커야 늘린 직후 바로 줄이는 진동이 없다.
+ */
+#define GOV_DELTA_LOW         2
+#define GOV_DELTA_HIGH        6
+
+// 키 입력 직후엔 하한으로 — reactive/splash 효과는 입력에 바로 반응해야 한다(루프도 어차피 깨어 있다).
+#define GOV_INPUT_HOLD_MS     1000
+
+static uint32_t frame_ms    = GOV_MIN_MS_USB;
+static uint32_t floor_ms    = GOV_MIN_MS_USB;
+static uint8_t  last_mode   = 0xFF;
+static uint8_t  last_speed  = 0xFF;
+static uint32_t last_frames = 0;
+static uint32_t stat_up;     // 주기를 늘린 횟수
+static uint32_t stat_down;   // 주기를 줄인 횟수
+
+
+void rgb_governor_init(void)
+{
+#if CLI_USE(HW_RGB)
+  cliAdd("rgb", cliRgb);
+#endif
+}
+
+static uint32_t gov_floor_ms(void)
+{
+  uint8_t pct;
+
+  if (usbIsVbusPresent())
+  {
+    return GOV_MIN_MS_USB;
+  }
+  if (batteryGetPercent(&pct) && pct < GOV_LOW_BAT_PERCENT)
+  {
+    return GOV_MIN_MS_LOW_BAT;
+  }
+  return GOV_MIN_MS_BATTERY;
+}
+
+/*
+ * 효과 속도로 잡는 시작값. 순정 효과는 대부분 g_rgb_timer 를 speed/4 ~ speed/8 로 스케일해서
+ * 8비트 위상을 돌린다 — 위상 한 칸이 지나가는 시간이 대략 4096/(speed+16) ms 다
+ * (speed 255 ≈ 15ms, 128 ≈ 28ms, 0 ≈ 256ms). 효과마다 위상→밝기 기울기가 달라 정확하진 않으므로
+ * 시작값으로만 쓰고, 나머지는 변화량 피드백이 맞춘다.
+ */
+static uint32_t gov_seed_ms(uint8_t speed)
+{
+  return 4096 / ((uint32_t)speed + 16);
+}
+
+static void gov_adapt(void)
+{
+  uint32_t frames = ws2812GetFrameCount();
+  uint8_t  mode   = rgb_matrix_get_mode();
+  uint8_t  speed  = rgb_matrix_get_speed();
+
+  floor_ms = gov_floor_ms();
+
+  if (mode != last_mode || speed != last_speed)
+  {
+    last_mode  = mode;
+    last_speed = speed;
+    frame_ms   = gov_seed_ms(speed);
+  }
+  else if (frames != last_frames && ws2812IsFrameDeltaValid())
+  {
+    uint8_t delta = ws2812GetFrameDelta();
+
+    if (delta <= GOV_DELTA_LOW)
+    {
+      frame_ms *= 2;
+      stat_up++;
+    }
+    else if (delta >= GOV_DELTA_HIGH)
+    {
+      frame_ms /= 2;
+      stat_down++;
+    }
+  }
+  last_frames = frames;
+
+  if (last_input_activity_elapsed() < GOV_INPUT_HOLD_MS)
+  {
+    frame_ms = floor_ms;
+  }
+  frame_ms = constrain(frame_ms, floor_ms, GOV_MAX_MS);
+}
+
+uint32_t rgb_governor_frame_ms(void)
+{
+  return frame_ms;
+}
+
+/*
+ * 프레임 시각이면 keyboard_task() 안의 rgb_matrix_task() 가 방금 SYNCING -> STARTING 으로 넘겼다.
+ * 나머지 3단계(START -> RENDER -> FLUSH)를 **이 회차에** 돌려 한 프레임을 끝낸다 —
+ * RGB_MATRIX_LED_PROCESS_LIMIT = LED_COUNT 라 RENDER 한 번이 프레임 전체다(config.h).
+ * g_rgb_timer 는 START 에서 갱신되므로 그 전까지 "경과 >= 주기" 가 유지된다.
+ * 프레임 시각이 아닐 때 더 부르면 SYNC 만 반복하므로 무해하지만, 안 부른다.
+ */
+void rgb_governor_task(void)
+{
+  // 레일이 올라오는 동안 flush 가 그려만 둔 첫 프레임 — 레일이 안정되면 여기서 내보낸다(ws2812.h).
+  if (ws2812IsPending())
+  {
+    ws2812Refresh();
+  }
+
+  if (sync_timer_elapsed32(g_rgb_timer) < frame_ms)
+  {
+    return;
+  }
+
+  rgb_reactive_update();   // 렌더 전에 — 러너가 이번 프레임에 그릴 LED 를 본다
+  for (int i = 0; i < 3; i++)
+  {
+    rgb_matrix_task();
+  }
+  gov_adapt();
+}
+
+uint32_t rgb_governor_wait_ms(void)
+{
+  uint32_t elapsed = sync_timer_elapsed32(g_rgb_timer);
+
+  return (elapsed >= frame_ms) ? 1 : (frame_ms - elapsed);
+}
+
+
+#if CLI_USE(HW_RGB)
+void cliRgb(cli_args_t *args)
+{
+  bool ret = false;
+
+  if (args->argc == 1 && args->isStr(0, "info"))
+  {
+    cliPrintf("enabled    : %s\n", rgb_matrix_is_enabled() ? "on" : "off");
+    cliPrintf("mode/speed : %d / %d\n", rgb_matrix_get_mode(), rgb_matrix_get_speed());
+    cliPrintf("frame      : %d ms (%d fps), floor %d ms, seed %d ms\n",
+              frame_ms, 1000 / frame_ms, floor_ms, gov_seed_ms(rgb_matrix_get_speed()));
+    if (ws2812IsFrameDeltaValid())
+    {
+      cliPrintf("last delta : %d\n", ws2812GetFrameDelta());
+    }
+    else
+    {
+      cliPrintf("last delta : - (no previous frame)\n");
+    }
+    cliPrintf("reactive   : %d live, %s\n", rgb_reactive_get_live(), rgb_reactive_is_active() ? "active" : "idle");
+    cliPrintf("indicator  : %d LEDs%s\n", ws2812GetOverlayCount(),
+              (rgb_indicator_is_active() && !rgb_matrix_is_enabled()) ? " (rail only)" : "");
+    cliPrintf("adapt      : slower %d, faster %d\n", stat_up, stat_down);
+    cliPrintf("current    : %d mA, budget %d mA, scale %d/256\n",
+              rgb_limiter_get_estimate_ma(), rgb_limiter_get_budget_ma(), rgb_limiter_get_scale());
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "simd"))
+  {
+    rgb_batch_selftest();
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "geom"))
+  {
+    rgb_geom_bench();
+    ret = true;
+  }
+
+  if (ret == false)
+  {
+    cliPrintf("rgb info\n");
+    cliPrintf("rgb simd\n");
+    cliPrintf("rgb geom\n");
+  }
+}
+#endif
+
+#else
+
+// ws2812 가 없으면 변화량을 모른다 — 순정 동작(16ms 프레임, task 주기 폴링)으로 둔다.
+void rgb_governor_init(void)
+{
+}
+
+uint32_t rgb_governor_frame_ms(void)
+{
+  return 16;
+}
+
+void rgb_governor_task(void)
+{
+}
+
+uint32_t rgb_governor_wait_ms(void)
+{
+  return QMK_TASK_PERIOD_MS;
+}
+
+#endif
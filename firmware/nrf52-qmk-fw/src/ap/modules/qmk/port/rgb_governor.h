@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * RGB 프레임 주기 조절기.
+ *
+ * 순정 rgb_matrix 는 프레임 주기가 컴파일타임 RGB_MATRIX_LED_FLUSH_LIMIT(16ms) 고정이고, 한 프레임이
+ * rgb_matrix_task() 4회(START -> RENDER -> FLUSH -> SYNC)에 걸쳐 완성된다. 그래서 메인 루프가
+ * RGB 가 켜진 동안 2ms 마다 깨어나 rgb_task_sync() 를 폴링해야 했다.
+ *
+ * 여기서 바꾸는 것:
+ *  - 프레임 주기를 **런타임**에 정한다(port/rgb_matrix/rgb_matrix_wrapper.c 가 FLUSH_LIMIT 에 연결).
+ *    효과 속도로 시작값을 잡고, 실제로 나간 프레임의 변화량(ws2812GetFrameDelta)으로 늘리고 줄인다.
+ *    배터리(VBUS 없음)면 하한을 올리고, 잔량이 낮으면 더 올린다.
+ *  - 프레임 시각이 되면 한 번 깨어 **한 프레임을 끝까지** 돌린다(rgb_governor_task).
+ *  - 그 다음 프레임 시각까지 잔다(rgb_governor_wait_ms) — 폴링 없음.
+ */
+
+void     rgb_governor_init(void);
+
+// rgb_matrix_wrapper.c 의 RGB_MATRIX_LED_FLUSH_LIMIT. 지금 프레임 주기(ms).
+uint32_t rgb_governor_frame_ms(void);
+
+// qmkUpdate() 에서 keyboard_task() 뒤에 호출. 프레임 시각이면 그 프레임을 마저 렌더/flush 한다.
+void     rgb_governor_task(void);
+
+// qmkGetIdleWaitMs() 용. 다음 프레임까지 남은 ms(최소 1).
+uint32_t rgb_governor_wait_ms(void);
@@ -0,0 +1,106 @@
+#include "rgb_indicator.h"
+#include "quantum.h"
+
+#if defined(RGB_MATRIX_ENABLE) && defined(_USE_HW_WS2812) && \
+    (defined(RGB_INDICATOR_CAPS_LED) || defined(RGB_INDICATOR_LAYER_LEDS) || defined(RGB_INDICATOR_BLE_LEDS))
+#include "rgb_matrix.h"
+#include "ws2812.h"
+#include "host.h"
+#include "ble.h"
+#include "qmk/qmk.h"
+
+extern host_driver_t ble_driver;   // port/driver_ble.c
+
+#ifndef RGB_INDICATOR_CAPS_COLOR
+#define RGB_INDICATOR_CAPS_COLOR    WS2812_COLOR(48, 48, 48)
+#endif
+#ifndef RGB_INDICATOR_LAYER_COLOR
+#define RGB_INDICATOR_LAYER_COLOR   WS2812_COLOR( 0, 16, 64)
+#endif
+#ifndef RGB_INDICATOR_BLE_COLOR
+#define RGB_INDICATOR_BLE_COLOR     WS2812_COLOR( 0, 64,  0)
+#endif
+
+#ifdef RGB_INDICATOR_LAYER_LEDS
+static const uint8_t layer_leds[] = RGB_INDICATOR_LAYER_LEDS;
+#endif
+#ifdef RGB_INDICATOR_BLE_LEDS
+static const uint8_t ble_leds[]   = RGB_INDICATOR_BLE_LEDS;
+#endif
+
+
+static void ind_add(ws2812_overlay_t *list, uint8_t *cnt, uint8_t led, uint32_t color)
+{
+  if (led == NO_LED || *cnt >= WS2812_OVERLAY_MAX)
+  {
+    return;
+  }
+  list[*cnt].ch    = led;
+  list[*cnt].color = color;
+  (*cnt)++;
+}
+
+/*
+ * 매 회차 목록을 새로 만들고 ws2812SetOverlay() 가 이전과 비교한다 — 항목이 많아야 셋이라 캐시를
+ * 따로 두는 것보다 싸고, 소등(flush 가 오버레이를 지운다) 뒤에도 저절로 다시 맞춰진다.
+ * 같은 LED 가 두 번 나오면 나중 것이 이긴다(레이어 > Caps).
+ */
+void rgb_indicator_task(void)
+{
+  ws2812_overlay_t list[WS2812_OVERLAY_MAX];
+  uint8_t          cnt = 0;
+
+  if (!qmkIsSuspended())
+  {
+#ifdef RGB_INDICATOR_CAPS_LED
+    if (host_keyboard_led_state().caps_lock)
+    {
+      ind_add(list, &cnt, RGB_INDICATOR_CAPS_LED, RGB_INDICATOR_CAPS_COLOR);
+    }
+#endif
+
+    uint8_t layer = get_highest_layer(layer_state | default_layer_state);
+
+#ifdef RGB_INDICATOR_LAYER_LEDS
+    if (layer < ARRAY_SIZE(layer_leds))
+    {
+      ind_add(list, &cnt, layer_leds[layer], RGB_INDICATOR_LAYER_COLOR);
+    }
+#endif
+#ifdef RGB_INDICATOR_BLE_LEDS
+    // 프로파일은 레이어를 올린 동안만 — 항상 켜 두면 BLE 로 쓰는 내내 레일이 켜진다.
+    uint8_t profile = bleProfileGetActive();
+
+    if (layer > get_highest_layer(default_layer_state) && host_get_driver() == &ble_driver &&
+        profile < ARRAY_SIZE(ble_leds))
+    {
+      ind_add(list, &cnt, ble_leds[profile], RGB_INDICATOR_BLE_COLOR);
+    }
+#else
+    (void)layer;
+#endif
+  }
+
+  if (ws2812SetOverlay(list, cnt))
+  {
+    rgb_matrix_driver.flush();   // 키보드 flush — 레일 판정, 그리고 오버레이까지 합친 프레임으로 전류 예산을 탄다
+  }
+}
+
+bool rgb_indicator_is_active(void)
+{
+  return ws2812GetOverlayCount() > 0;
+}
+
+#else
+
+void rgb_indicator_task(void)
+{
+}
+
+bool rgb_indicator_is_active(void)
+{
+  return false;
+}
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * RGB 인디케이터 — Caps Lock / 레이어 / BLE 프로파일을 RGB LED 몇 개로 보인다.
+ *
+ * rgb_matrix_indicators_advanced() 로 하면 효과가 **매 프레임** 인디케이터까지 그리고, 효과가 꺼져
+ * 있으면 아예 안 불린다(순정은 effect 0 이면 건너뛴다). 그래서 효과 렌더와 분리한다:
+ *  - 상태가 바뀔 때만 (LED, 색) 목록을 다시 만들어 ws2812 오버레이로 넘긴다(ws2812SetOverlay).
+ *  - 합치는 건 전송 직전 복사본에서 한다 — 효과가 그린 버퍼는 그대로다.
+ *  - 목록이 바뀐 회차에 flush 를 한 번 부른다. 효과가 꺼져 있으면 그게 유일한 전송이다 —
+ *    레일만 켜 두고 프레임 웨이크는 없다(qmkGetIdleWaitMs 는 효과가 켜져 있을 때만 깨운다).
+ *
+ * 어떤 LED 를 쓸지는 보드 config.h 가 정한다(없으면 이 모듈은 아무것도 안 한다):
+ *   RGB_INDICATOR_CAPS_LED     Caps Lock
+ *   RGB_INDICATOR_LAYER_LEDS   { 레이어 0, 1, ... } — 가장 높은 레이어 하나. NO_LED = 표시 안 함
+ *   RGB_INDICATOR_BLE_LEDS     { 프로파일 0, 1, ... } — 레이어가 올라가 있고 BLE 로 보낼 때만
+ * 색은 RGB_INDICATOR_*_COLOR(WS2812_COLOR). 전류 예산(rgb_limiter)은 효과와 같이 받는다 — 오버레이도
+ * 채널 합에 들어가고 같은 스케일로 줄어든다. 예산이 빠듯하면 인디케이터도 어두워지니 색은 낮게 잡을 것.
+ *
+ * [전력] 효과가 꺼진 채 인디케이터만 켜져 있어도 **레일 전체**가 켜진다 — 네오픽셀 대기 전류가
+ * LED 당 ~0.45mA 라 GPIO Caps LED(≈1.2mA)보다 훨씬 비싸다. caps_led 가 있는 보드는 그대로 쓰고,
+ * 없는 보드(wish40)에서 쓴다.
+ */
+
+// qmkUpdate() 에서 매 회차, rgb_governor_task() 뒤에. 상태가 같으면 비교만 하고 돌아온다.
+void rgb_indicator_task(void);
+
+// 오버레이에 켜진 LED 가 있나 — 키보드 flush 가 레일을 켜 둘지 판정한다.
+bool rgb_indicator_is_active(void);
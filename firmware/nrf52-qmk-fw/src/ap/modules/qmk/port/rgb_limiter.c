@@ -0,0 +1,98 @@
+#include "rgb_limiter.h"
+#include "quantum.h"
+
+#if defined(RGB_MATRIX_ENABLE) && defined(_USE_HW_WS2812)
+#include "ws2812.h"
+#include "usb.h"
+
+/*
+ * 보드 config.h 가 정한다. 없으면 WS2812B 데이터시트 값:
+ *   채널당 최대 ~20mA(255) → 20000 / 255 ≈ 78µA/step
+ *   검은색 대기 ~0.45mA/LED (§6.10 실측 16개 7.12mA)
+ */
+#ifndef RGB_LIMIT_UA_PER_STEP
+#define RGB_LIMIT_UA_PER_STEP       78
+#endif
+#ifndef RGB_LIMIT_IDLE_UA_PER_LED
+#define RGB_LIMIT_IDLE_UA_PER_LED   450
+#endif
+
+static uint16_t budget_usb_ma = 0;
+static uint16_t budget_bat_ma = 0;
+static uint16_t budget_ma     = 0;
+static uint32_t estimate_ma   = 0;
+static uint16_t frame_scale   = WS2812_SCALE_FULL;
+
+
+void rgb_limiter_set_budget(uint16_t usb_ma, uint16_t bat_ma)
+{
+  budget_usb_ma = usb_ma;
+  budget_bat_ma = bat_ma;
+}
+
+/*
+ * 프레임마다 한 번(렌더 후, 전송 전). 합은 lib8simd 로 LED 42개여도 수십 사이클이다.
+ * 스케일 s 로 줄이면 동적 전류가 s/256 배가 되므로 (예산 - 대기) / 동적 에 맞춰 s 를 고른다 —
+ * 내림이라 줄인 뒤 추정은 항상 예산 이하다. 대기 전류만으로 예산을 넘으면 0(검정)이다.
+ */
+void rgb_limiter_apply(void)
+{
+  uint32_t sum     = ws2812GetChannelSum();
+  uint32_t dyn_ua  = sum * RGB_LIMIT_UA_PER_STEP;
+  uint32_t idle_ua = (uint32_t)RGB_MATRIX_LED_COUNT * RGB_LIMIT_IDLE_UA_PER_LED;
+
+  budget_ma   = usbIsVbusPresent() ? budget_usb_ma : budget_bat_ma;
+  estimate_ma = (dyn_ua + idle_ua) / 1000;
+  frame_scale = WS2812_SCALE_FULL;
+
+  if (budget_ma > 0 && dyn_ua > 0 && dyn_ua + idle_ua > (uint32_t)budget_ma * 1000)
+  {
+    uint32_t budget_ua = (uint32_t)budget_ma * 1000;
+    uint32_t avail_ua  = budget_ua > idle_ua ? budget_ua - idle_ua : 0;
+
+    frame_scale = (uint64_t)avail_ua * WS2812_SCALE_FULL / dyn_ua;
+  }
+  ws2812SetScale(frame_scale);
+}
+
+uint16_t rgb_limiter_get_budget_ma(void)
+{
+  return budget_ma;
+}
+
+uint32_t rgb_limiter_get_estimate_ma(void)
+{
+  return estimate_ma;
+}
+
+uint16_t rgb_limiter_get_scale(void)
+{
+  return frame_scale;
+}
+
+#else
+
+void rgb_limiter_apply(void)
+{
+}
+
+void rgb_limiter_set_budget(uint16_t usb_ma, uint16_t bat_ma)
+{
+}
+
+uint16_t rgb_limiter_get_budget_ma(void)
+{
+  return 0;
+}
+
+uint32_t rgb_limiter_get_estimate_ma(void)
+{
+  return 0;
+}
+
+uint16_t rgb_limiter_get_scale(void)
+{
+  return 256;
+}
+
+#endif
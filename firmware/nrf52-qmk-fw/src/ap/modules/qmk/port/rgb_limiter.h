@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * RGB 전류 예산 — 렌더와 전송 사이에서 프레임의 전류를 추정하고, 예산을 넘으면 프레임 전체를
+ * 같은 비율로 줄인다(색은 유지, 밝기만).
+ *
+ * RGB_MATRIX_MAXIMUM_BRIGHTNESS 는 **V 상한**이라 효과가 만든 색 조합을 모른다 — 같은 V 라도
+ * 단색 빨강과 흰색은 전류가 3배 차이고, V 를 안 거치는 효과(digital rain 등)는 상한도 안 받는다.
+ * 여기선 실제로 나갈 채널 값(효과 버퍼 + 인디케이터 오버레이)의 합으로 본다:
+ *   I ≈ Σ(r+g+b) × RGB_LIMIT_UA_PER_STEP + LED 수 × RGB_LIMIT_IDLE_UA_PER_LED   (보드 config.h)
+ *
+ * 예산은 USB(VBUS 있음) / 배터리 두 가지이고 VIA(POWER 채널, port/via/power_cfg.c)에서 바꾼다.
+ * 0 = 제한 없음. 추정값은 CLI `rgb info` 와 VIA get(id_qmk_power_rgb_current) 로 본다.
+ */
+
+// 키보드 rgb_matrix_drivers.c 의 flush 가 ws2812Refresh() 직전에 부른다.
+void     rgb_limiter_apply(void);
+
+void     rgb_limiter_set_budget(uint16_t usb_ma, uint16_t bat_ma);
+uint16_t rgb_limiter_get_budget_ma(void);     // 지금 적용 중인 예산(0 = 제한 없음)
+uint32_t rgb_limiter_get_estimate_ma(void);   // 마지막 프레임 추정(줄이기 전)
+uint16_t rgb_limiter_get_scale(void);         // 마지막 프레임 스케일(256 = 안 줄임)
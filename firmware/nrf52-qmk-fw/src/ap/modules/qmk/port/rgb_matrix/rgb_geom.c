@@ -0,0 +1,34 @@
+#include "rgb_geom.h"
+
+// rgb_matrix.c 가 정의한다(RGB_MATRIX_CENTER 또는 {112, 32}). 헤더엔 선언이 없다.
+extern const led_point_t k_rgb_matrix_center;
+
+rgb_geom_t g_rgb_geom[RGB_MATRIX_LED_COUNT];
+uint8_t    g_rgb_geom_cur    = 0;
+bool       g_rgb_geom_bypass = false;
+
+static bool is_ready = false;
+
+
+void rgb_geom_update(void)
+{
+  for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++)
+  {
+    int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+    int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+
+    g_rgb_geom[i].dx    = dx;
+    g_rgb_geom[i].dy    = dy;
+    g_rgb_geom[i].dist  = sqrt16(dx * dx + dy * dy);
+    g_rgb_geom[i].angle = atan2_8(dy, dx);
+  }
+  is_ready = true;
+}
+
+void rgb_geom_prepare(void)
+{
+  if (!is_ready)
+  {
+    rgb_geom_update();
+  }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rgb_matrix.h"
+#include <lib/lib8tion/lib8tion.h>
+
+/*
+ * LED 별 극좌표 표 — 위치 기반 효과가 매 프레임 LED 마다 다시 하던 계산을 한 번만 한다.
+ *
+ * 순정 러너(effect_runner_dx_dy / _dx_dy_dist)는 프레임마다 LED 마다
+ *   dx, dy = point - center,  dist = sqrt16(dx^2 + dy^2)   (sqrt16 은 이분 탐색 ~8회)
+ * 를 하고, 효과 함수(PINWHEEL/SPIRAL 계열)는 거기에 atan2_8(dy, dx)(나눗셈)을 더 한다.
+ * 입력이 g_led_config.point 와 중심뿐이라 **값이 프레임 사이에 안 바뀐다.**
+ *
+ * port/rgb_matrix/rgb_matrix_wrapper.c 가 두 러너를 이 표를 읽는 버전으로 바꾸고, atan2_8 을
+ * rgb_geom_atan2_8() 로 돌린다. 효과 파일(vendored)은 그대로다.
+ */
+typedef struct
+{
+  int16_t dx;       // point.x - center.x
+  int16_t dy;       // point.y - center.y
+  uint8_t dist;     // sqrt16(dx^2 + dy^2)
+  uint8_t angle;    // atan2_8(dy, dx)
+} rgb_geom_t;
+
+extern rgb_geom_t g_rgb_geom[RGB_MATRIX_LED_COUNT];
+extern uint8_t    g_rgb_geom_cur;      // 러너가 지금 그리는 LED
+extern bool       g_rgb_geom_bypass;   // true 면 표를 안 본다(벤치의 "before")
+
+// g_led_config 에서 표를 만든다. 러너가 처음 돌 때 알아서 부른다 — 배치를 런타임에 바꿨으면 직접 다시 부른다.
+void rgb_geom_update(void);
+void rgb_geom_prepare(void);
+
+// CLI `rgb geom` — 위치 기반 효과의 프레임당 렌더 시간, 순정 러너 vs 표. (rgb_matrix_wrapper.c)
+void rgb_geom_bench(void);
+
+/*
+ * 효과 함수의 atan2_8(dy, dx) 자리. 러너가 g_rgb_geom_cur 를 세워 두므로 같은 (dx, dy) 면 표 값이다.
+ * 다르면(러너 밖에서 불렸거나 효과가 dx/dy 를 바꿔 넘긴 경우) 그냥 계산한다 — 어느 쪽이든 값은 같다.
+ */
+static inline uint8_t rgb_geom_atan2_8(int16_t dy, int16_t dx)
+{
+  const rgb_geom_t *p_geom = &g_rgb_geom[g_rgb_geom_cur];
+
+  if (!g_rgb_geom_bypass && p_geom->dx == dx && p_geom->dy == dy)
+  {
+    return p_geom->angle;
+  }
+  return atan2_8(dy, dx);
+}
@@ -0,0 +1,293 @@
+/*
+ * 순정 rgb_matrix.c 를 **감싸서** 컴파일한다 — 원본 한 줄도 안 고치고 두 가지를 바꾸기 위해서다.
+ * port/debounce/debounce_wrapper.c 와 같은 방식이다.
+ *
+ * 1) 프레임 주기를 런타임 값으로.
+ *    rgb_task_sync() 는 RGB_MATRIX_LED_FLUSH_LIMIT 매크로를 그대로 비교하고, rgb_matrix.h 는
+ *    #ifndef 로만 기본값(16)을 준다. include 전에 함수 호출로 정의해 두면 rgb_governor_frame_ms()
+ *    가 주기를 정한다(port/rgb_governor.h).
+ *
+ * 2) 위치 기반 효과의 좌표 계산을 표로(rgb_geom.h).
+ *    러너 두 개(effect_runner_dx_dy / _dx_dy_dist)를 **이름을 바꿔** 먼저 include 하고 같은 이름으로
+ *    표를 읽는 버전을 정의한다. 러너 헤더는 #pragma once 라 rgb_matrix.c 가 다시 include 해도
+ *    건너뛴다. 순정 러너는 *_vendor 로 남아 벤치(rgb_geom_bench)의 "before" 가 된다.
+ *    효과 함수 안의 atan2_8 은 매크로로 rgb_geom_atan2_8 에 돌린다 — lib8tion.h 를 먼저 들여와
+ *    원본 정의는 매크로에 안 걸린다.
+ *
+ * 3) 키 반응형 효과는 감쇠가 살아 있는 LED 만(rgb_reactive.h).
+ *    같은 방법으로 reactive / reactive_splash 러너를 바꾸고, 순정 process_rgb_matrix 는
+ *    *_vendor 로 이름을 바꿔 감쇠 버퍼에 먼저 넣은 뒤 부른다(keyboard.c 가 매트릭스 이벤트마다 부른다).
+ *
+ * 4) 위 러너들은 HSV -> RGB 를 프레임 끝에 한 번에(rgb_batch.h).
+ *    LED 마다 효과 함수의 HSV 만 모으고 hsv_to_rgb_batch() 로 변환한다 — 같은 색이 이어지면 한 번만
+ *    변환하고, 밝기 상한(RGB_MATRIX_MAXIMUM_BRIGHTNESS)이 EEPROM 에서 읽은 V 에도 걸린다.
+ *
+ * qmk/CMakeLists.txt 는 원본 대신 이 파일을 목록에 넣는다 — 둘 다 넣으면 전부 중복 정의된다.
+ * port/rgb_matrix/ 하위에 둔 이유도 debounce 와 같다(port/*.c glob 이 재귀가 아니다).
+ */
+#include "../rgb_governor.h"
+
+// rgb_matrix.h 보다 먼저여야 한다(아래 rgb_geom.h 가 그걸 include 한다).
+#define RGB_MATRIX_LED_FLUSH_LIMIT  rgb_governor_frame_ms()
+
+#include "rgb_geom.h"
+#include "rgb_reactive.h"
+#include "../rgb_batch.h"
+#include "log.h"
+#include "micros.h"
+
+// 순정 러너가 참조하는데 rgb_matrix.c 안에서 정의되는 것들 — 러너를 먼저 들이므로 선언만 앞에 둔다.
+extern const led_point_t k_rgb_matrix_center;
+RGB rgb_matrix_hsv_to_rgb(HSV hsv);
+
+// 한 프레임(이번 회차의 led_min..led_max)에서 그릴 LED 와 HSV. 러너 끝에서 batch_flush() 가 변환해 넘긴다.
+static HSV     batch_hsv[RGB_MATRIX_LED_COUNT];
+static RGB     batch_rgb[RGB_MATRIX_LED_COUNT];
+static uint8_t batch_led[RGB_MATRIX_LED_COUNT];
+static uint8_t batch_cnt = 0;
+
+static inline void batch_add(uint8_t led, HSV hsv)
+{
+  batch_led[batch_cnt] = led;
+  batch_hsv[batch_cnt] = hsv;
+  batch_cnt++;
+}
+
+static void batch_flush(void)
+{
+  hsv_to_rgb_batch(batch_hsv, batch_rgb, batch_cnt);
+  for (uint8_t n = 0; n < batch_cnt; n++)
+  {
+    rgb_matrix_set_color(batch_led[n], batch_rgb[n].r, batch_rgb[n].g, batch_rgb[n].b);
+  }
+  batch_cnt = 0;
+}
+
+#define effect_runner_dx_dy       effect_runner_dx_dy_vendor
+#define effect_runner_dx_dy_dist  effect_runner_dx_dy_dist_vendor
+#include "../../quantum/rgb_matrix/animations/runners/effect_runner_dx_dy.h"
+#include "../../quantum/rgb_matrix/animations/runners/effect_runner_dx_dy_dist.h"
+#undef effect_runner_dx_dy
+#undef effect_runner_dx_dy_dist
+
+bool effect_runner_dx_dy(effect_params_t *params, dx_dy_f effect_func)
+{
+  RGB_MATRIX_USE_LIMITS(led_min, led_max);
+  rgb_geom_prepare();
+
+  uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+
+  for (uint8_t i = led_min; i < led_max; i++)
+  {
+    RGB_MATRIX_TEST_LED_FLAGS();
+    g_rgb_geom_cur = i;
+
+    batch_add(i, effect_func(rgb_matrix_config.hsv, g_rgb_geom[i].dx, g_rgb_geom[i].dy, time));
+  }
+  batch_flush();
+  return rgb_matrix_check_finished_leds(led_max);
+}
+
+bool effect_runner_dx_dy_dist(effect_params_t *params, dx_dy_dist_f effect_func)
+{
+  RGB_MATRIX_USE_LIMITS(led_min, led_max);
+  rgb_geom_prepare();
+
+  uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+
+  for (uint8_t i = led_min; i < led_max; i++)
+  {
+    RGB_MATRIX_TEST_LED_FLAGS();
+    g_rgb_geom_cur = i;
+
+    batch_add(i, effect_func(rgb_matrix_config.hsv, g_rgb_geom[i].dx, g_rgb_geom[i].dy, g_rgb_geom[i].dist, time));
+  }
+  batch_flush();
+  return rgb_matrix_check_finished_leds(led_max);
+}
+
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+#define effect_runner_reactive         effect_runner_reactive_vendor
+#define effect_runner_reactive_splash  effect_runner_reactive_splash_vendor
+#include "../../quantum/rgb_matrix/animations/runners/effect_runner_reactive.h"
+#include "../../quantum/rgb_matrix/animations/runners/effect_runner_reactive_splash.h"
+#undef effect_runner_reactive
+#undef effect_runner_reactive_splash
+
+/*
+ * 순정과 같은 계산인데 감쇠가 살아 있던 LED 만 그린다. 나머지는 바탕색 그대로 스트립 버퍼에 남아 있다
+ * (다른 LED 를 그린다고 지워지지 않는다). 효과가 바뀌었거나 색/속도/플래그가 바뀌면 전부 그린다.
+ */
+bool effect_runner_reactive(effect_params_t *params, reactive_f effect_func)
+{
+  RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+  bool     full     = rgb_reactive_full_frame(params);
+  uint16_t max_tick = 65535 / qadd8(rgb_matrix_config.speed, 1);
+
+  for (uint8_t i = led_min; i < led_max; i++)
+  {
+    RGB_MATRIX_TEST_LED_FLAGS();
+    if (!full && !rgb_reactive_is_dirty(i))
+    {
+      continue;
+    }
+
+    uint16_t tick = max_tick;
+
+    for (int8_t j = g_last_hit_tracker.count - 1; j >= 0; j--)
+    {
+      if (g_last_hit_tracker.index[j] == i && g_last_hit_tracker.tick[j] < tick)
+      {
+        tick = g_last_hit_tracker.tick[j];
+        break;
+      }
+    }
+
+    uint16_t offset = scale16by8(tick, qadd8(rgb_matrix_config.speed, 1));
+
+    batch_add(i, effect_func(rgb_matrix_config.hsv, offset));
+  }
+  batch_flush();
+  return rgb_matrix_check_finished_leds(led_max);
+}
+
+// 파문은 히트 하나가 LED 전부에 걸친다 — LED 별로 고를 수 없어 "살아 있는 히트가 있나" 로만 거른다.
+// 그릴 때의 계산은 순정과 같다(변환만 배치).
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t *params, reactive_splash_f effect_func)
+{
+  RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+  if (!rgb_reactive_full_frame(params) && !rgb_reactive_any_dirty())
+  {
+    return rgb_matrix_check_finished_leds(led_max);
+  }
+
+  uint8_t count = g_last_hit_tracker.count;
+
+  for (uint8_t i = led_min; i < led_max; i++)
+  {
+    RGB_MATRIX_TEST_LED_FLAGS();
+
+    HSV hsv = rgb_matrix_config.hsv;
+
+    hsv.v = 0;
+    for (uint8_t j = start; j < count; j++)
+    {
+      int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+      int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+      uint8_t  dist = sqrt16(dx * dx + dy * dy);
+      uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+
+      hsv = effect_func(hsv, dx, dy, dist, tick);
+    }
+    hsv.v = scale8(hsv.v, rgb_matrix_config.hsv.v);
+    batch_add(i, hsv);
+  }
+  batch_flush();
+  return rgb_matrix_check_finished_leds(led_max);
+}
+#endif
+
+void process_rgb_matrix_vendor(uint8_t row, uint8_t col, bool pressed);
+
+#define atan2_8(dy, dx)     rgb_geom_atan2_8(dy, dx)
+#define process_rgb_matrix  process_rgb_matrix_vendor
+
+#include "../../quantum/rgb_matrix/rgb_matrix.c"
+
+#undef atan2_8
+#undef process_rgb_matrix
+
+void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed)
+{
+  rgb_reactive_hit(row, col, pressed);
+  process_rgb_matrix_vendor(row, col, pressed);
+}
+
+
+/*
+ * 프레임당 렌더 시간 — 같은 효과 함수를 순정 러너 / 표 러너로 각각 GEOM_BENCH_LOOP 프레임.
+ * hsv->rgb 와 set_color 까지 포함한 **한 프레임 전체**라 실제로 줄어드는 몫이 그대로 보인다.
+ * 스트립 버퍼를 덮어쓰지만 다음 프레임이 다시 그린다.
+ */
+#define GEOM_BENCH_LOOP   100
+
+static effect_params_t geom_bench_params = {.iter = 0, .flags = LED_FLAG_ALL, .init = false};
+
+static void geom_bench_print(const char *name, uint32_t t_before, uint32_t t_after)
+{
+  logPrintf("     %-18s : %4d -> %4d us / %d frames\n", name, t_before, t_after, GEOM_BENCH_LOOP);
+}
+
+static void geom_bench_dx_dy(const char *name, dx_dy_f effect_func)
+{
+  uint32_t pre;
+  uint32_t t_before;
+  uint32_t t_after;
+
+  g_rgb_geom_bypass = true;
+  pre = micros();
+  for (int n = 0; n < GEOM_BENCH_LOOP; n++)
+  {
+    effect_runner_dx_dy_vendor(&geom_bench_params, effect_func);
+  }
+  t_before = micros() - pre;
+  g_rgb_geom_bypass = false;
+
+  pre = micros();
+  for (int n = 0; n < GEOM_BENCH_LOOP; n++)
+  {
+    effect_runner_dx_dy(&geom_bench_params, effect_func);
+  }
+  t_after = micros() - pre;
+
+  geom_bench_print(name, t_before, t_after);
+}
+
+static void geom_bench_dx_dy_dist(const char *name, dx_dy_dist_f effect_func)
+{
+  uint32_t pre;
+  uint32_t t_before;
+  uint32_t t_after;
+
+  g_rgb_geom_bypass = true;
+  pre = micros();
+  for (int n = 0; n < GEOM_BENCH_LOOP; n++)
+  {
+    effect_runner_dx_dy_dist_vendor(&geom_bench_params, effect_func);
+  }
+  t_before = micros() - pre;
+  g_rgb_geom_bypass = false;
+
+  pre = micros();
+  for (int n = 0; n < GEOM_BENCH_LOOP; n++)
+  {
+    effect_runner_dx_dy_dist(&geom_bench_params, effect_func);
+  }
+  t_after = micros() - pre;
+
+  geom_bench_print(name, t_before, t_after);
+}
+
+void rgb_geom_bench(void)
+{
+  rgb_geom_prepare();
+  logPrintf("[  ] rgb geom bench, %d LEDs (vendor runner -> table)\n", RGB_MATRIX_LED_COUNT);
+
+#ifdef ENABLE_RGB_MATRIX_BAND_PINWHEEL_VAL
+  geom_bench_dx_dy("BAND_PINWHEEL_VAL", BAND_PINWHEEL_VAL_math);
+#endif
+#ifdef ENABLE_RGB_MATRIX_BAND_SPIRAL_VAL
+  geom_bench_dx_dy_dist("BAND_SPIRAL_VAL", BAND_SPIRAL_VAL_math);
+#endif
+#ifdef ENABLE_RGB_MATRIX_CYCLE_OUT_IN
+  geom_bench_dx_dy_dist("CYCLE_OUT_IN", CYCLE_OUT_IN_math);
+#endif
+#ifdef ENABLE_RGB_MATRIX_CYCLE_PINWHEEL
+  geom_bench_dx_dy("CYCLE_PINWHEEL", CYCLE_PINWHEEL_math);
+#endif
+#ifdef ENABLE_RGB_MATRIX_CYCLE_SPIRAL
+  geom_bench_dx_dy_dist("CYCLE_SPIRAL", CYCLE_SPIRAL_math);
+#endif
+}
@@ -0,0 +1,183 @@
+#include "rgb_reactive.h"
+#include "sync_timer.h"
+#include "lib8simd.h"
+#include <lib/lib8tion/lib8tion.h>
+
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+
+static uint8_t  decay[RGB_MATRIX_LED_COUNT];    // 255 = 방금 눌림, 0 = 식음
+static uint32_t hit_ms[RGB_MATRIX_LED_COUNT];   // 마지막 히트 시각(sync_timer)
+static bool     dirty[RGB_MATRIX_LED_COUNT];    // 이번 프레임에 다시 그린다
+static uint8_t  live_count = 0;
+static bool     any_dirty  = false;
+static uint64_t last_config;
+#if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
+static bool     heat_prev  = false;
+#endif
+
+
+void rgb_reactive_hit(uint8_t row, uint8_t col, bool pressed)
+{
+  uint8_t led[LED_HITS_TO_REMEMBER];
+  uint8_t led_count;
+
+#if defined(RGB_MATRIX_KEYRELEASES)
+  if (pressed)
+#else
+  if (!pressed)
+#endif
+  {
+    return;
+  }
+
+  led_count = rgb_matrix_map_row_column_to_led(row, col, led);
+  for (uint8_t i = 0; i < led_count; i++)
+  {
+    if (decay[led[i]] == 0)
+    {
+      live_count++;
+    }
+    decay[led[i]]  = 255;
+    hit_ms[led[i]] = sync_timer_read32();
+  }
+}
+
+/*
+ * 히트 하나를 효과가 그리는 시간(ms). 이보다 길게 잡는 건 괜찮다(몇 프레임 더 그릴 뿐),
+ * 짧으면 LED 가 중간 밝기로 멈춘다.
+ *  - effect_runner_reactive : tick < 65535 / (speed + 1) 인 히트만 본다(max_tick).
+ *  - SPLASH 계열 : 파문은 scale16by8(tick, speed + 1) - dist 가 255 를 넘으면 끝난다.
+ *    dist <= 255 라 tick 이 510 * 256 / (speed + 1) 이면 전부 끝난다. 트래커 tick 은 16비트라
+ *    65535ms 에서 어차피 빠진다.
+ */
+static uint32_t reactive_life_ms(void)
+{
+  uint32_t speed = qadd8(rgb_matrix_config.speed, 1);
+
+  switch (rgb_matrix_get_mode())
+  {
+#ifdef ENABLE_RGB_MATRIX_SPLASH
+    case RGB_MATRIX_SPLASH:
+#endif
+#ifdef ENABLE_RGB_MATRIX_MULTISPLASH
+    case RGB_MATRIX_MULTISPLASH:
+#endif
+#ifdef ENABLE_RGB_MATRIX_SOLID_SPLASH
+    case RGB_MATRIX_SOLID_SPLASH:
+#endif
+#ifdef ENABLE_RGB_MATRIX_SOLID_MULTISPLASH
+    case RGB_MATRIX_SOLID_MULTISPLASH:
+#endif
+      return MIN(510 * 256 / speed, UINT16_MAX);
+
+    default:
+      break;
+  }
+  return UINT16_MAX / speed;
+}
+
+void rgb_reactive_update(void)
+{
+  uint32_t life = reactive_life_ms();
+
+  live_count = 0;
+  any_dirty  = false;
+
+  for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++)
+  {
+    dirty[i] = decay[i] > 0;   // 살아 있던 LED 는 이번에 값이 바뀐다 — 0 이 되는 프레임도 한 번 그린다
+    if (decay[i] == 0)
+    {
+      continue;
+    }
+    any_dirty = true;
+
+    uint32_t elapsed = sync_timer_elapsed32(hit_ms[i]);
+
+    if (elapsed >= life)
+    {
+      decay[i] = 0;
+      continue;
+    }
+    decay[i] = 255 - (elapsed * 255 / life);   // elapsed < life 라 1 이상
+    live_count++;
+  }
+
+#if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
+  if (rgb_matrix_get_mode() == RGB_MATRIX_TYPING_HEATMAP)
+  {
+    bool heat = sum8_buffer(&g_rgb_frame_buffer[0][0], sizeof(g_rgb_frame_buffer)) > 0;
+
+    any_dirty = any_dirty || heat || heat_prev;   // 마지막 열이 빠진 프레임도 한 번 그린다
+    heat_prev = heat;
+  }
+#endif
+}
+
+bool rgb_reactive_full_frame(const effect_params_t *params)
+{
+  bool full = params->init || rgb_matrix_config.raw != last_config;
+
+  last_config = rgb_matrix_config.raw;
+#ifdef RGB_MATRIX_SOLID_REACTIVE_GRADIENT_MODE
+  full = true;   // 바탕색 색상이 시간에 따라 돈다 — 전부 바뀐다
+#endif
+  return full;
+}
+
+bool rgb_reactive_is_dirty(uint8_t led)
+{
+  return dirty[led];
+}
+
+bool rgb_reactive_any_dirty(void)
+{
+  return any_dirty;
+}
+
+bool rgb_reactive_is_active(void)
+{
+  return live_count > 0 || any_dirty;
+}
+
+uint8_t rgb_reactive_get_live(void)
+{
+  return live_count;
+}
+
+#else
+
+void rgb_reactive_hit(uint8_t row, uint8_t col, bool pressed)
+{
+}
+
+void rgb_reactive_update(void)
+{
+}
+
+bool rgb_reactive_full_frame(const effect_params_t *params)
+{
+  return true;
+}
+
+bool rgb_reactive_is_dirty(uint8_t led)
+{
+  return true;
+}
+
+bool rgb_reactive_any_dirty(void)
+{
+  return true;
+}
+
+bool rgb_reactive_is_active(void)
+{
+  return false;
+}
+
+uint8_t rgb_reactive_get_live(void)
+{
+  return 0;
+}
+
+#endif
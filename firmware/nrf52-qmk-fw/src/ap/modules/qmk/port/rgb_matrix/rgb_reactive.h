@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rgb_matrix.h"
+
+/*
+ * 키 반응형 효과의 감쇠 버퍼 — 키를 안 치는 동안 프레임을 안 그리고, 다 식으면 RGB 도 잔다.
+ *
+ * 순정 reactive 효과는 키 입력이 없어도 매 프레임 LED 전부를 그린다. LED 마다 g_last_hit_tracker 를
+ * 거꾸로 훑어(히트 최대 LED_HITS_TO_REMEMBER 개) 마지막 히트를 찾는다 — 42 LED x 히트 수. 그런데
+ * 대부분의 LED 는 대부분의 시간에 바탕색 그대로다.
+ *
+ * 여기서는 LED 마다 감쇠값(255 -> 0)을 따로 든다:
+ *  - keyboard.c 의 매트릭스 이벤트 경로(process_rgb_matrix)에서 눌린 키의 LED 를 255 로 세운다
+ *    (rgb_matrix_wrapper.c 가 순정 process_rgb_matrix 앞에 끼운다).
+ *  - 프레임마다(rgb_governor_task) 경과 시간으로 줄인다. 수명은 효과가 그 히트를 그리는 시간과 같게 잡는다.
+ *  - 러너는 감쇠가 살아 있던 LED 만 다시 그린다(dirty). 값 계산은 순정과 같다 — 고르는 것만 바뀐다.
+ *  - 살아 있는 감쇠가 없으면 qmkGetIdleWaitMs() 가 RGB 웨이크를 끈다(qmk_rgb_is_static).
+ *
+ * TYPING_HEATMAP 은 키별 열 값을 이미 g_rgb_frame_buffer 에 들고 있어 그걸 감쇠 버퍼로 본다 —
+ * 열이 남아 있는 동안은 순정대로 그리고, 다 식으면 잔다.
+ */
+
+// keyboard.c -> process_rgb_matrix 훅. 순정과 같이 KEYPRESSES 면 누를 때, KEYRELEASES 면 뗄 때.
+void rgb_reactive_hit(uint8_t row, uint8_t col, bool pressed);
+
+// 프레임 렌더 직전에 한 번(rgb_governor_task). 감쇠를 줄이고 이번 프레임에 그릴 LED 를 고른다.
+void rgb_reactive_update(void);
+
+// 러너용. full = 설정이 바뀌었거나 효과가 방금 바뀌어 전부 다시 그려야 한다.
+bool rgb_reactive_full_frame(const effect_params_t *params);
+bool rgb_reactive_is_dirty(uint8_t led);
+bool rgb_reactive_any_dirty(void);
+
+// 아직 움직이는 LED 가 있나 — false 면 다음 키 입력까지 프레임이 안 바뀐다.
+bool    rgb_reactive_is_active(void);
+uint8_t rgb_reactive_get_live(void);   // CLI `rgb info`
@@ -0,0 +1,83 @@
+/*
+ * 순정 process_tap_dance.c 를 **감싸서** 컴파일한다 — port/combo/process_combo_wrapper.c 와 같은 방식이다.
+ *
+ * 원본을 include 하므로 그 안의 static(active_td, last_tap_time, 판정 단계 함수)을 여기서 쓴다.
+ * 바꾸는 건 tap_dance_task()(항목별 term)와 process_tap_dance()(인덱스 검사) 둘이다(tap_dance_port.h).
+ * 탭/뗌 처리, 끼어든 키로 끝내기(preprocess_tap_dance), 리셋은 원본 그대로다.
+ *
+ * qmk/CMakeLists.txt 는 원본 대신 이 파일을 목록에 넣는다. port/tap_dance/ 하위에 둔 이유는 combo 와
+ * 같다(port/*.c glob 이 재귀가 아니다).
+ */
+#include "tap_dance_port.h"
+#include "quantum.h"   // process_tap_dance.h 의 원래 이름 선언을 먼저 — 아래 rename 은 원본 정의에만 걸린다
+
+#define tap_dance_task     tap_dance_task_vendor
+#define process_tap_dance  process_tap_dance_vendor
+#include "../../quantum/process_keycode/process_tap_dance.c"
+#undef tap_dance_task
+#undef process_tap_dance
+
+static uint16_t term_tbl[TAP_DANCE_PORT_MAX];   // 0 = TAPPING_TERM
+
+
+static uint16_t tap_dance_port_term(uint16_t keycode)
+{
+  uint16_t term = term_tbl[QK_TAP_DANCE_GET_INDEX(keycode)];
+
+  return (term != 0) ? term : GET_TAPPING_TERM(keycode, &(keyrecord_t){});
+}
+
+bool process_tap_dance(uint16_t keycode, keyrecord_t *record)
+{
+  if (IS_QK_TAP_DANCE(keycode) && QK_TAP_DANCE_GET_INDEX(keycode) >= TAP_DANCE_PORT_MAX)
+  {
+    return true;   // 표 밖 — 일반 키처럼 흘려보낸다(순정은 배열 밖을 읽는다)
+  }
+  return process_tap_dance_vendor(keycode, record);
+}
+
+void tap_dance_task(void)
+{
+  tap_dance_action_t *action;
+
+  if (!active_td || timer_elapsed(last_tap_time) <= tap_dance_port_term(active_td))
+  {
+    return;
+  }
+
+  action = &tap_dance_actions[QK_TAP_DANCE_GET_INDEX(active_td)];
+  if (!action->state.interrupted)
+  {
+    process_tap_dance_action_on_dance_finished(action);
+  }
+}
+
+uint32_t tap_dance_port_wait_ms(void)
+{
+  if (!active_td)
+  {
+    return 0;
+  }
+
+  uint16_t term    = tap_dance_port_term(active_td);
+  uint16_t elapsed = timer_elapsed(last_tap_time);
+
+  return (elapsed > term) ? 1 : (uint32_t)(term - elapsed) + 1;
+}
+
+void tap_dance_port_reset(void)
+{
+  if (active_td)
+  {
+    reset_tap_dance(&tap_dance_actions[QK_TAP_DANCE_GET_INDEX(active_td)].state);
+  }
+}
+
+void tap_dance_port_set_term(uint8_t index, uint16_t term_ms)
+{
+  if (index < TAP_DANCE_PORT_MAX)
+  {
+    tap_dance_port_reset();
+    term_tbl[index] = term_ms;
+  }
+}
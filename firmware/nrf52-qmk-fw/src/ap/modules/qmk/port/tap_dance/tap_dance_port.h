@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 탭댄스(quantum/process_keycode/process_tap_dance.c)의 **항목별 term + 데드라인 내보내기**.
+ *
+ * 탭댄스 표(tap_dance_actions[])는 키맵이 아니라 VIA 로 편집하는 동적 표다(port/via/dynamic_feature.c).
+ * process_tap_dance_wrapper.c 가 원본을 감싸 컴파일하고 둘만 바꾼다:
+ *  - tap_dance_task() : 판정 시각을 TAPPING_TERM 고정 대신 **항목별 term** 으로 본다(0 = TAPPING_TERM).
+ *    순정은 TAPPING_TERM_PER_KEY + get_tapping_term() 으로만 바꿀 수 있는데, 그러면 LT/MT 의 탭/홀드
+ *    판정(action_tapping.c)까지 같은 콜백을 탄다 — 탭댄스만 따로 두려고 여기서 읽는다.
+ *  - process_tap_dance() : 표 밖의 TD(n) 는 무시한다. 순정은 인덱스를 검사 없이 배열에 넣는다.
+ *
+ * 탭댄스도 판정이 **틱이 와야** 끝난다(마지막 탭을 떼고 나면 눌린 키가 없어 루프가 잔다) —
+ * tap_dance_port_wait_ms() 를 port/deadline 에 등록해 그 시각에 깨운다.
+ */
+
+#ifndef TAP_DANCE_PORT_MAX
+#define TAP_DANCE_PORT_MAX      16      // tap_dance_actions[] 크기 = TD(0) ~ TD(15)
+#endif
+
+// index 의 판정 term(ms). 0 = TAPPING_TERM. 진행 중이던 판정은 버린다.
+void     tap_dance_port_set_term(uint8_t index, uint16_t term_ms);
+void     tap_dance_port_reset(void);
+
+// 탭댄스 판정이 걸려 있으면 판정 시각까지 남은 ms(최소 1). 0 = 기다릴 판정 없음.
+uint32_t tap_dance_port_wait_ms(void);
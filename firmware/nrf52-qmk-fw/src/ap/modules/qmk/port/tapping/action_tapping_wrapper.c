@@ -0,0 +1,762 @@
+/*
+ * 순정 action_tapping.c 를 **감싸서** 컴파일하고, 그 위에 탭/홀드 리졸버를 얹는다(tapping_port.h).
+ * port/debounce/debounce_wrapper.c, port/layer/action_layer_wrapper.c 와 같은 방식이다.
+ *
+ * 원본을 include 하므로 그 안의 static(tapping_key)과 판정 매크로(WITHIN_TAPPING_TERM, IS_TAPPING_RECORD,
+ * TAP_GET_PERMISSIVE_HOLD, TAP_GET_HOLD_ON_OTHER_KEY_PRESS)를 여기서 그대로 쓴다. 원본의
+ * action_tapping_process() 는 _vendor 로 이름만 바꿔 남긴다 — CLI `tap resolver off` / native_sim
+ * `--tap-vendor` 로 같은 입력을 순정 엔진에 돌려 비교한다.
+ *
+ * qmk/CMakeLists.txt 는 원본 대신 이 파일을 목록에 넣는다 — 둘 다 넣으면 전부 중복 정의된다.
+ * port/tapping/ 하위에 둔 이유도 debounce 와 같다(port/*.c glob 이 재귀가 아니다).
+ */
+#include "tapping_port.h"
+#include "quantum.h"   // action_tapping.h 의 원래 이름 선언을 먼저 — 아래 rename 은 원본 정의에만 걸린다
+
+#define action_tapping_process  action_tapping_process_vendor
+#include "../../quantum/action_tapping.c"
+#undef action_tapping_process
+
+#include "cli.h"
+#include "micros.h"
+
+#ifndef NO_ACTION_TAPPING
+
+/*
+ * 리졸버를 못 쓰는 설정 — 순정 엔진만 돈다:
+ *  - AUTO_SHIFT + RETRO_SHIFT : 판정에 auto shift 상태가 끼어든다(MAYBE_RETRO_SHIFTING). 옮기지 않았다.
+ *  - ENCODER / DIP_SWITCH     : 매트릭스 밖 키(KEYLOC_*)가 생긴다. 키별 표(tap_slot)가 매트릭스만 덮는다.
+ * 지금 보드는 셋 다 안 켠다.
+ */
+#if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT)) || defined(ENCODER_ENABLE) || defined(DIP_SWITCH_ENABLE)
+#  define TAP_RESOLVER    0
+#else
+#  define TAP_RESOLVER    1
+#endif
+
+#if CLI_USE(HW_TAPPING)
+static void cliTap(cli_args_t *args);
+#endif
+
+static uint32_t stat_events   = 0;   // 틱이 아닌 이벤트(눌림/뗌)
+static uint32_t stat_buffered = 0;   // 판정을 기다리느라 큐에 들어간 이벤트
+static uint32_t stat_drained  = 0;   // 판정이 끝나 큐에서 빠진 레코드
+static uint32_t stat_peak     = 0;   // 큐 최대 깊이
+static uint32_t stat_replays  = 0;   // 큐 앞 레코드를 다시 판정한 횟수(상태가 바뀐 때만)
+static uint32_t stat_total_us = 0;
+static uint32_t stat_max_us   = 0;   // 이벤트 하나(그 뒤 큐 비우기 포함)의 최대 처리 시간
+
+static bool     resolver_on   = TAP_RESOLVER;
+
+
+#if TAP_RESOLVER
+/*
+ * 탭/홀드 리졸버 — 키별 상태 + 이벤트 큐.
+ *
+ * [판정 규칙은 순정과 같다] 판정 중인 탭 키는 QMK 처럼 한 번에 하나(tapping_key)이고, 상태는 그 레코드에서
+ * 읽는다: 없음 / 눌림·미정(tap 0) / 눌림·탭(tap > 0) / 뗌. 상태마다 이벤트 하나를 받아 "처리했다" 또는
+ * "큐에 넣어라" 를 돌려준다(tap_step). 가지와 조건은 원본 process_tapping() 을 상태별로 옮겨 적은 것이다 —
+ * 그래야 QMK 탭핑 테스트 벡터, 사용자가 익숙한 동작(롤오버, 홀드 중 다른 키)이 그대로 남는다.
+ *
+ * [원본과 다른 곳 — 비용만]
+ *  1) 큐를 훑지 않는다. 원본은 이벤트마다 waiting_buffer 를 처음부터 본다:
+ *       waiting_buffer_typed()   "이 키의 눌림이 큐에 있나"       -> 키별 눌림 수(press_cnt)
+ *       waiting_buffer_scan_tap() "새 탭 키의 뗌이 큐에 있나"     -> 키별 뗌 목록(rel_head, 큐 슬롯의 rel_next)
+ *     둘 다 넣고 뺄 때 O(1) 로 갱신한다. 뗌 목록은 그 키의 뗌만 잇는다(보통 0~1개).
+ *  2) 큐 앞 레코드를 매 틱 다시 판정하지 않는다. 원본은 판정이 안 끝난 레코드가 큐 앞에 남으면 **틱마다**
+ *     process_tapping() 을 다시 돌린다(틱당 한 번, 판정이 끝날 때까지). 그 결과는 tapping_key, 레이어 상태,
+ *     per-key 콜백 값, 그 키의 눌림이 큐에 있는지에만 달렸으므로(레코드 시각은 고정) 그게 그대로면 다시
+ *     돌리지 않는다(tap_snap_t).
+ *  3) 판정 시각 전의 틱은 상태를 안 본다. 틱이 상태를 바꾸는 건 눌림·미정/뗌 상태가 TAPPING_TERM 을
+ *     넘길 때뿐이다 — 그 시각(tapping_port_wait_ms)이 지났을 때만 tap_step 에 넣는다.
+ * 결과적으로 이벤트는 도착할 때 한 번 판정되고, 큐에 들어갔으면 **판정이 끝날 때 한 번** 다시 판정된다
+ * (끝난 판정이 큐 안의 다른 탭 키를 새로 시작시키면 그 판정이 끝날 때 또 한 번).
+ *
+ * 큐 크기·넘침 처리(전부 지우기)는 원본 waiting_buffer 와 같다(WAITING_BUFFER_SIZE - 1 개).
+ */
+#define TAP_QUEUE_SIZE    WAITING_BUFFER_SIZE
+#define TAP_SLOT_MAX      (MATRIX_ROWS * MATRIX_COLS)
+#define TAP_NONE          0xFF
+
+_Static_assert(TAP_QUEUE_SIZE < TAP_NONE, "queue index must fit in uint8_t");
+
+typedef enum
+{
+  TAP_IDLE = 0,     // 판정 중인 탭 키 없음
+  TAP_HELD,         // 눌림, tap 0 — 탭인지 홀드인지 미정
+  TAP_TAPPED,       // 눌림, tap > 0 — 탭으로 확정된 뒤 다시 눌림(연타/홀드 반복)
+  TAP_RELEASED,     // 뗌 — 다음 연타를 기다린다(TAPPING_TERM 까지)
+} tap_state_t;
+
+typedef struct
+{
+  keyrecord_t record;
+  uint8_t     rel_next;     // 같은 키의 다음 뗌(큐 슬롯)
+} tap_entry_t;
+
+typedef struct
+{
+  uint8_t press_cnt;        // 큐에 있는 이 키의 눌림 수
+  uint8_t rel_head;         // 큐에 있는 이 키의 뗌 — 오래된 것부터
+  uint8_t rel_tail;
+} tap_slot_t;
+
+// 큐 앞 레코드가 "큐에 남아라" 를 받은 때의 조건. 이게 그대로면 다시 판정해도 같은 답이다.
+typedef struct
+{
+  keyrecord_t   tapping_key;
+  layer_state_t layer_state;
+  layer_state_t default_layer_state;
+  bool          hold_okp;
+  bool          permissive;
+  bool          typed;        // 앞 레코드가 뗌이면 그 키의 눌림이 큐에 있나
+} tap_snap_t;
+
+static tap_entry_t tap_queue[TAP_QUEUE_SIZE];
+static uint8_t     tap_head = 0;
+static uint8_t     tap_tail = 0;
+static tap_slot_t  tap_slot_tbl[TAP_SLOT_MAX];
+static tap_snap_t  front_snap;
+static bool        front_snap_valid = false;
+
+
+static uint8_t tap_slot(keypos_t key)
+{
+  // 콤보 레코드는 키 위치가 (0,0) 이다 — 원본 KEYEQ 도 (0,0) 키와 같게 본다. 그대로 둔다.
+  return key.row * MATRIX_COLS + key.col;
+}
+
+static uint8_t tap_queue_depth(void)
+{
+  return (tap_head + TAP_QUEUE_SIZE - tap_tail) % TAP_QUEUE_SIZE;
+}
+
+static void tap_queue_clear(void)
+{
+  tap_head         = 0;
+  tap_tail         = 0;
+  front_snap_valid = false;
+  for (uint32_t i = 0; i < TAP_SLOT_MAX; i++)
+  {
+    tap_slot_tbl[i].press_cnt = 0;
+    tap_slot_tbl[i].rel_head  = TAP_NONE;
+    tap_slot_tbl[i].rel_tail  = TAP_NONE;
+  }
+}
+
+static bool tap_queue_put(const keyrecord_t *record)
+{
+  if (IS_NOEVENT(record->event))
+  {
+    return true;
+  }
+  if ((tap_head + 1) % TAP_QUEUE_SIZE == tap_tail)
+  {
+    return false;
+  }
+
+  tap_entry_t *entry = &tap_queue[tap_head];
+  tap_slot_t  *slot  = &tap_slot_tbl[tap_slot(record->event.key)];
+
+  entry->record   = *record;
+  entry->rel_next = TAP_NONE;
+  if (record->event.pressed)
+  {
+    slot->press_cnt++;
+  }
+  else
+  {
+    if (slot->rel_tail == TAP_NONE)
+    {
+      slot->rel_head = tap_head;
+    }
+    else
+    {
+      tap_queue[slot->rel_tail].rel_next = tap_head;
+    }
+    slot->rel_tail = tap_head;
+  }
+  tap_head = (tap_head + 1) % TAP_QUEUE_SIZE;
+  return true;
+}
+
+static void tap_queue_pop(void)
+{
+  tap_entry_t *entry = &tap_queue[tap_tail];
+  tap_slot_t  *slot  = &tap_slot_tbl[tap_slot(entry->record.event.key)];
+
+  if (entry->record.event.pressed)
+  {
+    slot->press_cnt--;
+  }
+  else
+  {
+    // 큐는 FIFO 라 맨 앞 뗌은 그 키 목록의 맨 앞이다.
+    slot->rel_head = entry->rel_next;
+    if (slot->rel_head == TAP_NONE)
+    {
+      slot->rel_tail = TAP_NONE;
+    }
+  }
+  tap_tail         = (tap_tail + 1) % TAP_QUEUE_SIZE;
+  front_snap_valid = false;
+}
+
+// waiting_buffer_typed() 자리 — 뗌 이벤트에만 묻는다: 이 키의 눌림이 큐에 있나.
+static bool tap_queued_press(keypos_t key)
+{
+  return tap_slot_tbl[tap_slot(key)].press_cnt > 0;
+}
+
+static tap_state_t tap_state(void)
+{
+  if (IS_NOEVENT(tapping_key.event))
+  {
+    return TAP_IDLE;
+  }
+  if (!tapping_key.event.pressed)
+  {
+    return TAP_RELEASED;
+  }
+  return (tapping_key.tap.count == 0) ? TAP_HELD : TAP_TAPPED;
+}
+
+/*
+ * waiting_buffer_scan_tap() 자리. 새 탭 키가 눌림·미정으로 시작할 때 그 키의 뗌이 이미 큐에 있고
+ * TAPPING_TERM 안이면 바로 탭으로 확정한다(큐에 든 롤오버 "A 누름, B 누름, A 뗌" 에서 A 가 탭이 되는 자리).
+ * 이 키의 뗌 목록만 본다.
+ */
+static void tap_scan(void)
+{
+  if (tapping_key.tap.count > 0 || !tapping_key.event.pressed)
+  {
+    return;
+  }
+
+  for (uint8_t i = tap_slot_tbl[tap_slot(tapping_key.event.key)].rel_head; i != TAP_NONE; i = tap_queue[i].rel_next)
+  {
+    keyrecord_t *candidate = &tap_queue[i].record;
+
+    if (KEYEQ(candidate->event.key, tapping_key.event.key) && WITHIN_TAPPING_TERM(candidate->event))
+    {
+      tapping_key.tap.count = 1;
+      candidate->tap.count  = 1;
+      process_record(&tapping_key);
+      return;
+    }
+  }
+}
+
+static void tap_reset(void)
+{
+  tapping_key = (keyrecord_t){0};
+}
+
+// 탭 연타 중 새 탭 키 — 2타 이상이었으면 앞 키를 떼고 새 키로 판정을 시작한다.
+static void tap_restart(keyrecord_t *keyp)
+{
+  if (tapping_key.tap.count > 1)
+  {
+    process_record(&(keyrecord_t){
+      .tap           = tapping_key.tap,
+      .event.key     = tapping_key.event.key,
+      .event.time    = keyp->event.time,
+      .event.pressed = false,
+      .event.type    = tapping_key.event.type,
+#ifdef COMBO_ENABLE
+      .keycode = tapping_key.keycode,
+#endif
+    });
+  }
+  tapping_key = *keyp;
+  tap_scan();
+}
+
+// 판정 전에 떼진 키(탭 키보다 먼저 눌렸던 키)의 뗌 — 수식키/레이어면 판정이 끝날 때까지 붙잡는다.
+static bool tap_hold_back_release(keyrecord_t *keyp)
+{
+  action_t action = layer_switch_get_action(keyp->event.key);
+
+  switch (action.kind.id)
+  {
+    case ACT_LMODS:
+    case ACT_RMODS:
+      if (action.key.mods && !action.key.code) return true;
+      if (IS_MODIFIER_KEYCODE(action.key.code)) return true;
+      break;
+    case ACT_LMODS_TAP:
+    case ACT_RMODS_TAP:
+      if (action.key.mods && keyp->tap.count == 0) return true;
+      if (IS_MODIFIER_KEYCODE(action.key.code)) return true;
+      break;
+    case ACT_LAYER_TAP:
+    case ACT_LAYER_TAP_EXT:
+      switch (action.layer_tap.code)
+      {
+        case 0 ...(OP_TAP_TOGGLE - 1):
+        case OP_ON_OFF:
+        case OP_OFF_ON:
+        case OP_SET_CLEAR:
+          return true;
+      }
+      break;
+  }
+  return false;
+}
+
+// 눌림·미정. TAPPING_TERM 안에서 탭 키를 떼면 탭, 넘기면 홀드, 다른 키는 설정에 따라 홀드를 앞당기거나 큐로.
+static bool tap_step_held(keyrecord_t *keyp)
+{
+  const keyevent_t event = keyp->event;
+#if defined(PERMISSIVE_HOLD_PER_KEY) || defined(HOLD_ON_OTHER_KEY_PRESS_PER_KEY)
+  TAP_DEFINE_KEYCODE;
+#endif
+
+  if (!WITHIN_TAPPING_TERM(event))
+  {
+    // 홀드 확정. 이 이벤트는 큐로 — 확정된 홀드 뒤에 순서대로 나간다.
+    process_record(&tapping_key);
+    tap_reset();
+    return false;
+  }
+  if (IS_NOEVENT(event))
+  {
+    return true;
+  }
+
+  if (IS_TAPPING_RECORD(keyp) && !event.pressed)
+  {
+    // 첫 탭. 누름을 탭으로 내보내고, 이 뗌은 큐 뒤에서 탭 뗌으로 나간다.
+    tapping_key.tap.count = 1;
+    process_record(&tapping_key);
+    keyp->tap = tapping_key.tap;
+    return false;
+  }
+  if (!event.pressed)
+  {
+    if (tap_queued_press(event.key))
+    {
+      // 탭 키를 누른 뒤 눌렀다 뗀 키 — permissive hold 면 홀드 확정.
+      if (TAP_GET_PERMISSIVE_HOLD)
+      {
+        process_record(&tapping_key);
+        tap_reset();
+      }
+      return false;
+    }
+    if (tap_hold_back_release(keyp))
+    {
+      return false;
+    }
+    process_record(keyp);
+    return true;
+  }
+
+  tapping_key.tap.interrupted = true;
+  if (TAP_GET_HOLD_ON_OTHER_KEY_PRESS)
+  {
+    process_record(&tapping_key);
+    tap_reset();
+  }
+  return false;
+}
+
+// 눌림·탭(연타 중). TAPPING_TERM 을 넘겨도 상태는 그대로고, 탭 키 뗌만 다르게 끝난다.
+static bool tap_step_tapped(keyrecord_t *keyp)
+{
+  const keyevent_t event  = keyp->event;
+  bool             within = WITHIN_TAPPING_TERM(event);
+
+  if (IS_NOEVENT(event))
+  {
+    return true;
+  }
+
+  if (IS_TAPPING_RECORD(keyp) && !event.pressed)
+  {
+    keyp->tap = tapping_key.tap;
+    process_record(keyp);
+    if (within)
+    {
+      tapping_key = *keyp;      // 뗌 상태로 — 다음 연타를 기다린다
+    }
+    else
+    {
+      tap_reset();
+    }
+    return true;
+  }
+  if (is_tap_record(keyp) && event.pressed)
+  {
+    tap_restart(keyp);
+    return true;
+  }
+
+  process_record(keyp);
+  return true;
+}
+
+// 뗌. TAPPING_TERM 안에 같은 키를 다시 누르면 연타, 넘기면 판정 끝.
+static bool tap_step_released(keyrecord_t *keyp)
+{
+  const keyevent_t event = keyp->event;
+
+  if (!WITHIN_TAPPING_TERM(event))
+  {
+    tap_reset();
+    return false;
+  }
+  if (IS_NOEVENT(event))
+  {
+    return true;
+  }
+
+  if (event.pressed && IS_TAPPING_RECORD(keyp))
+  {
+    if (WITHIN_QUICK_TAP_TERM(event) && !tapping_key.tap.interrupted && tapping_key.tap.count > 0)
+    {
+      keyp->tap = tapping_key.tap;
+      if (keyp->tap.count < 15)
+      {
+        keyp->tap.count += 1;
+      }
+      process_record(keyp);
+    }
+    tapping_key = *keyp;
+    return true;
+  }
+  if (event.pressed && is_tap_record(keyp))
+  {
+    tapping_key = *keyp;
+    tap_scan();
+    return true;
+  }
+
+  if (event.pressed)
+  {
+    tapping_key.tap.interrupted = true;
+  }
+  process_record(keyp);
+  return true;
+}
+
+// true = 처리했다(또는 버렸다), false = 큐에 넣어라(이미 큐 앞이면 그대로 둬라).
+static bool tap_step(keyrecord_t *keyp)
+{
+  switch (tap_state())
+  {
+    case TAP_IDLE:
+      if (IS_NOEVENT(keyp->event))
+      {
+        return true;
+      }
+      if (keyp->event.pressed && is_tap_record(keyp))
+      {
+        tapping_key = *keyp;
+        process_record_tap_hint(&tapping_key);
+        tap_scan();
+      }
+      else
+      {
+        process_record(keyp);
+      }
+      return true;
+
+    case TAP_HELD:
+      return tap_step_held(keyp);
+
+    case TAP_TAPPED:
+      return tap_step_tapped(keyp);
+
+    case TAP_RELEASED:
+      return tap_step_released(keyp);
+  }
+  return true;
+}
+
+static void tap_snap_take(tap_snap_t *snap, const keyrecord_t *front)
+{
+#if defined(PERMISSIVE_HOLD_PER_KEY) || defined(HOLD_ON_OTHER_KEY_PRESS_PER_KEY)
+  TAP_DEFINE_KEYCODE;
+#endif
+
+  memset(snap, 0, sizeof(tap_snap_t));
+  snap->tapping_key         = tapping_key;
+  snap->layer_state         = layer_state;
+  snap->default_layer_state = default_layer_state;
+  if (tap_state() == TAP_HELD)
+  {
+    snap->hold_okp   = TAP_GET_HOLD_ON_OTHER_KEY_PRESS;
+    snap->permissive = TAP_GET_PERMISSIVE_HOLD;
+  }
+  if (!front->event.pressed)
+  {
+    snap->typed = tap_queued_press(front->event.key);
+  }
+}
+
+/*
+ * 큐 앞부터 판정이 끝난 레코드를 내보낸다. 앞 레코드가 다시 "남아라" 면 멈춘다.
+ * "남아라" 가 상태를 바꾸지 않았을 때(판정 전후 조건이 같을 때)만 조건을 기억한다. 상태를 바꾼 "남아라"
+ * (TAPPING_TERM 이 지나 홀드 확정/리셋)는 원본처럼 다음 호출에서 다시 판정한다 — 다음 호출이 이벤트면
+ * 그 이벤트가 먼저 판정되는 순서까지 원본과 같다.
+ */
+static void tap_queue_drain(void)
+{
+  while (tap_tail != tap_head)
+  {
+    keyrecord_t *front = &tap_queue[tap_tail].record;
+    tap_snap_t   snap;
+
+    tap_snap_take(&snap, front);
+    if (front_snap_valid && memcmp(&snap, &front_snap, sizeof(tap_snap_t)) == 0)
+    {
+      return;   // 지난번에 남으라 한 조건 그대로 — 다시 판정해도 같다
+    }
+
+    stat_replays++;
+    if (!tap_step(front))
+    {
+      tap_snap_take(&front_snap, front);
+      front_snap_valid = (memcmp(&snap, &front_snap, sizeof(tap_snap_t)) == 0);
+      return;
+    }
+    tap_queue_pop();
+  }
+}
+
+// 틱이 상태를 바꾸는 시각이 지났나 — tapping_port_wait_ms() 와 같은 조건.
+static bool tap_tick_due(keyevent_t event)
+{
+  tap_state_t state = tap_state();
+
+  if (state != TAP_HELD && state != TAP_RELEASED)
+  {
+    return false;
+  }
+  return !WITHIN_TAPPING_TERM(event);
+}
+
+static void tap_resolver_process(keyrecord_t *record)
+{
+  if (IS_EVENT(record->event) || tap_tick_due(record->event))
+  {
+    if (!tap_step(record) && !tap_queue_put(record))
+    {
+      // 넘침 — 원본과 같이 전부 지운다.
+      clear_keyboard();
+      tap_queue_clear();
+      tap_reset();
+    }
+  }
+  tap_queue_drain();
+}
+
+static uint8_t tap_depth(void)
+{
+  if (resolver_on)
+  {
+    return tap_queue_depth();
+  }
+  return (waiting_buffer_head + WAITING_BUFFER_SIZE - waiting_buffer_tail) % WAITING_BUFFER_SIZE;
+}
+
+#else
+
+static uint8_t tap_depth(void)
+{
+  return (waiting_buffer_head + WAITING_BUFFER_SIZE - waiting_buffer_tail) % WAITING_BUFFER_SIZE;
+}
+
+#endif   // TAP_RESOLVER
+
+
+void tapping_port_init(void)
+{
+#if TAP_RESOLVER
+  tap_queue_clear();
+#endif
+#if CLI_USE(HW_TAPPING)
+  cliAdd("tap", cliTap);
+#endif
+}
+
+bool tapping_port_set_enable(bool enable)
+{
+#if TAP_RESOLVER
+  if (enable == resolver_on)
+  {
+    return true;
+  }
+  // 판정이 걸려 있으면 바꾸지 않는다 — 두 엔진이 tapping_key 는 같이 쓰지만 큐는 따로다.
+  if (!IS_NOEVENT(tapping_key.event) || tap_depth() != 0)
+  {
+    return false;
+  }
+  tap_queue_clear();
+  resolver_on = enable;
+  return true;
+#else
+  return !enable;
+#endif
+}
+
+bool tapping_port_is_enabled(void)
+{
+  return resolver_on;
+}
+
+void action_tapping_process(keyrecord_t record)
+{
+  uint8_t  depth_before = tap_depth();
+  uint32_t start        = micros();
+
+#if TAP_RESOLVER
+  if (resolver_on)
+  {
+    tap_resolver_process(&record);
+  }
+  else
+#endif
+  {
+    action_tapping_process_vendor(record);
+  }
+
+  uint32_t elapsed     = micros() - start;
+  uint8_t  depth_after = tap_depth();
+
+  if (depth_after > depth_before)
+  {
+    stat_buffered += depth_after - depth_before;
+  }
+  else
+  {
+    stat_drained += depth_before - depth_after;
+  }
+  if (depth_after > stat_peak)
+  {
+    stat_peak = depth_after;
+  }
+
+  // 틱은 매 회차라 시간 통계에 넣지 않는다 — 평균이 "아무것도 안 한 호출" 로 흐려진다.
+  if (IS_EVENT(record.event))
+  {
+    stat_events++;
+    stat_total_us += elapsed;
+    if (elapsed > stat_max_us)
+    {
+      stat_max_us = elapsed;
+    }
+  }
+}
+
+/*
+ * 틱에서 상태가 바뀌는 경우만 데드라인이다:
+ *  - 눌린 탭 키, 탭 카운트 0 : TAPPING_TERM 이 지나면 홀드로 확정(process_record 로 레이어/모드가 나간다)
+ *  - 뗀 탭 키               : TAPPING_TERM 이 지나면 상태머신 리셋(더블탭 창이 닫힌다)
+ * 눌린 채 탭 카운트 > 0 인 상태는 시간이 지나도 다음 이벤트까지 아무 일도 없다.
+ * 이미 지났으면(WITHIN_TAPPING_TERM 은 < 라 elapsed == term 부터 밖이다) 1 — 0 은 "판정 없음" 이라
+ * 그대로 두면 틱이 처리하기 전에 루프가 다음 키 입력까지 잠든다. combo/tap_dance 의 wait_ms 와 같다.
+ * 리졸버는 이 시각 전의 틱을 상태에 넣지 않는다(tap_tick_due) — 두 판단이 같은 조건이다.
+ */
+uint32_t tapping_port_wait_ms(void)
+{
+  if (IS_NOEVENT(tapping_key.event))
+  {
+    return 0;
+  }
+  if (tapping_key.event.pressed && tapping_key.tap.count > 0)
+  {
+    return 0;
+  }
+
+  uint16_t term    = GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key);
+  uint16_t elapsed = TIMER_DIFF_16(timer_read(), tapping_key.event.time);
+
+  return (elapsed >= term) ? 1 : (uint32_t)(term - elapsed);
+}
+
+
+#if CLI_USE(HW_TAPPING)
+void cliTap(cli_args_t *args)
+{
+  bool ret = false;
+
+  if (args->argc == 1 && args->isStr(0, "info"))
+  {
+    cliPrintf("engine      : %s\n", resolver_on ? "resolver" : "vendor");
+    if (IS_NOEVENT(tapping_key.event))
+    {
+      cliPrintf("tapping key : none\n");
+    }
+    else
+    {
+      cliPrintf("tapping key : (%d,%d) %s, tap %d%s, deadline %d ms\n", tapping_key.event.key.row,
+                tapping_key.event.key.col, tapping_key.event.pressed ? "pressed" : "released",
+                tapping_key.tap.count, tapping_key.tap.interrupted ? " interrupted" : "", tapping_port_wait_ms());
+    }
+    cliPrintf("queue       : %d now, peak %d / %d\n", tap_depth(), stat_peak, WAITING_BUFFER_SIZE - 1);
+    cliPrintf("events      : %d, buffered %d, drained %d, replays %d\n", stat_events, stat_buffered, stat_drained,
+              stat_replays);
+    cliPrintf("cost        : avg %d us, max %d us\n", stat_events ? stat_total_us / stat_events : 0, stat_max_us);
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "clear"))
+  {
+    stat_events   = 0;
+    stat_buffered = 0;
+    stat_drained  = 0;
+    stat_peak     = 0;
+    stat_replays  = 0;
+    stat_total_us = 0;
+    stat_max_us   = 0;
+    ret = true;
+  }
+
+  if (args->argc == 2 && args->isStr(0, "resolver"))
+  {
+    bool enable = args->isStr(1, "on");
+
+    if (tapping_port_set_enable(enable))
+    {
+      cliPrintf("engine      : %s\n", tapping_port_is_enabled() ? "resolver" : "vendor");
+    }
+    else
+    {
+      cliPrintf("busy (tap/hold pending) — retry\n");
+    }
+    ret = true;
+  }
+
+  if (ret == false)
+  {
+    cliPrintf("tap info\n");
+    cliPrintf("tap clear\n");
+    cliPrintf("tap resolver on|off\n");
+  }
+}
+#endif
+
+#else
+
+void tapping_port_init(void)
+{
+}
+
+bool tapping_port_set_enable(bool enable)
+{
+  return !enable;
+}
+
+bool tapping_port_is_enabled(void)
+{
+  return false;
+}
+
+uint32_t tapping_port_wait_ms(void)
+{
+  return 0;
+}
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 탭/홀드 판정(quantum/action_tapping.c) 자리의 **리졸버 + 데드라인 내보내기 + 비용 계측**.
+ *
+ * action_tapping_wrapper.c 가 원본을 감싸 컴파일하고 action_tapping_process() 를 리졸버로 바꾼다:
+ *  - 판정 규칙(permissive hold, hold-on-other-key, quick tap, 탭 연타)은 원본 process_tapping() 을
+ *    상태별로 옮긴 것이다. 규칙을 새로 짜면 QMK 와 조금씩 달라지고, 그건 사용자가 "레이어 키가 가끔
+ *    씹힌다" 로만 느낀다. native_sim `--tap-vectors` 가 QMK 탭핑 테스트 벡터와 순정 엔진과의 차분을 돌린다.
+ *  - 다른 건 비용이다. 판정을 기다리는 이벤트는 큐에 들어가고, 원본이 이벤트마다 하던 waiting_buffer
+ *    재스캔(waiting_buffer_typed/scan_tap)은 키별 카운트·뗌 목록으로 O(1) 이 된다. 큐 앞 레코드도 틱마다
+ *    다시 판정하지 않는다 — 판정 조건이 바뀐 때만.
+ *  - 원본 엔진은 _vendor 로 남는다. tapping_port_set_enable(false) / CLI `tap resolver off` /
+ *    native_sim `--tap-vendor` 로 같은 입력을 순정 경로에 돌려 비교한다(레이어 캐시와 같은 A/B).
+ *
+ * 데드라인이 필요한 이유: 순정 엔진은 판정 시각이 지나도 **다음 틱이 올 때까지** 아무 일도 안 한다.
+ * 루프가 잠들어 있으면 그 틱이 다음 키 입력이다. 더 나쁜 건 시각이 16비트 ms 라는 점이다 —
+ * 탭한 뒤 65.5초 배수만큼 자고 다시 탭하면 TIMER_DIFF_16 이 감겨 "TAPPING_TERM 안" 으로 보이고
+ * 더블탭으로 센다. 판정 시각에 한 번 깨워 상태머신을 정리하면 둘 다 없어진다.
+ */
+
+void     tapping_port_init(void);
+
+// false = 순정 엔진. 판정이 걸려 있는 동안은 바꾸지 않고 false 를 돌려준다(큐가 엔진마다 따로다).
+bool     tapping_port_set_enable(bool enable);
+bool     tapping_port_is_enabled(void);
+
+// 탭/홀드 판정이 걸려 있으면 다음 판정 시각까지 남은 ms(최소 1). 0 = 기다릴 판정 없음.
+uint32_t tapping_port_wait_ms(void);
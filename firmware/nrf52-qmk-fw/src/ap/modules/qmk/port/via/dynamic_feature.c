@@ -0,0 +1,511 @@
+#include "quantum.h"
+
+#ifdef DYNAMIC_FEATURE_ENABLE
+
+#include "dynamic_feature.h"
+#include "port.h"
+#include "via.h"
+#include "log.h"
+#include "cli.h"
+#include "qmk/port/combo/combo_port.h"
+#include "qmk/port/tap_dance/tap_dance_port.h"
+#include "qmk/port/key_override/key_override_port.h"
+
+#if CLI_USE(HW_DYNAMIC)
+static void cliDynamic(cli_args_t *args);
+#endif
+
+// 0 = KC_NO 라 0 으로 밀린 영역도 "빈 표" 로 읽히지만, 매크로 버퍼였던 자리를 물려받으므로
+// 옛 매크로 바이트가 남아 있을 수 있다 — 헤더로 판별한다(port.h 규칙과 같은 이유).
+#define DYNAMIC_FEATURE_MAGIC     0xDF7B
+#define DYNAMIC_FEATURE_VERSION   1
+
+enum via_qmk_dynamic_feature_value
+{
+  id_qmk_dynamic_info = 1,
+  id_qmk_dynamic_combo,
+  id_qmk_dynamic_tap_dance,
+  id_qmk_dynamic_key_override,
+  id_qmk_dynamic_clear,
+};
+
+typedef struct PACKED
+{
+  uint16_t magic;
+  uint8_t  version;
+  uint8_t  combo_max;        // 슬롯 수도 헤더에 둔다 — 빌드마다 달라지면 어긋난 자리를 읽지 않게
+  uint8_t  combo_keys;
+  uint8_t  tap_dance_max;
+  uint8_t  key_override_max;
+  uint8_t  rsv;
+} dynamic_header_t;
+
+typedef struct PACKED
+{
+  uint16_t keys[DYNAMIC_COMBO_KEYS];   // KC_NO 는 건너뛴다. 2키 이상이어야 유효
+  uint16_t output;                     // KC_NO = 빈 슬롯
+} dynamic_combo_t;
+
+typedef struct PACKED
+{
+  uint16_t on_tap;
+  uint16_t on_hold;
+  uint16_t on_double_tap;
+  uint16_t on_tap_hold;
+  uint16_t term_ms;                    // 0 = TAPPING_TERM
+} dynamic_tap_dance_t;
+
+typedef struct PACKED
+{
+  uint16_t trigger;
+  uint16_t replacement;
+  uint16_t layers;                     // 레이어 비트마스크(DYNAMIC_KEYMAP_LAYER_COUNT 8 이하)
+  uint8_t  trigger_mods;
+  uint8_t  negative_mod_mask;
+  uint8_t  suppressed_mods;
+  uint8_t  options;                    // ko_option_t 비트 그대로
+  uint8_t  enabled;                    // 0 = 빈 슬롯
+  uint8_t  rsv;
+} dynamic_key_override_t;
+
+typedef struct PACKED
+{
+  dynamic_header_t       header;
+  dynamic_combo_t        combo[DYNAMIC_COMBO_MAX];
+  dynamic_tap_dance_t    tap_dance[DYNAMIC_TAP_DANCE_MAX];
+  dynamic_key_override_t key_override[DYNAMIC_KEY_OVERRIDE_MAX];
+} dynamic_feature_t;
+
+_Static_assert(sizeof(dynamic_feature_t) <= DYNAMIC_FEATURE_EEPROM_SIZE, "EECONFIG out of spec.");
+_Static_assert(DYNAMIC_TAP_DANCE_MAX == TAP_DANCE_PORT_MAX, "tap_dance_actions[] size");
+_Static_assert(DYNAMIC_COMBO_KEYS < 8, "combo_t.state is uint8_t");
+
+static dynamic_feature_t dyn;   // EEPROM 이미지 — VIA get/set 과 탭댄스 콜백이 직접 읽는다
+
+// 엔진에 넘기는 RAM 구조. 유효한 슬롯만 앞으로 모은다.
+static combo_t        combo_tbl[DYNAMIC_COMBO_MAX];
+static uint16_t       combo_keys[DYNAMIC_COMBO_MAX][DYNAMIC_COMBO_KEYS + 1];   // COMBO_END 종료
+static uint8_t        combo_cnt = 0;
+static key_override_t key_override_tbl[DYNAMIC_KEY_OVERRIDE_MAX];
+static uint8_t        key_override_cnt = 0;
+
+// 탭댄스는 TD(n) 가 곧 인덱스라 모으지 않는다 — 슬롯 n 이 tap_dance_actions[n] 이다.
+tap_dance_action_t    tap_dance_actions[DYNAMIC_TAP_DANCE_MAX];
+static uint16_t       tap_dance_kc[DYNAMIC_TAP_DANCE_MAX];   // 판정으로 누른 키 — reset 에서 뗀다
+
+
+static void dynamic_tap_dance_finished(tap_dance_state_t *state, void *user_data)
+{
+  uint8_t              index = (uint8_t)(uintptr_t)user_data;
+  dynamic_tap_dance_t *p_td  = &dyn.tap_dance[index];
+  bool                 hold  = state->pressed && !state->interrupted;
+  uint16_t             kc;
+
+  if (state->count == 1)
+  {
+    kc = (hold && p_td->on_hold != KC_NO) ? p_td->on_hold : p_td->on_tap;
+  }
+  else if (state->count == 2 && hold && p_td->on_tap_hold != KC_NO)
+  {
+    kc = p_td->on_tap_hold;
+  }
+  else if (state->count == 2 && p_td->on_double_tap != KC_NO)
+  {
+    kc = p_td->on_double_tap;
+  }
+  else
+  {
+    // 정의 안 된 다중 탭은 on_tap 을 그 횟수만큼 — 마지막 하나는 누른 채로 두고 reset 에서 뗀다.
+    for (uint8_t i = 1; i < state->count && p_td->on_tap != KC_NO; i++)
+    {
+      tap_code16(p_td->on_tap);
+    }
+    kc = p_td->on_tap;
+  }
+
+  tap_dance_kc[index] = kc;
+  if (kc != KC_NO)
+  {
+    register_code16(kc);
+  }
+}
+
+static void dynamic_tap_dance_reset(tap_dance_state_t *state, void *user_data)
+{
+  uint8_t index = (uint8_t)(uintptr_t)user_data;
+
+  if (tap_dance_kc[index] != KC_NO)
+  {
+    unregister_code16(tap_dance_kc[index]);
+    tap_dance_kc[index] = KC_NO;
+  }
+}
+
+static void dynamic_apply_combo(void)
+{
+  // 엔진이 들고 있는 표를 먼저 떼고 고쳐 쓴다 — 진행 중이던 판정이 반쯤 바뀐 표를 읽지 않게.
+  combo_port_set_table(NULL, 0);
+  combo_cnt = 0;
+
+  for (uint8_t i = 0; i < DYNAMIC_COMBO_MAX; i++)
+  {
+    dynamic_combo_t *p_src  = &dyn.combo[i];
+    uint16_t        *p_keys = combo_keys[combo_cnt];
+    uint8_t          n      = 0;
+
+    if (p_src->output == KC_NO)
+    {
+      continue;
+    }
+    for (uint8_t k = 0; k < DYNAMIC_COMBO_KEYS; k++)
+    {
+      if (p_src->keys[k] != KC_NO)
+      {
+        p_keys[n++] = p_src->keys[k];
+      }
+    }
+    if (n < 2)
+    {
+      continue;   // 1키 콤보는 그냥 키다 — 콤보 엔진에 넣으면 그 키만 COMBO_TERM 만큼 늦어진다
+    }
+    p_keys[n] = COMBO_END;
+
+    memset(&combo_tbl[combo_cnt], 0, sizeof(combo_t));
+    combo_tbl[combo_cnt].keys    = p_keys;
+    combo_tbl[combo_cnt].keycode = p_src->output;
+    combo_cnt++;
+  }
+
+  // 동적 콤보가 하나도 없으면 키맵의 key_combos[] 로 돈다(기본은 빈 표 — §2.12).
+  combo_port_set_table(combo_cnt > 0 ? combo_tbl : NULL, combo_cnt);
+}
+
+static void dynamic_apply_tap_dance(void)
+{
+  for (uint8_t i = 0; i < DYNAMIC_TAP_DANCE_MAX; i++)
+  {
+    tap_dance_port_set_term(i, dyn.tap_dance[i].term_ms);
+  }
+}
+
+static void dynamic_apply_key_override(void)
+{
+  // 켜져 있던 오버라이드는 **고치기 전 내용**으로 꺼야 대체 키가 제대로 떼진다.
+  key_override_port_set_table(NULL, 0);
+  key_override_cnt = 0;
+
+  for (uint8_t i = 0; i < DYNAMIC_KEY_OVERRIDE_MAX; i++)
+  {
+    dynamic_key_override_t *p_src = &dyn.key_override[i];
+    key_override_t         *p_ko  = &key_override_tbl[key_override_cnt];
+
+    if (p_src->enabled == 0 || p_src->layers == 0)
+    {
+      continue;
+    }
+
+    memset(p_ko, 0, sizeof(key_override_t));
+    p_ko->trigger           = p_src->trigger;
+    p_ko->trigger_mods      = p_src->trigger_mods;
+    p_ko->layers            = p_src->layers;
+    p_ko->negative_mod_mask = p_src->negative_mod_mask;
+    p_ko->suppressed_mods   = p_src->suppressed_mods;
+    p_ko->replacement       = p_src->replacement;
+    p_ko->options           = (ko_option_t)p_src->options;
+    key_override_cnt++;
+  }
+
+  key_override_port_set_table(key_override_tbl, key_override_cnt);
+}
+
+static void dynamic_apply(void)
+{
+  dynamic_apply_combo();
+  dynamic_apply_tap_dance();
+  dynamic_apply_key_override();
+}
+
+static void dynamic_clear(void)
+{
+  memset(&dyn, 0, sizeof(dyn));
+  dyn.header.magic            = DYNAMIC_FEATURE_MAGIC;
+  dyn.header.version          = DYNAMIC_FEATURE_VERSION;
+  dyn.header.combo_max        = DYNAMIC_COMBO_MAX;
+  dyn.header.combo_keys       = DYNAMIC_COMBO_KEYS;
+  dyn.header.tap_dance_max    = DYNAMIC_TAP_DANCE_MAX;
+  dyn.header.key_override_max = DYNAMIC_KEY_OVERRIDE_MAX;
+}
+
+static bool dynamic_is_valid(void)
+{
+  return dyn.header.magic == DYNAMIC_FEATURE_MAGIC && dyn.header.version == DYNAMIC_FEATURE_VERSION &&
+         dyn.header.combo_max == DYNAMIC_COMBO_MAX && dyn.header.combo_keys == DYNAMIC_COMBO_KEYS &&
+         dyn.header.tap_dance_max == DYNAMIC_TAP_DANCE_MAX &&
+         dyn.header.key_override_max == DYNAMIC_KEY_OVERRIDE_MAX;
+}
+
+// 미러만 바뀐다 — 플래시는 settle-flush 가 한 번에 쓴다(§2.7). 안 바뀐 바이트는 dirty 를 안 늘린다.
+static void dynamic_save(void)
+{
+  eeprom_update_block(&dyn, EECONFIG_DYNAMIC_FEATURE, sizeof(dyn));
+}
+
+void dynamic_feature_reload(void)
+{
+  eeprom_read_block(&dyn, EECONFIG_DYNAMIC_FEATURE, sizeof(dyn));
+  if (!dynamic_is_valid())
+  {
+    dynamic_clear();
+    dynamic_save();
+  }
+  dynamic_apply();
+}
+
+void dynamic_feature_init(void)
+{
+  for (uint8_t i = 0; i < DYNAMIC_TAP_DANCE_MAX; i++)
+  {
+    tap_dance_actions[i] = (tap_dance_action_t)ACTION_TAP_DANCE_FN_ADVANCED(NULL, dynamic_tap_dance_finished,
+                                                                           dynamic_tap_dance_reset);
+    tap_dance_actions[i].user_data = (void *)(uintptr_t)i;
+  }
+
+  dynamic_feature_reload();
+
+#if CLI_USE(HW_DYNAMIC)
+  cliAdd("dynamic", cliDynamic);
+#endif
+
+  logPrintf("[ON] DYNAMIC COMBO %d, KEY OVERRIDE %d (eeprom %d B @%d)\n", combo_cnt, key_override_cnt,
+            (int)sizeof(dyn), (int)(uint32_t)EECONFIG_DYNAMIC_FEATURE);
+}
+
+static uint16_t via_get_u16(const uint8_t *p)
+{
+  return ((uint16_t)p[0] << 8) | p[1];
+}
+
+static void via_put_u16(uint8_t *p, uint16_t value)
+{
+  p[0] = value >> 8;
+  p[1] = value & 0xFF;
+}
+
+static void via_qmk_dynamic_feature_get_value(uint8_t *data)
+{
+  uint8_t *value_id   = &(data[0]);
+  uint8_t *value_data = &(data[1]);
+  uint8_t  index      = value_data[0];
+  uint8_t *p_entry    = &value_data[1];
+
+  switch (*value_id)
+  {
+    case id_qmk_dynamic_info:
+      value_data[0] = DYNAMIC_FEATURE_VERSION;
+      value_data[1] = DYNAMIC_COMBO_MAX;
+      value_data[2] = DYNAMIC_COMBO_KEYS;
+      value_data[3] = DYNAMIC_TAP_DANCE_MAX;
+      value_data[4] = DYNAMIC_KEY_OVERRIDE_MAX;
+      break;
+
+    case id_qmk_dynamic_combo:
+      if (index < DYNAMIC_COMBO_MAX)
+      {
+        for (uint8_t k = 0; k < DYNAMIC_COMBO_KEYS; k++)
+        {
+          via_put_u16(&p_entry[k * 2], dyn.combo[index].keys[k]);
+        }
+        via_put_u16(&p_entry[DYNAMIC_COMBO_KEYS * 2], dyn.combo[index].output);
+      }
+      break;
+
+    case id_qmk_dynamic_tap_dance:
+      if (index < DYNAMIC_TAP_DANCE_MAX)
+      {
+        dynamic_tap_dance_t *p_td = &dyn.tap_dance[index];
+
+        via_put_u16(&p_entry[0], p_td->on_tap);
+        via_put_u16(&p_entry[2], p_td->on_hold);
+        via_put_u16(&p_entry[4], p_td->on_double_tap);
+        via_put_u16(&p_entry[6], p_td->on_tap_hold);
+        via_put_u16(&p_entry[8], p_td->term_ms);
+      }
+      break;
+
+    case id_qmk_dynamic_key_override:
+      if (index < DYNAMIC_KEY_OVERRIDE_MAX)
+      {
+        dynamic_key_override_t *p_ko = &dyn.key_override[index];
+
+        via_put_u16(&p_entry[0], p_ko->trigger);
+        via_put_u16(&p_entry[2], p_ko->replacement);
+        via_put_u16(&p_entry[4], p_ko->layers);
+        p_entry[6]  = p_ko->trigger_mods;
+        p_entry[7]  = p_ko->negative_mod_mask;
+        p_entry[8]  = p_ko->suppressed_mods;
+        p_entry[9]  = p_ko->options;
+        p_entry[10] = p_ko->enabled;
+      }
+      break;
+  }
+}
+
+static void via_qmk_dynamic_feature_set_value(uint8_t *data)
+{
+  uint8_t *value_id   = &(data[0]);
+  uint8_t *value_data = &(data[1]);
+  uint8_t  index      = value_data[0];
+  uint8_t *p_entry    = &value_data[1];
+
+  // 저장 전에도 즉시 적용된다 — 바뀐 종류의 표/인덱스만 다시 만든다.
+  switch (*value_id)
+  {
+    case id_qmk_dynamic_combo:
+      if (index < DYNAMIC_COMBO_MAX)
+      {
+        for (uint8_t k = 0; k < DYNAMIC_COMBO_KEYS; k++)
+        {
+          dyn.combo[index].keys[k] = via_get_u16(&p_entry[k * 2]);
+        }
+        dyn.combo[index].output = via_get_u16(&p_entry[DYNAMIC_COMBO_KEYS * 2]);
+        dynamic_apply_combo();
+      }
+      break;
+
+    case id_qmk_dynamic_tap_dance:
+      if (index < DYNAMIC_TAP_DANCE_MAX)
+      {
+        dynamic_tap_dance_t *p_td = &dyn.tap_dance[index];
+
+        tap_dance_port_reset();   // 진행 중인 판정이 바뀔 슬롯을 읽지 않게
+        p_td->on_tap        = via_get_u16(&p_entry[0]);
+        p_td->on_hold       = via_get_u16(&p_entry[2]);
+        p_td->on_double_tap = via_get_u16(&p_entry[4]);
+        p_td->on_tap_hold   = via_get_u16(&p_entry[6]);
+        p_td->term_ms       = via_get_u16(&p_entry[8]);
+        tap_dance_port_set_term(index, p_td->term_ms);
+      }
+      break;
+
+    case id_qmk_dynamic_key_override:
+      if (index < DYNAMIC_KEY_OVERRIDE_MAX)
+      {
+        dynamic_key_override_t *p_ko = &dyn.key_override[index];
+
+        p_ko->trigger           = via_get_u16(&p_entry[0]);
+        p_ko->replacement       = via_get_u16(&p_entry[2]);
+        p_ko->layers            = via_get_u16(&p_entry[4]);
+        p_ko->trigger_mods      = p_entry[6];
+        p_ko->negative_mod_mask = p_entry[7];
+        p_ko->suppressed_mods   = p_entry[8];
+        p_ko->options           = p_entry[9];
+        p_ko->enabled           = p_entry[10];
+        dynamic_apply_key_override();
+      }
+      break;
+
+    case id_qmk_dynamic_clear:
+      if (value_data[0] != 0)
+      {
+        tap_dance_port_reset();
+        dynamic_clear();
+        dynamic_apply();
+      }
+      break;
+  }
+}
+
+void via_qmk_dynamic_feature_command(uint8_t *data, uint8_t length)
+{
+  // data = [ command_id, channel_id, value_id, value_data ]
+  uint8_t *command_id        = &(data[0]);
+  uint8_t *value_id_and_data = &(data[2]);
+
+  switch (*command_id)
+  {
+    case id_custom_set_value:
+      via_qmk_dynamic_feature_set_value(value_id_and_data);
+      break;
+
+    case id_custom_get_value:
+      via_qmk_dynamic_feature_get_value(value_id_and_data);
+      break;
+
+    case id_custom_save:
+      dynamic_save();
+      break;
+
+    default:
+      *command_id = id_unhandled;
+      break;
+  }
+}
+
+
+#if CLI_USE(HW_DYNAMIC)
+void cliDynamic(cli_args_t *args)
+{
+  bool ret = false;
+
+  if (args->argc == 1 && args->isStr(0, "info"))
+  {
+    uint8_t td_cnt = 0;
+
+    for (uint8_t i = 0; i < DYNAMIC_TAP_DANCE_MAX; i++)
+    {
+      td_cnt += (dyn.tap_dance[i].on_tap != KC_NO || dyn.tap_dance[i].on_hold != KC_NO) ? 1 : 0;
+    }
+    cliPrintf("eeprom       : %d B @%d (region %d B), version %d\n", (int)sizeof(dyn),
+              (int)(uint32_t)EECONFIG_DYNAMIC_FEATURE, DYNAMIC_FEATURE_EEPROM_SIZE, dyn.header.version);
+    cliPrintf("combo        : %d / %d, indexed %s\n", combo_cnt, DYNAMIC_COMBO_MAX,
+              combo_port_is_indexed() ? "yes" : "no");
+    cliPrintf("tap dance    : %d / %d, deadline %d ms\n", td_cnt, DYNAMIC_TAP_DANCE_MAX, tap_dance_port_wait_ms());
+    cliPrintf("key override : %d / %d\n", key_override_cnt, DYNAMIC_KEY_OVERRIDE_MAX);
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "list"))
+  {
+    for (uint8_t i = 0; i < DYNAMIC_COMBO_MAX; i++)
+    {
+      dynamic_combo_t *p_c = &dyn.combo[i];
+
+      if (p_c->output != KC_NO)
+      {
+        cliPrintf("combo %2d : %04X %04X %04X %04X -> %04X\n", i, p_c->keys[0], p_c->keys[1], p_c->keys[2],
+                  p_c->keys[3], p_c->output);
+      }
+    }
+    for (uint8_t i = 0; i < DYNAMIC_TAP_DANCE_MAX; i++)
+    {
+      dynamic_tap_dance_t *p_td = &dyn.tap_dance[i];
+
+      if (p_td->on_tap != KC_NO || p_td->on_hold != KC_NO)
+      {
+        cliPrintf("td    %2d : tap %04X, hold %04X, double %04X, tap-hold %04X, term %d\n", i, p_td->on_tap,
+                  p_td->on_hold, p_td->on_double_tap, p_td->on_tap_hold, p_td->term_ms);
+      }
+    }
+    for (uint8_t i = 0; i < DYNAMIC_KEY_OVERRIDE_MAX; i++)
+    {
+      dynamic_key_override_t *p_ko = &dyn.key_override[i];
+
+      if (p_ko->enabled != 0)
+      {
+        cliPrintf("ko    %2d : %04X + mods %02X -> %04X, layers %04X, neg %02X, supp %02X, opt %02X\n", i,
+                  p_ko->trigger, p_ko->trigger_mods, p_ko->replacement, p_ko->layers, p_ko->negative_mod_mask,
+                  p_ko->suppressed_mods, p_ko->options);
+      }
+    }
+    ret = true;
+  }
+
+  if (ret == false)
+  {
+    cliPrintf("dynamic info\n");
+    cliPrintf("dynamic list\n");
+  }
+}
+#endif
+
+#endif   // DYNAMIC_FEATURE_ENABLE
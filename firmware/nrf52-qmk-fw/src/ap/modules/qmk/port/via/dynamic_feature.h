@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * 콤보 / 탭댄스 / 키 오버라이드의 **동적 표** (VIA 채널 19).
+ *
+ * 키맵은 VIA 로 고치는데 이 셋은 C 표(key_combos[], key_overrides)라 펌웨어를 다시 구워야 했다.
+ * 여기서 셋을 EEPROM 의 고정 슬롯 표로 들고, 부팅 때 RAM 구조로 풀어 각 엔진에 넘긴다:
+ *   콤보       -> combo_port_set_table()        (키코드 -> 콤보 후보 인덱스, port/combo/)
+ *   탭댄스     -> tap_dance_actions[] 직접 소유  (TD(n) -> 배열 인덱스, port/tap_dance/)
+ *   키 오버라이드 -> key_override_port_set_table() (트리거 인덱스, port/key_override/)
+ * 매칭은 키마다 인덱스로 찾는다 — 슬롯 수에 비례하는 선형 검사가 아니다.
+ *
+ * [EEPROM] 키맵/매크로 뒤, EEPROM 끝의 DYNAMIC_FEATURE_EEPROM_SIZE 바이트(port/port.h 의 맵).
+ * 맨 앞 헤더(magic, version, 슬롯 수)가 안 맞으면 빈 표로 초기화한다 — 슬롯 수를 바꾸면 version 을 올릴 것.
+ * 빈 슬롯 = 전부 0(KC_NO). 쓰기는 RAM 미러 -> settle-flush(§2.7) 그대로다.
+ *
+ * [VIA] data = [command_id, channel_id, value_id, index, entry...]. 키코드는 2B **빅엔디안**(VIA 규약).
+ *   value 1 (get)     : [version, combo 슬롯, 콤보당 키, 탭댄스 슬롯, 오버라이드 슬롯]
+ *   value 2 콤보      : [index, key0..key3, output]                         (2B x 5)
+ *   value 3 탭댄스    : [index, on_tap, on_hold, on_double_tap, on_tap_hold, term_ms]  (2B x 5, term 0 = TAPPING_TERM)
+ *   value 4 오버라이드 : [index, trigger, replacement, layers(2B), trigger_mods, negative_mod_mask,
+ *                        suppressed_mods, options(ko_option_t), enabled]
+ *   value 5 (set)     : 전부 비우기
+ * get 은 index 를 받아 그 뒤에 슬롯 내용을 채운다. set 은 즉시 적용(RAM), save 가 EEPROM 에 쓴다.
+ */
+
+#define DYNAMIC_COMBO_MAX           32
+#define DYNAMIC_COMBO_KEYS          4      // 콤보 하나의 최대 키 수
+#define DYNAMIC_TAP_DANCE_MAX       16     // = TAP_DANCE_PORT_MAX (TD(0) ~ TD(15))
+#define DYNAMIC_KEY_OVERRIDE_MAX    16
+
+// EEPROM 에서 표를 읽어 각 엔진에 넘긴다. viaPortInit() 에서 — combo_port_init()/key_override_port_init() 뒤.
+void dynamic_feature_init(void);
+// EEPROM 미러의 표가 VIA 채널 밖에서 바뀌었다(벌크 EEPROM 쓰기, port/via/via_bulk.c) — 다시 읽어 엔진에 넘긴다.
+// 헤더가 안 맞으면 부팅 때와 같이 빈 표로 초기화한다.
+void dynamic_feature_reload(void);
+void via_qmk_dynamic_feature_command(uint8_t *data, uint8_t length);
@@ -1,5 +1,6 @@
 #include "power_cfg.h"
 #include "activity.h"
+#include "rgb_limiter.h"
 #include "quantum.h"
 #include "via.h"
 #include "log.h"
@@ -68,6 +69,40 @@ static rgb_cfg_t rgb_cfg_config;
 
 EECONFIG_DEBOUNCE_HELPER(rgb_cfg, EECONFIG_USER_RGB_CFG, rgb_cfg_config);
 
+/*
+ * RGB 전류 예산 — 또 별도 블록(port.h 의 +20), 같은 이유로 자기 magic 을 가진다.
+ * 단위 10mA(VIA 드롭다운 1바이트 → 최대 2.55A). 0 = 제한 없음.
+ * 기본값은 보드 config.h 가 바꿀 수 있고, VIA JSON 드롭다운 목록에 있어야 한다.
+ *  - USB 400mA : 호스트 포트 500mA 에서 MCU/충전 몫을 뺀 값
+ *  - 배터리 300mA : 소형 LiPo 가 전압 강하 없이 버티는 선(§6.10 — 800mA 피크면 보호회로가 걸릴 수 있다)
+ */
+#ifndef RGB_LIMIT_USB_MA_DEFAULT
+#define RGB_LIMIT_USB_MA_DEFAULT  400
+#endif
+#ifndef RGB_LIMIT_BAT_MA_DEFAULT
+#define RGB_LIMIT_BAT_MA_DEFAULT  300
+#endif
+#define RGB_LIMIT_MAGIC           0xA5
+
+typedef union
+{
+  uint32_t raw;
+
+  struct PACKED
+  {
+    uint8_t magic;       // RGB_LIMIT_MAGIC = 저장된 적 있음 (0 이 유효값)
+    uint8_t usb_10ma;    // USB 전원일 때 예산(10mA)
+    uint8_t bat_10ma;    // 배터리일 때 예산(10mA)
+    uint8_t rsv;
+  };
+} rgb_limit_cfg_t;
+
+_Static_assert(sizeof(rgb_limit_cfg_t) == sizeof(uint32_t), "EECONFIG out of spec.");
+
+static rgb_limit_cfg_t rgb_limit_config;
+
+EECONFIG_DEBOUNCE_HELPER(rgb_limit, EECONFIG_USER_RGB_LIMIT, rgb_limit_config);
+
 
 // 설정값을 activity 상태머신에 반영.
 static void power_cfg_apply(void)
@@ -75,6 +110,7 @@ static void power_cfg_apply(void)
   activitySetIdleTimeout((uint32_t)power_cfg_config.idle_s * 1000);
   activitySetSleepTimeout((uint32_t)power_cfg_config.sleep_m * 60 * 1000);
   activitySetRgbTimeout((uint32_t)rgb_cfg_config.timeout_m * 60 * 1000);
+  rgb_limiter_set_budget((uint16_t)rgb_limit_config.usb_10ma * 10, (uint16_t)rgb_limit_config.bat_10ma * 10);
 }
 
 void power_cfg_init(void)
@@ -83,6 +119,8 @@ void power_cfg_init(void)
 
   eeconfig_init_rgb_cfg();
 
+  eeconfig_init_rgb_limit();
+
   // 미초기화(0x00 / 0xFF) 방어 → 기본값으로 되돌리고 한 번 flush.
   // RGB 는 별도 블록이라 따로 본다 — POWER 를 이미 저장한 보드도 여기선 처음이다.
   if (rgb_cfg_config.magic != RGB_CFG_MAGIC)
@@ -94,6 +132,15 @@ void power_cfg_init(void)
     eeconfig_flush_rgb_cfg(true);
   }
 
+  if (rgb_limit_config.magic != RGB_LIMIT_MAGIC)
+  {
+    rgb_limit_config.magic    = RGB_LIMIT_MAGIC;
+    rgb_limit_config.usb_10ma = RGB_LIMIT_USB_MA_DEFAULT / 10;
+    rgb_limit_config.bat_10ma = RGB_LIMIT_BAT_MA_DEFAULT / 10;
+    rgb_limit_config.rsv      = 0;
+    eeconfig_flush_rgb_limit(true);
+  }
+
   if (power_cfg_config.magic != POWER_CFG_MAGIC)
   {
     power_cfg_config.magic   = POWER_CFG_MAGIC;
@@ -128,6 +175,18 @@ static void via_qmk_power_get_value(uint8_t *data)
     case id_qmk_power_rgb_timeout:
       value_data[0] = rgb_cfg_config.timeout_m;
       break;
+
+    case id_qmk_power_rgb_limit_usb:
+      value_data[0] = rgb_limit_config.usb_10ma;
+      break;
+
+    case id_qmk_power_rgb_limit_bat:
+      value_data[0] = rgb_limit_config.bat_10ma;
+      break;
+
+    case id_qmk_power_rgb_current:
+      value_data[0] = MIN(rgb_limiter_get_estimate_ma() / 10, 255);
+      break;
   }
 }
 
@@ -150,6 +209,14 @@ static void via_qmk_power_set_value(uint8_t *data)
     case id_qmk_power_rgb_timeout:
       rgb_cfg_config.timeout_m = value_data[0];
       break;
+
+    case id_qmk_power_rgb_limit_usb:
+      rgb_limit_config.usb_10ma = value_data[0];
+      break;
+
+    case id_qmk_power_rgb_limit_bat:
+      rgb_limit_config.bat_10ma = value_data[0];
+      break;
   }
 
   power_cfg_apply();   // 저장 전에도 즉시 반영(VIA 는 set 후 save 를 따로 보낸다)
@@ -174,6 +241,7 @@ void via_qmk_power_command(uint8_t *data, uint8_t length)
     case id_custom_save:
       eeconfig_flush_power_cfg(true);
       eeconfig_flush_rgb_cfg(true);   // RGB 는 별도 블록이라 따로 flush 해야 한다
+      eeconfig_flush_rgb_limit(true);
       break;
 
     default:
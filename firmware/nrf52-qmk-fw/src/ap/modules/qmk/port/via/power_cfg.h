@@ -14,6 +14,9 @@ enum
   id_qmk_power_idle_timeout  = 1,   // 초  (0 = 비활성)
   id_qmk_power_sleep_timeout = 2,   // 분  (0 = 안 잠)
   id_qmk_power_rgb_timeout   = 3,   // 분  (0 = 안 끔 — ZMK 와 같은 동작)
+  id_qmk_power_rgb_limit_usb = 4,   // 10mA (0 = 제한 없음) — RGB 전류 예산, USB 전원
+  id_qmk_power_rgb_limit_bat = 5,   // 10mA (0 = 제한 없음) — RGB 전류 예산, 배터리
+  id_qmk_power_rgb_current   = 6,   // 10mA, 읽기 전용 — 마지막 프레임 추정 전류(port/rgb_limiter.h)
 };
 
 // EEPROM 값을 읽어 activity 에 적용. activityInit() 뒤에 호출할 것.
@@ -4,6 +4,9 @@
 #include "eeprom.h"       // eeprom_req_clean()
 #include "bootloader.h"   // bootloader_jump()
 #include "log.h"
+#include "raw_hid.h"
+#include "boot_prof.h"
+#include "wake_stat.h"
 
 #ifdef VIA_ENABLE
 
@@ -91,4 +94,87 @@ void via_qmk_system_command(uint8_t *data, uint8_t length)
   }
 }
 
+#define BOOT_PROF_PER_PACKET    6
+
+bool via_qmk_boot_prof_command(uint8_t *data, uint8_t length)
+{
+  // data = [ B7, start ] -> [ B7, total, start, flags, us(4) x 6 ]
+  uint8_t start = data[1];
+
+  if (data[0] != ID_QMK_BOOT_PROF)
+  {
+    return false;
+  }
+
+  data[1] = BOOT_PROF_MAX;
+  data[2] = start;
+  data[3] = bootProfIsWakeFromOff() ? 0x01 : 0x00;
+
+  for (uint8_t i = 0; i < BOOT_PROF_PER_PACKET; i++)
+  {
+    uint16_t phase = start + i;
+    uint32_t us    = (phase < BOOT_PROF_MAX) ? bootProfGetUs(phase) : 0;
+
+    data[4 + i*4 + 0] = us >> 24;
+    data[4 + i*4 + 1] = us >> 16;
+    data[4 + i*4 + 2] = us >> 8;
+    data[4 + i*4 + 3] = us >> 0;
+  }
+
+  raw_hid_send(data, length);
+  return true;
+}
+
+#define WAKE_STAT_PER_PACKET    3
+
+static void via_put_u32(uint8_t *p, uint32_t v)
+{
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v >> 0;
+}
+
+bool via_qmk_wake_stat_command(uint8_t *data, uint8_t length)
+{
+  // data = [ B8, start, flags ] -> [ B8, total, start, flags, elapsed_ms(4), (count(4) active_us(4)) x 3 ]
+  uint8_t start = data[1];
+  uint8_t flags = data[2];
+
+  if (data[0] != ID_QMK_WAKE_STAT)
+  {
+    return false;
+  }
+
+  data[1] = WAKE_REASON_MAX;
+  data[2] = start;
+  data[3] = flags;
+  via_put_u32(&data[4], wakeStatGetElapsedMs());
+
+  for (uint8_t i = 0; i < WAKE_STAT_PER_PACKET; i++)
+  {
+    uint16_t reason    = start + i;
+    uint32_t count     = 0;
+    uint32_t active_us = 0;
+
+    if (reason < WAKE_REASON_MAX)
+    {
+      const wake_stat_t *p_stat = wakeStatGet(reason);
+
+      count     = p_stat->count;
+      active_us = (uint32_t)MIN(p_stat->active_us, UINT32_MAX);
+    }
+    via_put_u32(&data[8 + i*8 + 0], count);
+    via_put_u32(&data[8 + i*8 + 4], active_us);
+  }
+
+  if (flags & 0x01)
+  {
+    wakeStatClear();
+  }
+
+  raw_hid_send(data, length);
+  return true;
+}
+
 #endif
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /*
  * 시스템 채널 — 부트로더 진입 / EEPROM 초기화 (baram-qmk 의 port/sys_port.c 와 동일 구성).
@@ -18,3 +19,30 @@ enum
 };
 
 void via_qmk_system_command(uint8_t *data, uint8_t length);
+
+/*
+ * 부팅 프로파일 조회 — 채널 값이 아니라 **명령 ID** 로 받는다(via_command_kb, 벌크와 같은 경로).
+ * 값이 µs 32비트 여러 개라 1바이트 커스텀 값으로는 못 싣는다. 순정 VIA 는 보내지 않는 ID 다.
+ *
+ *   H->D [B7 start]
+ *   D->H [B7 total start flags us(4) x 6]   flags bit0 = System OFF 웨이크, us 는 빅엔디안(0 = 아직)
+ *
+ * 단계 순서/의미는 boot_prof.h 의 BOOT_PROF_* 와 같다. total 이 6 을 넘으면 start 를 올려 다시 묻는다.
+ */
+#define ID_QMK_BOOT_PROF        0xB7
+
+bool via_qmk_boot_prof_command(uint8_t *data, uint8_t length);
+
+/*
+ * 깨어남 회계 조회 — 부팅 프로파일과 같은 모양(명령 ID, 페이지). 이유 순서/의미는 port/wake_stat.h 의
+ * WAKE_REASON_* 와 같다.
+ *
+ *   H->D [B8 start flags]                                   flags bit0 = 보낸 뒤 초기화
+ *   D->H [B8 total start flags elapsed_ms(4) (count(4) active_us(4)) x 3]   빅엔디안
+ *
+ * active_us 는 32비트에서 포화한다(71분). 오래 재려면 주기적으로 읽으며 bit0 로 비운다 —
+ * 펌웨어는 64비트로 들고 있고 CLI `wake info` 는 그대로 보여 준다.
+ */
+#define ID_QMK_WAKE_STAT        0xB8
+
+bool via_qmk_wake_stat_command(uint8_t *data, uint8_t length);
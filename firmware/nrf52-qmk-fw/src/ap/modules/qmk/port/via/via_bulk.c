@@ -0,0 +1,394 @@
+#include "via_bulk.h"
+#include "via_hid.h"
+#include "quantum.h"
+#include "via.h"
+#include "raw_hid.h"
+#include "dynamic_keymap.h"
+#include "dynamic_feature.h"
+#include "port.h"
+#include "log.h"
+#include "qmk/port/layer/layer_cache.h"
+#include <zephyr/sys/crc.h>
+
+#ifdef VIA_ENABLE
+
+/*
+ * 청크 = 32B 리포트 - [cmd, seq] 2B.
+ *
+ * [윈도우 상한 4] D->H 청크는 usb_hid.c 의 usb_tx_q(깊이 8)에 들어간다. 이 큐는 **키보드 리포트와
+ * 공유**하고 꽉 차면 버린다(K_NO_WAIT). 윈도우를 큐 깊이만큼 잡으면 벌크 중에 친 키가 유실된다.
+ * 4 면 키보드/EXK 몫이 항상 남고, 1ms 폴링 기준 청크 4개 = 4ms 라 ACK 왕복을 충분히 가린다.
+ * 반대 방향(WRITE)은 via_hid.c 수신 풀(8)보다 작아서 규약대로 도는 호스트는 풀을 못 채운다.
+ * 그래도 청크가 버려지면(raw_hid_send 는 결과를 안 준다) 호스트 타임아웃 -> rewind ACK 로 복구된다.
+ */
+#define BULK_CHUNK_SIZE       30
+#define BULK_ACK_REWIND       0x01
+
+typedef struct
+{
+  bool     active;
+  bool     is_write;
+  uint8_t  region;
+  uint8_t  window;
+  uint16_t offset;
+  uint16_t length;
+  uint16_t chunks;
+  uint16_t base;        // 호스트가 확인한 청크(READ) / 마지막으로 ACK 한 청크(WRITE)
+  uint16_t next;        // 다음에 보낼 청크(READ) / 다음에 받을 청크(WRITE)
+  bool     nak_sent;    // 순서 어긋남마다 rewind 를 남발하지 않도록 — 한 구멍에 한 번
+  bool     dyn_dirty;   // EEPROM 영역 쓰기가 동적 표를 덮었다 — 세션이 끝날 때 다시 읽힌다
+  uint32_t start_ms;
+} bulk_session_t;
+
+static bulk_session_t   bulk;
+static via_bulk_stats_t bulk_stats;
+
+
+static uint16_t bulk_region_size(uint8_t region)
+{
+  switch (region)
+  {
+    case VIA_BULK_REGION_EEPROM:
+      return TOTAL_EEPROM_BYTE_COUNT;
+
+    case VIA_BULK_REGION_KEYMAP:
+      return dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+  }
+  return 0;
+}
+
+// 읽기는 EEPROM RAM 미러에서 나온다(플래시 접근 없음) — port/platforms/eeprom.c.
+static void bulk_region_read(uint8_t region, uint16_t offset, uint8_t *buf, uint16_t len)
+{
+  if (region == VIA_BULK_REGION_KEYMAP)
+  {
+    dynamic_keymap_get_buffer(offset, len, buf);
+  }
+  else
+  {
+    eeprom_read_block(buf, (const void *)(uintptr_t)offset, len);
+  }
+}
+
+static bool bulk_overlaps(uint16_t offset, uint16_t len, uint32_t start, uint32_t size)
+{
+  return offset < start + size && start < (uint32_t)offset + len;
+}
+
+/*
+ * 쓰기도 미러만 갱신한다. 실제 플래시 쓰기는 eeprom_task 의 settle-flush(편집이 100ms 멎으면
+ * 한 번)에 맡긴다 — 벌크는 청크가 ms 단위로 연달아 오므로 전송 전체가 **flush 1회**로 합쳐진다.
+ * 청크마다 flush 를 부르면 그 장점(플래시 program/erase 최소화)이 사라진다.
+ *
+ * EEPROM 영역은 dynamic_keymap 을 거치지 않으므로 RAM 쪽 파생 상태를 여기서 챙긴다:
+ *  - 키맵 바이트를 덮으면 레이어 캐시(port/layer)를 버린다 — 청크마다, 다음 조회가 다시 만든다.
+ *  - 동적 표(콤보/탭댄스/키 오버라이드)를 덮으면 세션이 끝날 때(bulk_close) 미러에서 다시 읽어 넘긴다.
+ *    청크 중간엔 헤더가 반쯤 쓰여 있을 수 있어 그때 읽으면 빈 표로 초기화해 버린다.
+ */
+static void bulk_region_write(uint8_t region, uint16_t offset, const uint8_t *buf, uint16_t len)
+{
+  if (region == VIA_BULK_REGION_KEYMAP)
+  {
+    dynamic_keymap_set_buffer(offset, len, (uint8_t *)buf);
+    return;
+  }
+
+  eeprom_update_block(buf, (void *)(uintptr_t)offset, len);
+
+  if (bulk_overlaps(offset, len, (uint32_t)(uintptr_t)dynamic_keymap_key_to_eeprom_address(0, 0, 0),
+                    bulk_region_size(VIA_BULK_REGION_KEYMAP)))
+  {
+    layer_cache_invalidate();
+  }
+#ifdef DYNAMIC_FEATURE_ENABLE
+  if (bulk_overlaps(offset, len, (uint32_t)(uintptr_t)EECONFIG_DYNAMIC_FEATURE, DYNAMIC_FEATURE_EEPROM_SIZE))
+  {
+    bulk.dyn_dirty = true;
+  }
+#endif
+}
+
+// 세션을 닫는다(END, ABORT, 새 세션이 덮을 때). 쓴 바이트는 CRC 결과와 상관없이 미러에 남아 있다 —
+// 파생 상태도 그 미러를 따라가야 재부팅 전후가 같다.
+static void bulk_close(void)
+{
+#ifdef DYNAMIC_FEATURE_ENABLE
+  if (bulk.dyn_dirty)
+  {
+    dynamic_feature_reload();
+  }
+#endif
+  bulk.dyn_dirty = false;
+  bulk.active    = false;
+}
+
+static uint16_t bulk_chunk_len(uint16_t index)
+{
+  uint32_t pos = (uint32_t)index * BULK_CHUNK_SIZE;
+
+  return MIN(BULK_CHUNK_SIZE, bulk.length - pos);
+}
+
+static uint32_t bulk_region_crc(void)
+{
+  uint8_t  buf[32];
+  uint32_t crc = 0;
+  uint16_t pos = 0;
+
+  while (pos < bulk.length)
+  {
+    uint16_t n = MIN(sizeof(buf), bulk.length - pos);
+
+    bulk_region_read(bulk.region, bulk.offset + pos, buf, n);
+    crc = crc32_ieee_update(crc, buf, n);
+    pos += n;
+  }
+  return crc;
+}
+
+static void bulk_send_chunk(uint16_t index)
+{
+  uint8_t  buf[32] = {0};
+  uint16_t len     = bulk_chunk_len(index);
+
+  buf[0] = ID_QMK_BULK_DATA;
+  buf[1] = (uint8_t)index;
+  bulk_region_read(bulk.region, bulk.offset + index * BULK_CHUNK_SIZE, &buf[2], len);
+  raw_hid_send(buf, sizeof(buf));
+
+  bulk_stats.chunks++;
+}
+
+// READ: 윈도우가 허락하는 만큼 연달아 보낸다. ACK 가 올 때마다 다시 불린다.
+static void bulk_pump(void)
+{
+  while (bulk.next < bulk.chunks && (bulk.next - bulk.base) < bulk.window)
+  {
+    bulk_send_chunk(bulk.next);
+    bulk.next++;
+  }
+}
+
+static void bulk_send_ack(uint8_t flags)
+{
+  uint8_t buf[32] = {0};
+
+  buf[0] = ID_QMK_BULK_ACK;
+  buf[1] = (uint8_t)bulk.next;
+  buf[2] = flags;
+  raw_hid_send(buf, sizeof(buf));
+}
+
+static uint8_t bulk_begin(uint8_t *data, bool is_write)
+{
+  // data = [ cmd, region, off_hi, off_lo, len_hi, len_lo, window ]
+  uint8_t  region = data[1];
+  uint16_t offset = (data[2] << 8) | data[3];
+  uint16_t length = (data[4] << 8) | data[5];
+  uint8_t  window = data[6];
+  uint32_t size   = bulk_region_size(region);
+
+  bulk_close();
+
+  if (size == 0 || length == 0 || (uint32_t)offset + length > size)
+  {
+    return VIA_BULK_ERR_PARAM;
+  }
+
+  if (window == 0 || window > VIA_BULK_WINDOW_MAX)
+  {
+    window = VIA_BULK_WINDOW_MAX;
+  }
+
+  bulk.active   = true;
+  bulk.is_write = is_write;
+  bulk.region   = region;
+  bulk.window   = window;
+  bulk.offset   = offset;
+  bulk.length   = length;
+  bulk.chunks   = (length + BULK_CHUNK_SIZE - 1) / BULK_CHUNK_SIZE;
+  bulk.base     = 0;
+  bulk.next     = 0;
+  bulk.nak_sent = false;
+  bulk.start_ms = timer_read32();
+
+  bulk_stats.sessions++;
+  return VIA_BULK_OK;
+}
+
+static void bulk_on_host_ack(uint8_t *data)
+{
+  // data = [ cmd, next_seq, flags ]
+  uint8_t delta = (uint8_t)(data[1] - (uint8_t)bulk.base);
+
+  if (!bulk.active || bulk.is_write)
+  {
+    return;
+  }
+
+  // 누적 ACK. 아직 안 보낸 청크를 확인했다고 하면(오래된/깨진 ACK) 무시한다.
+  if (delta <= bulk.next - bulk.base)
+  {
+    bulk.base += delta;
+  }
+
+  // go-back-N: 호스트가 구멍을 봤다 -> 확인된 지점부터 다시 보낸다.
+  if (data[2] & BULK_ACK_REWIND)
+  {
+    bulk.next = bulk.base;
+    bulk_stats.rewinds++;
+  }
+  bulk_pump();
+}
+
+static void bulk_on_host_data(uint8_t *data)
+{
+  // data = [ cmd, seq, payload(30) ]
+  if (!bulk.active || !bulk.is_write || bulk.next >= bulk.chunks)
+  {
+    return;
+  }
+
+  if (data[1] != (uint8_t)bulk.next)
+  {
+    // 청크 유실(OUT 큐 오버플로 등). 여기까지 받았다고 알려 호스트가 되감게 한다.
+    if (!bulk.nak_sent)
+    {
+      bulk.nak_sent = true;
+      bulk_stats.rewinds++;
+      bulk_send_ack(BULK_ACK_REWIND);
+    }
+    return;
+  }
+
+  bulk_region_write(bulk.region, bulk.offset + bulk.next * BULK_CHUNK_SIZE, &data[2], bulk_chunk_len(bulk.next));
+  bulk.next++;
+  bulk.nak_sent = false;
+  bulk_stats.chunks++;
+
+  if ((bulk.next - bulk.base) >= bulk.window || bulk.next == bulk.chunks)
+  {
+    bulk.base = bulk.next;
+    bulk_send_ack(0);
+  }
+}
+
+static void bulk_end(uint8_t *data)
+{
+  // data = [ cmd, crc32(4) ] -> [ cmd, status, crc32(4) ]
+  uint32_t host_crc = ((uint32_t)data[1] << 24) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 8) | data[4];
+  uint32_t crc;
+  uint8_t  status = VIA_BULK_OK;
+
+  if (!bulk.active)
+  {
+    data[1] = VIA_BULK_ERR_STATE;
+    return;
+  }
+
+  crc = bulk_region_crc();
+
+  if (bulk.is_write)
+  {
+    if (bulk.next < bulk.chunks)
+    {
+      status = VIA_BULK_ERR_SHORT;
+    }
+    else if (crc != host_crc)
+    {
+      status = VIA_BULK_ERR_CRC;
+      bulk_stats.crc_errors++;
+    }
+  }
+  else if (bulk.base < bulk.chunks)
+  {
+    status = VIA_BULK_ERR_SHORT;
+  }
+
+  bulk_stats.last_bytes = bulk.length;
+  bulk_stats.last_ms    = timer_elapsed32(bulk.start_ms);
+  bulk_close();
+
+  logPrintf("[  ] via bulk: %s %d B, %d ms, status %d\n",
+            bulk.is_write ? "write" : "read", bulk.length, bulk_stats.last_ms, status);
+
+  data[1] = status;
+  data[2] = crc >> 24;
+  data[3] = crc >> 16;
+  data[4] = crc >> 8;
+  data[5] = crc >> 0;
+}
+
+bool via_bulk_command(uint8_t *data, uint8_t length)
+{
+  uint8_t *command_id = &(data[0]);
+
+  switch (*command_id)
+  {
+    case ID_QMK_BULK_INFO:
+      {
+        uint16_t ee_size = bulk_region_size(VIA_BULK_REGION_EEPROM);
+        uint16_t km_size = bulk_region_size(VIA_BULK_REGION_KEYMAP);
+        uint16_t drops   = MIN(via_hid_get_rx_drops(), UINT16_MAX);
+
+        data[1] = VIA_BULK_VERSION;
+        data[2] = BULK_CHUNK_SIZE;
+        data[3] = VIA_BULK_WINDOW_MAX;
+        data[4] = ee_size >> 8;
+        data[5] = ee_size & 0xFF;
+        data[6] = km_size >> 8;
+        data[7] = km_size & 0xFF;
+        data[8] = drops >> 8;
+        data[9] = drops & 0xFF;
+        break;
+      }
+
+    case ID_QMK_BULK_READ:
+      data[1] = bulk_begin(data, false);
+      data[2] = bulk.active ? (bulk.chunks >> 8) : 0;
+      data[3] = bulk.active ? (bulk.chunks & 0xFF) : 0;
+
+      // 응답이 첫 청크보다 먼저 나가야 호스트가 청크 수를 안다.
+      raw_hid_send(data, length);
+      if (bulk.active)
+      {
+        bulk_pump();
+      }
+      return true;
+
+    case ID_QMK_BULK_WRITE:
+      data[1] = bulk_begin(data, true);
+      break;
+
+    // 스트림 패킷은 응답하지 않는다 — 왕복을 없애는 게 이 모드의 요점이다.
+    case ID_QMK_BULK_DATA:
+      bulk_on_host_data(data);
+      return true;
+
+    case ID_QMK_BULK_ACK:
+      bulk_on_host_ack(data);
+      return true;
+
+    case ID_QMK_BULK_END:
+      bulk_end(data);
+      break;
+
+    case ID_QMK_BULK_ABORT:
+      data[1] = bulk.active ? VIA_BULK_OK : VIA_BULK_ERR_STATE;
+      bulk_close();
+      break;
+
+    default:
+      return false;   // 순정 VIA 명령 -> via.c 가 처리
+  }
+
+  raw_hid_send(data, length);
+  return true;
+}
+
+const via_bulk_stats_t *via_bulk_get_stats(void)
+{
+  return &bulk_stats;
+}
+
+#endif   // VIA_ENABLE
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * VIA 벌크 전송 — EEPROM 이미지 / 키맵 범위를 **파이프라인 청크**로 주고받는 확장 채널.
+ *
+ * [왜] 순정 VIA 는 id_dynamic_keymap_get_buffer 한 번에 28B 만 옮기고, 매번 요청→응답 왕복을
+ * 기다린다. 8레이어 키맵(wish65 기준 8*5*16*2 = 1280B)이면 46회 왕복, EEPROM 전체(4KB)면
+ * 147회. 왕복마다 OUT/IN 폴링 간격 + via 처리 + qmkWake() 가 붙는다.
+ * 벌크 모드는 BEGIN 한 번 뒤로 **응답 없이** 청크를 윈도우만큼 연달아 흘리고, 누적 ACK 로만
+ * 흐름을 맞춘다. 끝에 CRC32 로 전체를 한 번 검증한다. 순정 명령과의 처리량 비교는 native_sim `--via-bench`.
+ *
+ * [리포트 크기는 그대로 32B] 리포트 디스크립터(usb_hid.c hid_report_via_desc)를 키우면 순정 VIA
+ * 가 못 붙는다. 대신 헤더를 2B 로 줄여 청크당 30B(순정 28B)를 싣는다.
+ *
+ * [순정 VIA 호환] 아래 명령 ID(0xB0~)는 VIA 프로토콜이 쓰지 않는 영역이다. QMK via.c 의 weak
+ * via_command_kb() 훅(keyboards/.../via_port.c)에서 가로채므로 via.c 는 무수정이고, 순정 VIA 는
+ * 이 명령을 보내지 않으니 동작이 전혀 바뀌지 않는다. 세션 중에 순정 명령이 섞여도 그대로 처리된다.
+ * 같은 훅이 부팅 프로파일(0xB7)·깨어남 회계(0xB8) 조회도 받는다. 훅은 이 명령들만 가로채 true(응답
+ * 송신까지 끝남)를 돌려주고, 나머지는 false 로 via.c 에 넘긴다.
+ *
+ * 프로토콜 (모든 정수는 빅엔디안 — VIA 관례):
+ *   INFO   H->D [B0]                              D->H [B0 ver chunk window_max ee_size(2) km_size(2) rx_drop(2)]
+ *   READ   H->D [B1 region off(2) len(2) window]  D->H [B1 status chunks(2)] + DATA x window
+ *   DATA   D->H [B2 seq payload(30)]             (READ)
+ *          H->D [B2 seq payload(30)]             (WRITE, 응답 없음)
+ *   ACK    H->D [B3 next_seq flags]               (READ: 누적 ACK. flags bit0=rewind -> base 부터 재전송)
+ *          D->H [B3 next_seq flags]               (WRITE: 윈도우마다 / 순서 어긋남 시 rewind)
+ *   WRITE  H->D [B4 region off(2) len(2) window]  D->H [B4 status]
+ *   END    H->D [B5 crc32(4)]                     D->H [B5 status crc32(4)]
+ *   ABORT  H->D [B6]                              D->H [B6 status]
+ *
+ * seq 는 청크 인덱스의 하위 8비트다(윈도우 <= VIA_BULK_WINDOW_MAX 이라 감김이 모호하지 않다).
+ * region: 0 = EEPROM 이미지 전체, 1 = dynamic keymap(offset 은 키맵 시작 기준).
+ * rx_drop: 수신 풀이 비어 버린 리포트 수(via_hid.c, 0xFFFF 에서 포화). 세션 전후로 늘었으면 호스트가 규약보다
+ * 빨리 보낸 것이다 — interrupt OUT 은 NAK 로 못 막으니 드롭을 아는 길은 이것뿐이다.
+ */
+
+#define VIA_BULK_VERSION        1
+#define VIA_BULK_WINDOW_MAX     4       // via_bulk.c / via_hid.c 수신 풀 참고
+
+#define ID_QMK_BULK_INFO        0xB0
+#define ID_QMK_BULK_READ        0xB1
+#define ID_QMK_BULK_DATA        0xB2
+#define ID_QMK_BULK_ACK         0xB3
+#define ID_QMK_BULK_WRITE       0xB4
+#define ID_QMK_BULK_END         0xB5
+#define ID_QMK_BULK_ABORT       0xB6
+
+enum via_bulk_region
+{
+  VIA_BULK_REGION_EEPROM = 0,
+  VIA_BULK_REGION_KEYMAP = 1,
+};
+
+enum via_bulk_status
+{
+  VIA_BULK_OK         = 0,
+  VIA_BULK_ERR_PARAM  = 1,   // region/범위 오류
+  VIA_BULK_ERR_STATE  = 2,   // 세션 없음 / 방향 불일치
+  VIA_BULK_ERR_SHORT  = 3,   // END 시점에 덜 받음
+  VIA_BULK_ERR_CRC    = 4,
+};
+
+typedef struct
+{
+  uint32_t sessions;
+  uint32_t chunks;
+  uint32_t rewinds;
+  uint32_t crc_errors;
+  uint32_t last_bytes;
+  uint32_t last_ms;       // BEGIN ~ END (호스트 왕복 포함)
+} via_bulk_stats_t;
+
+// via_command_kb() 에서 호출. 벌크 명령이면 처리(응답 송신 포함)하고 true.
+bool via_bulk_command(uint8_t *data, uint8_t length);
+
+const via_bulk_stats_t *via_bulk_get_stats(void);
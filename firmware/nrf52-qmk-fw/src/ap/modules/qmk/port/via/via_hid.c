@@ -1,31 +1,310 @@
 #include "via_hid.h"
+#include "via_bulk.h"
 #include "raw_hid.h"
 #include "usb_hid/usb_hid.h"
+#include "ble.h"
+#include "eeprom.h"
 #include "qmk/qmk.h"
+#include "cli.h"
+#include "micros.h"
+#include <zephyr/sys/atomic.h>
+#include <zephyr/net_buf.h>
 
 /*
- * VIA raw HID 브릿지 (usb_hid ↔ QMK via.c).
- *  - 수신: usb_hid VIA OUT 리포트 → via_hid_receive → QMK raw_hid_receive(via.c 처리)
- *  - 송신: QMK raw_hid_send → usb_hid VIA IN 리포트
+ * VIA raw HID 브릿지 (usb_hid / ble ↔ QMK via.c).
+ *  - 수신: usb_hid VIA OUT 리포트 / BLE VIA output 리포트 → 풀 버퍼에 복사 → 링 → qmkWake()
+ *  - 처리: **메인 루프**의 via_hid_task()(qmkUpdate 안) → QMK raw_hid_receive
+ *  - 송신: QMK raw_hid_send → 요청이 들어온 통로로 (USB VIA IN 리포트 / BLE VIA input 리포트)
+ *
+ * [왜 메인 루프에서 처리하나] raw_hid_receive 는 dynamic_keymap / eeconfig / rgb_matrix 를
+ * 고친다. 예전처럼 별도 스레드(via_process_thread, prio 6)에서 돌리면 같은 상태를 keyboard_task()
+ * 가 락 없이 읽는 중에 바뀐다 — 예: 키맵 쓰기 도중의 키코드를 읽거나, rgb_matrix 가 렌더링 중에
+ * 모드가 바뀐다. QMK 코어는 단일 스레드 전제라 락을 넣을 자리도 없다. 처리 지점을 루프의 한 곳으로
+ * 모으면 경쟁 자체가 사라지고, 그 스레드 스택(2KB)도 없어진다.
+ *
+ * [수신 버퍼 — 한 번만 복사] 리포트는 공유 풀(via_rx_pool, 32B x VIA_RX_BUFS, refcount 를 가진
+ * net_buf)에 **수신 콜백에서 한 번** 복사되고, 그 뒤로는 포인터만 움직인다. 소비자는 풀 버퍼 안에서
+ * 바로 처리하고 unref 한다. USB OUT 버퍼(UDC 소유)는 콜백이 끝나면 재사용되고 BLE rep->data 는
+ * 다음 write 가 덮으므로 그 복사 하나는 피할 수 없다 — 예전의 스택 버퍼/msgq/스레드 복사 3단은 없다.
+ *
+ * 통로별 링은 버퍼 **포인터**만 담는 SPSC 링이다. 생산자는 통로마다 하나(USB 스택 컨텍스트 / BT RX
+ * 스레드), 소비자는 메인 루프 하나라 락이 필요 없다. head 는 생산자만, tail 은 소비자만 쓴다.
+ * 링 깊이 = 풀 크기라 링은 넘치지 않는다 — 한도는 풀 하나다.
+ *
+ * [풀이 빌 때] 콜백 컨텍스트라 기다릴 수 없다. 수신 콜백이 false 를 돌려주고 통로별로 센다.
+ * USB SET_REPORT 경로는 그걸 에러로 돌려 호스트가 실패를 보게 하지만, interrupt OUT 경로는
+ * usbd_next HID 클래스가 콜백 반환 직후 OUT 을 다시 arm 하므로 NAK 로 멈춰 세울 방법이 없다.
+ * 대신 흐름 제어는 프로토콜 쪽에 있다: 순정 VIA 는 요청→응답 1:1 이고, 벌크 WRITE 의 윈도우
+ * (VIA_BULK_WINDOW_MAX 4)는 풀(8)보다 작다. 규약대로 도는 호스트는 풀을 못 채우고, 그래도 빠지면
+ * 벌크 DATA 는 seq 구멍 -> rewind 로 복구된다.
+ *
+ * [시간 예산] VIA 버스트(키맵 로드 = 수십~수백 명령)가 한 회차에 다 처리되면 그만큼 키 처리가
+ * 늦는다. 회차당 VIA_TASK_BUDGET_US 를 넘기면 나머지는 다음 회차로 미루고 루프를 다시 깨운다.
+ * 명령 하나는 미러 접근뿐이라 수 µs — 예산은 QMK_TASK_PERIOD_MS(2ms)의 절반으로 잡았다.
+ *
+ * 응답은 **마지막 요청이 온 통로**로 나간다. USB 와 BLE 양쪽에서 동시에 VIA 를 여는 경우는
+ * 다루지 않는다(한 사용자가 한 번에 하나의 VIA 창을 쓴다).
  */
 
-// 호스트→디바이스 32바이트. usb_hid 가 OUT 리포트 수신 시 호출.
-static void via_hid_receive(uint8_t *data, uint8_t length)
+// BLE 는 명령 사이 간격이 USB 보다 길다 — 편집 버스트를 flush 1회로 묶으려면 settle 을 늘린다.
+#define VIA_BLE_FLUSH_DELAY_MS    500
+
+#define VIA_REPORT_SIZE           32
+#define VIA_RX_BUFS               8       // 2의 거듭제곱 — 링 깊이와 같다
+#define VIA_TASK_BUDGET_US        1000
+
+/*
+ * 소비자 단계 사이의 선점 자리 — 실보드에선 비어 있다. native_sim 은 코드가 도는 동안 시각이 안 흘러
+ * 수신 콜백이 소비자 한가운데 끼어들 수 없으므로, --via-stress 가 여기서 시각을 흘려(k_busy_wait)
+ * 타이머 ISR 생산자가 실보드의 USB 스택 스레드처럼 선점하게 한다(src/sim/via_stress.c).
+ */
+#ifdef CONFIG_ARCH_POSIX
+void simViaRacePoint(void);
+#define VIA_RX_RACE_POINT()       simViaRacePoint()
+#else
+#define VIA_RX_RACE_POINT()
+#endif
+
+BUILD_ASSERT((VIA_RX_BUFS & (VIA_RX_BUFS - 1)) == 0, "VIA_RX_BUFS must be a power of 2");
+BUILD_ASSERT(VIA_RX_BUFS > VIA_BULK_WINDOW_MAX, "bulk window must fit in the rx pool");
+
+enum
+{
+  VIA_HID_USB = 0,
+  VIA_HID_BLE,
+  VIA_HID_MAX,
+};
+
+typedef struct
+{
+  struct net_buf *buf[VIA_RX_BUFS];
+  atomic_t        head;      // 생산자만 쓴다
+  atomic_t        tail;      // 소비자(메인 루프)만 쓴다
+  atomic_t        nobuf;        // 풀이 비어 받지 못한 리포트 — 생산자가 올리고 메인 루프/CLI 가 읽고 지운다
+  uint32_t        nobuf_seen;   // 메인 루프가 마지막으로 본 nobuf — 늘었으면 알린다(메인 루프만 쓴다)
+} via_rx_ring_t;
+
+NET_BUF_POOL_FIXED_DEFINE(via_rx_pool, VIA_RX_BUFS, VIA_REPORT_SIZE, 0, NULL);
+
+static via_rx_ring_t rx_ring[VIA_HID_MAX];
+static uint8_t       via_transport = VIA_HID_USB;
+
+static uint32_t      stat_rx;
+static uint32_t      stat_deferred;   // 예산을 넘겨 다음 회차로 미룬 횟수
+static uint32_t      stat_max_us;     // 한 회차 최장 처리 시간
+
+#if CLI_USE(HW_VIA)
+static void cliVia(cli_args_t *args);
+#endif
+
+
+static bool via_rx_put(uint8_t transport, const uint8_t *data, uint8_t length)
+{
+  via_rx_ring_t  *r    = &rx_ring[transport];
+  atomic_val_t    head = atomic_get(&r->head);
+  struct net_buf *buf;
+
+  buf = net_buf_alloc(&via_rx_pool, K_NO_WAIT);
+  if (buf == NULL)
+  {
+    atomic_inc(&r->nobuf);
+    return false;
+  }
+
+  if (length > VIA_REPORT_SIZE)
+  {
+    length = VIA_REPORT_SIZE;
+  }
+  net_buf_add_mem(buf, data, length);
+  memset(net_buf_add(buf, VIA_REPORT_SIZE - length), 0, VIA_REPORT_SIZE - length);
+
+  // 풀에서 버퍼를 받았으면 링에도 자리가 있다(깊이 = 풀 크기).
+  r->buf[head & (VIA_RX_BUFS - 1)] = buf;
+  atomic_set(&r->head, head + 1);   // 슬롯을 다 쓴 뒤에 공개
+
+  // 처리는 메인 루프가 한다. 자고 있으면 깨운다(세마포어 한도 1 — 버스트 중 여러 번 줘도 1회).
+  qmkWake(WAKE_REASON_VIA);
+  return true;
+}
+
+// 호스트→디바이스 32바이트. usb_hid 가 OUT 리포트 수신 시 **USB 스택 컨텍스트에서** 호출.
+static bool via_hid_receive_usb(uint8_t *data, uint8_t length)
+{
+  return via_rx_put(VIA_HID_USB, data, length);
+}
+
+// ble.c 가 BT RX 스레드에서 호출.
+static bool via_hid_receive_ble(uint8_t *data, uint8_t length)
+{
+  return via_rx_put(VIA_HID_BLE, data, length);
+}
+
+/*
+ * 풀이 비어 버린 리포트를 알린다. 수신 콜백은 USB 스택 / BT RX 컨텍스트라 거기서 로그를 찍지 않고,
+ * 메인 루프가 카운터가 늘어난 걸 보고 **처음 한 번만** 남긴다(버스트마다 줄이 쏟아지지 않게).
+ * 개수는 `via queue` 와 벌크 INFO 응답(via_hid_get_rx_drops)으로 본다 — 콘솔 없는 빌드에서도 호스트가 안다.
+ * `via queue clear` 는 nobuf 만 0 으로 만든다 — 여기서 줄어든 걸 보고 nobuf_seen 을 따라 내리고, 다음 드롭을 다시 알린다.
+ */
+static void via_rx_drop_check(void)
+{
+  for (uint8_t t = 0; t < VIA_HID_MAX; t++)
+  {
+    via_rx_ring_t *r     = &rx_ring[t];
+    uint32_t       nobuf = (uint32_t)atomic_get(&r->nobuf);
+
+    if (nobuf == r->nobuf_seen)
+    {
+      continue;
+    }
+    if (r->nobuf_seen == 0 && nobuf > 0)
+    {
+      logPrintf("[E_] via %s : rx pool empty, report dropped (via queue)\n", t == VIA_HID_USB ? "usb" : "ble");
+    }
+    r->nobuf_seen = nobuf;
+  }
+}
+
+uint32_t via_hid_get_rx_drops(void)
+{
+  return (uint32_t)atomic_get(&rx_ring[VIA_HID_USB].nobuf) + (uint32_t)atomic_get(&rx_ring[VIA_HID_BLE].nobuf);
+}
+
+// 메인 루프(qmkUpdate)에서 호출. 예산 안에서 양쪽 링을 번갈아 비운다.
+void via_hid_task(void)
 {
-  raw_hid_receive(data, length);
+  uint32_t start = micros();
+  bool     more  = true;
+
+  via_rx_drop_check();
+
+  while (more)
+  {
+    more = false;
+
+    for (uint8_t t = 0; t < VIA_HID_MAX; t++)
+    {
+      via_rx_ring_t  *r    = &rx_ring[t];
+      atomic_val_t    tail = atomic_get(&r->tail);
+      struct net_buf *buf;
+
+      VIA_RX_RACE_POINT();
+      if (tail == atomic_get(&r->head))
+      {
+        continue;
+      }
+      VIA_RX_RACE_POINT();
+
+      via_transport = t;
+      if (t == VIA_HID_BLE)
+      {
+        eeprom_set_flush_delay(VIA_BLE_FLUSH_DELAY_MS);
+      }
 
-  // VIA 명령이 RGB 등 상태를 바꿨을 수 있다. 메인 루프가 idle 로 잠들어 있으면 그 변화가
-  // 반영되지 않으므로(rgb_matrix_task 가 안 돎 -> 불이 안 들어옴) 깨워준다.
-  qmkWake();
+      // 풀 버퍼 안에서 바로 처리한다. raw_hid_receive 가 응답을 같은 버퍼에 쓰고 raw_hid_send 로
+      // 보내는데, 송신 쪽(usb_tx_q / bt_gatt_notify)이 값을 복사하므로 여기서 unref 해도 된다.
+      buf = r->buf[tail & (VIA_RX_BUFS - 1)];
+      VIA_RX_RACE_POINT();
+      atomic_set(&r->tail, tail + 1);
+      VIA_RX_RACE_POINT();
+
+      raw_hid_receive(buf->data, VIA_REPORT_SIZE);
+      VIA_RX_RACE_POINT();
+      net_buf_unref(buf);
+
+      stat_rx++;
+      more = true;
+    }
+
+    if (more && (micros() - start) >= VIA_TASK_BUDGET_US)
+    {
+      // 남은 건 다음 회차에. 루프가 idle 로 잠들지 않도록 깨워 둔다.
+      stat_deferred++;
+      qmkWake(WAKE_REASON_VIA);
+      break;
+    }
+  }
+
+  uint32_t elapsed = micros() - start;
+  if (elapsed > stat_max_us)
+  {
+    stat_max_us = elapsed;
+  }
 }
 
 void via_hid_init(void)
 {
-  usbHidSetViaReceiveFunc(via_hid_receive);
+  usbHidSetViaReceiveFunc(via_hid_receive_usb);
+  bleSetViaReceiveFunc(via_hid_receive_ble);
+
+#if CLI_USE(HW_VIA)
+  cliAdd("via", cliVia);
+#endif
 }
 
 // QMK via.c 가 응답을 보낼 때 호출. 디바이스→호스트 VIA IN 전송.
 void raw_hid_send(uint8_t *data, uint8_t length)
 {
-  usbHidSendReportVia(data, length);
+  if (via_transport == VIA_HID_BLE)
+  {
+    bleSendVia(data, length);
+  }
+  else
+  {
+    usbHidSendReportVia(data, length);
+  }
+}
+
+
+#if CLI_USE(HW_VIA)
+void cliVia(cli_args_t *args)
+{
+  bool ret = false;
+
+  // 호스트 벤치마크 대신 — 호스트 도구로 한 번 받아 본 뒤 여기서 소요 시간을 본다.
+  if (args->argc == 1 && args->isStr(0, "bulk"))
+  {
+    const via_bulk_stats_t *st = via_bulk_get_stats();
+
+    cliPrintf("sessions   : %d\n", st->sessions);
+    cliPrintf("chunks     : %d\n", st->chunks);
+    cliPrintf("rewinds    : %d\n", st->rewinds);
+    cliPrintf("crc errors : %d\n", st->crc_errors);
+    cliPrintf("last       : %d B, %d ms", st->last_bytes, st->last_ms);
+    if (st->last_ms > 0)
+    {
+      cliPrintf(" (%d B/s)", st->last_bytes * 1000 / st->last_ms);
+    }
+    cliPrintf("\n");
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "queue"))
+  {
+    cliPrintf("processed  : %d\n", stat_rx);
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+    cliPrintf("pool       : %d/%d free\n", atomic_get(&via_rx_pool.avail_count), VIA_RX_BUFS);
+#endif
+    cliPrintf("no buf     : usb %d, ble %d\n", (int)atomic_get(&rx_ring[VIA_HID_USB].nobuf),
+              (int)atomic_get(&rx_ring[VIA_HID_BLE].nobuf));
+    cliPrintf("deferred   : %d (budget %d us)\n", stat_deferred, VIA_TASK_BUDGET_US);
+    cliPrintf("max        : %d us/loop\n", stat_max_us);
+    ret = true;
+  }
+
+  if (args->argc == 2 && args->isStr(0, "queue") && args->isStr(1, "clear"))
+  {
+    stat_rx       = 0;
+    stat_deferred = 0;
+    stat_max_us   = 0;
+    atomic_set(&rx_ring[VIA_HID_USB].nobuf, 0);   // nobuf_seen 은 메인 루프가 따라 내린다(via_rx_drop_check)
+    atomic_set(&rx_ring[VIA_HID_BLE].nobuf, 0);
+    ret = true;
+  }
+
+  if (ret == false)
+  {
+    cliPrintf("via bulk\n");
+    cliPrintf("via queue [clear]\n");
+  }
 }
+#endif
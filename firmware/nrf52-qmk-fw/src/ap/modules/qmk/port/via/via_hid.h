@@ -2,5 +2,11 @@
 
 #include <stdint.h>
 
-// VIA raw HID 브릿지. Phase 3 에서 usb_hid VIA out-report 콜백과 연결한다.
+// VIA raw HID 브릿지. usb_hid / ble 의 VIA 수신 콜백과 연결한다.
 void via_hid_init(void);
+
+// 수신 링에 쌓인 VIA 명령을 처리한다(응답 송신 포함). qmkUpdate() 에서 keyboard_task() 전에.
+void via_hid_task(void);
+
+// 수신 풀이 비어 버린 리포트 수(USB + BLE, 부팅 후 누적 — `via queue clear` 로 0).
+uint32_t via_hid_get_rx_drops(void);
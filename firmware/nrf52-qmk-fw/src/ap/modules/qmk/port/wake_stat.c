@@ -0,0 +1,166 @@
+#include "wake_stat.h"
+#include "hw_def.h"
+#include "cli.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <string.h>
+
+#if CLI_USE(HW_WAKE)
+static void cliWake(cli_args_t *args);
+#endif
+
+static const char *reason_name[WAKE_REASON_MAX] = {
+  "key", "host led", "via", "rgb ready", "usb", "tick", "activity", "eeprom", "rgb frame", "tapping", "combo", "tap dance", "ble", "other",
+};
+
+static wake_stat_t   stat_tbl[WAKE_REASON_MAX];
+static atomic_t      pending        = ATOMIC_INIT(0);   // 비트 = wake_reason_t, 깨우는 쪽이 세운다
+static atomic_t      clear_req      = ATOMIC_INIT(0);
+static wake_reason_t deadline       = WAKE_REASON_OTHER;
+static wake_reason_t cur_reason     = WAKE_REASON_OTHER;   // 지금 깨어 있는 이유(시간을 붙일 곳)
+static uint32_t      wake_us        = 0;
+static uint32_t      clear_ms       = 0;
+
+
+bool wakeStatInit(void)
+{
+  wake_us  = micros();
+  clear_ms = millis();
+
+#if CLI_USE(HW_WAKE)
+  cliAdd("wake", cliWake);
+#endif
+  return true;
+}
+
+void wakeStatPost(wake_reason_t reason)
+{
+  atomic_or(&pending, BIT(reason));
+}
+
+void wakeStatSetDeadline(wake_reason_t reason)
+{
+  deadline = reason;
+}
+
+void wakeStatEnterSleep(void)
+{
+  uint32_t     active_us = micros() - wake_us;
+  wake_stat_t *p_stat    = &stat_tbl[cur_reason];
+
+  // 초기화는 여기서만 한다 — 통계를 쓰는 건 메인 스레드뿐이라 잠금이 필요 없다.
+  if (atomic_clear(&clear_req))
+  {
+    memset(stat_tbl, 0, sizeof(stat_tbl));
+    clear_ms = millis();
+    return;
+  }
+
+  p_stat->active_us += active_us;
+  if (active_us > p_stat->max_us)
+  {
+    p_stat->max_us = active_us;
+  }
+}
+
+void wakeStatExitSleep(bool timed_out)
+{
+  atomic_val_t bits = atomic_clear(&pending);
+
+  wake_us = micros();
+
+  if (timed_out)
+  {
+    // 타임아웃은 잠든 동안 아무도 깨우지 않았다는 뜻이다. 그 사이 세워진 비트(k_msleep 중 키 입력 등)는
+    // 세마포어에 남아 다음 잠을 바로 끝내므로, 그때 세도록 되돌려 둔다.
+    if (bits != 0)
+    {
+      atomic_or(&pending, bits);
+    }
+    cur_reason = deadline;
+    stat_tbl[cur_reason].count++;
+    return;
+  }
+
+  if (bits == 0)
+  {
+    cur_reason = WAKE_REASON_OTHER;
+    stat_tbl[cur_reason].count++;
+    return;
+  }
+
+  cur_reason = (wake_reason_t)(__builtin_ctz((uint32_t)bits));
+  for (uint8_t i = 0; i < WAKE_REASON_MAX; i++)
+  {
+    if (bits & BIT(i))
+    {
+      stat_tbl[i].count++;
+    }
+  }
+}
+
+const wake_stat_t *wakeStatGet(wake_reason_t reason)
+{
+  return &stat_tbl[reason < WAKE_REASON_MAX ? reason : WAKE_REASON_OTHER];
+}
+
+const char *wakeStatGetName(wake_reason_t reason)
+{
+  return reason < WAKE_REASON_MAX ? reason_name[reason] : "?";
+}
+
+uint32_t wakeStatGetElapsedMs(void)
+{
+  return millis() - clear_ms;
+}
+
+void wakeStatClear(void)
+{
+  atomic_set(&clear_req, 1);
+}
+
+
+#if CLI_USE(HW_WAKE)
+void cliWake(cli_args_t *args)
+{
+  bool ret = false;
+
+  if (args->argc == 1 && args->isStr(0, "info"))
+  {
+    uint32_t elapsed_ms = wakeStatGetElapsedMs();
+    uint32_t total_cnt  = 0;
+    uint64_t total_us   = 0;
+
+    cliPrintf("reason       count   active ms    avg us    max us\n");
+    for (uint8_t i = 0; i < WAKE_REASON_MAX; i++)
+    {
+      const wake_stat_t *p_stat = &stat_tbl[i];
+
+      cliPrintf("%-10s %7d %11d %9d %9d\n", reason_name[i], p_stat->count, (uint32_t)(p_stat->active_us / 1000),
+                p_stat->count ? (uint32_t)(p_stat->active_us / p_stat->count) : 0, p_stat->max_us);
+      total_cnt += p_stat->count;
+      total_us  += p_stat->active_us;
+    }
+    cliPrintf("elapsed    : %d ms, %d wakeups (%d/s)\n", elapsed_ms, total_cnt,
+              elapsed_ms ? (uint32_t)((uint64_t)total_cnt * 1000 / elapsed_ms) : 0);
+    // 깨어 있던 비율(0.01% 단위) — 활성 전류 x 이 비율이 평균 전류에 더해지는 몫이다.
+    uint32_t awake_bp = elapsed_ms ? (uint32_t)(total_us * 10 / elapsed_ms) : 0;
+    cliPrintf("awake      : %d.%02d %%\n", awake_bp / 100, awake_bp % 100);
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "clear"))
+  {
+    wakeStatClear();
+    cliPrintf("cleared (다음 잠들 때 반영)\n");
+    ret = true;
+  }
+
+  if (ret == false)
+  {
+    cliPrintf("wake info\n");
+    cliPrintf("wake clear\n");
+  }
+}
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 깨어남 회계 — 메인 루프가 **왜** 깼고 깨어서 **얼마나** 일했는지를 이유별로 모은다.
+ *
+ * 배터리 수명은 "얼마나 자주, 얼마나 오래 깨어 있나" 로 정해지는데, PPK2 파형은 스파이크가
+ * 있다는 것만 보여 주고 그게 무엇 때문인지는 안 보여 준다(§6.8 의 LED write 를 찾는 데 하루가 걸렸다).
+ * 깨우는 쪽이 이유를 남기고, 메인 루프가 잠들 때 그 구간을 이유에 붙인다.
+ *
+ *   깨우는 쪽   : qmkWake(reason) / 매트릭스 콜백 -> wakeStatPost(reason) 가 비트를 세운다
+ *   타임아웃    : qmkGetIdleWaitMs() 가 어느 데드라인이 이겼는지 wakeStatSetDeadline() 으로 남긴다
+ *   메인 루프   : 잠들기 직전 wakeStatEnterSleep(), 깨자마자 wakeStatExitSleep()
+ *
+ * 한 번 깼을 때 이유가 여럿이면(키 + LED 리포트가 같은 틈에) 횟수는 **각각** 세고, 깨어 있던
+ * 시간은 enum 순서상 **맨 앞** 이유 하나에 붙인다 — 합계가 실제 깨어 있던 시간과 같아야 해서다.
+ *
+ * "깨어 있던 시간" 은 메인 스레드가 깨서 다시 잠들 때까지의 벽시계 시간이다. 그 사이 BT/USB
+ * 스레드가 끼어들면 그것도 들어간다 — 그래도 그 시간 동안 CPU 가 깨어 있었던 건 맞다.
+ * 반대로 메인 루프가 자는 동안 BT 스택만 깨는 것(연결 이벤트)은 여기 안 잡힌다.
+ */
+
+typedef enum
+{
+  WAKE_REASON_KEY = 0,     // 매트릭스 엣지
+  WAKE_REASON_HOST_LED,    // 호스트 LED 리포트(USB/BLE)
+  WAKE_REASON_VIA,         // VIA 수신 / 예산 초과로 남긴 명령
+  WAKE_REASON_RGB_READY,   // RGB 레일 안정 -> 첫 프레임
+  WAKE_REASON_USB,         // USB SUSPEND/RESUME
+  WAKE_REASON_TICK,        // 활성 구간 주기(QMK_TASK_PERIOD_MS) — 키가 눌려 있거나 디바운스 정착 전
+  WAKE_REASON_ACTIVITY,    // activity 데드라인(idle/RGB 소등/sleep 판정)
+  WAKE_REASON_EEPROM,      // EEPROM settle-flush 데드라인
+  WAKE_REASON_RGB_FRAME,   // RGB 애니메이션 프레임 데드라인
+  WAKE_REASON_TAPPING,     // 탭/홀드 판정 데드라인(TAPPING_TERM)
+  WAKE_REASON_COMBO,       // 콤보 판정 데드라인(COMBO_TERM)
+  WAKE_REASON_TAP_DANCE,   // 탭댄스 판정 데드라인(항목별 term)
+  WAKE_REASON_BLE,         // BT 스택 준비(본딩 로드 끝) -> bleUpdate()
+  WAKE_REASON_OTHER,       // 이유가 안 남은 깨어남(세마포어에 남아 있던 몫 등)
+  WAKE_REASON_MAX,
+} wake_reason_t;
+
+typedef struct
+{
+  uint32_t count;
+  uint32_t max_us;      // 한 번 깨었을 때 가장 오래 일한 시간
+  uint64_t active_us;
+} wake_stat_t;
+
+bool               wakeStatInit(void);
+
+// 깨우는 쪽(ISR/다른 스레드 가능): 세마포어를 주기 **전에** 부른다.
+void               wakeStatPost(wake_reason_t reason);
+
+// 다음 잠의 타임아웃이 어떤 데드라인인지. 타임아웃으로 깨면 이 이유로 센다.
+void               wakeStatSetDeadline(wake_reason_t reason);
+
+// 메인 스레드 전용.
+void               wakeStatEnterSleep(void);
+void               wakeStatExitSleep(bool timed_out);
+
+const wake_stat_t *wakeStatGet(wake_reason_t reason);
+const char        *wakeStatGetName(wake_reason_t reason);
+uint32_t           wakeStatGetElapsedMs(void);   // 마지막 초기화 이후
+
+// 다음에 잠들 때 0 으로 되돌린다(메인 루프가 하므로 CLI/VIA 어느 스레드에서 불러도 된다).
+void               wakeStatClear(void);
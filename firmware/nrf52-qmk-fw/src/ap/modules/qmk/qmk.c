@@ -8,18 +8,40 @@
 #include "via_hid.h"
 #include "via_port.h"
 #include "port/activity.h"
+#include "port/tapping/tapping_port.h"
+#include "port/deadline.h"
+#ifdef COMBO_ENABLE
+#include "port/combo/combo_port.h"
+#endif
+#include "port/key_override/key_override_port.h"
+#include "port/layer/layer_cache.h"
+#include "port/mousekey_port.h"
+#ifdef TAP_DANCE_ENABLE
+#include "port/tap_dance/tap_dance_port.h"
+#endif
 #ifdef RGB_MATRIX_ENABLE
 #include "rgb_matrix.h"
+#include "port/rgb_governor.h"
+#include "port/rgb_matrix/rgb_reactive.h"
+#include "port/rgb_indicator.h"
 #endif
+#include "ws2812.h"
 #include "ble.h"
 #include "cli.h"
 #include "usb_hid/usb_hid.h"
+#include "boot_prof.h"
 
 // 출력 드라이버 2종. 전환은 host_set_driver() 로만 이뤄진다(QMK 네이티브 outputselect).
 extern host_driver_t usb_driver;   // port/driver_usb.c
 extern host_driver_t ble_driver;   // port/driver_ble.c
 
 static host_driver_t *cur_driver = NULL;
+static uint32_t       loop_count = 0;   // qmkUpdate() 회차 — qmkGetLoopCount()
+
+static uint32_t qmk_eeprom_wait_ms(void);
+#ifdef RGB_MATRIX_ENABLE
+static uint32_t qmk_rgb_wait_ms(void);
+#endif
 
 // USB 가 붙어있으면 USB, 아니면 BLE(연결 시). 전환 시 직전 드라이버로 빈 리포트를 보내
 // stuck key 를 방지한다.
@@ -47,8 +69,7 @@ static void output_select_task(void)
 
   if (cur_driver != NULL)
   {
-    report_keyboard_t empty = {0};
-    (*cur_driver->send_keyboard)(&empty);   // 이전 transport 의 눌림 상태 해제
+    host_keyboard_flush();   // 이전 transport 의 눌림 상태 해제 — 중복 검사 없이 항상 나간다
   }
 
   host_set_driver(want);
@@ -90,7 +111,7 @@ static void qmk_usb_suspend_cb(bool s)
    * last_activity_ms 는 건드리지 않는다(qmkWake 의 계약) — USB 연결은 사용자 입력이 아니므로
    * idle/sleep 타이머를 리셋하면 안 된다.
    */
-  qmkWake();
+  qmkWake(WAKE_REASON_USB);
 }
 
 /*
@@ -148,73 +169,189 @@ void qmkSuspendUpdate(void)
   }
 }
 
+// 드라이버 콜백은 인자가 없다 — 이유를 붙여 넘기는 얇은 자리.
+static void qmk_wake_host_led(void)
+{
+  qmkWake(WAKE_REASON_HOST_LED);
+}
+
+#if defined(RGB_MATRIX_ENABLE) && defined(_USE_HW_WS2812)
+static void qmk_wake_rgb_ready(void)
+{
+  qmkWake(WAKE_REASON_RGB_READY);
+}
+#endif
+
+/*
+ * [부팅 순서 — 빠른 첫 키] System OFF 웨이크 = 리셋 부팅이라 여기가 잠든 키보드의 첫 키 지연이다
+ * (단계별 시간은 CLI `boot info`, driver/boot_prof.c).
+ *
+ * 매트릭스/키맵(keyboard_init)을 **BLE 보다 먼저** 세운다. bleInit() 은 이제 서비스 등록만 하고
+ * bt_enable + 본딩 로드(settings_load, NVS 스캔)는 시스템 워크큐로 넘긴다(광고 시작은 그 뒤
+ * bleUpdate()) — HCI 응답을 기다리는 동안 메인 루프가 돌아 USB 로는 첫 키가 바로 나간다. BLE 가 준비되기 전엔 bleIsConnected() 가
+ * false 라 output_select_task() 가 알아서 기다린다.
+ *
+ * eeprom_init() 은 앞에 남는다. keyboard_init() 의 eeconfig 가 미러를 읽으므로 늦출 수 없다
+ * (키맵도 같은 미러에서 바로 읽혀 따로 채울 캐시가 없다).
+ */
 bool qmkInit(void)
 {
+  wakeStatInit();
   eeprom_init();
+  bootProfMark(BOOT_PROF_EEPROM);
   via_hid_init();
 
-  bleInit();
-
   // 기본은 USB. 연결 상태에 따라 output_select_task() 가 전환한다.
+  host_init();
   host_set_driver(&usb_driver);
   cur_driver = &usb_driver;
 
   keyboard_setup();
   keyboard_init();
+  bootProfMark(BOOT_PROF_MATRIX);
+
+  bleInit();   // BT 스택은 비동기로 올라온다
 
   activityInit();
-  viaPortInit();
+  tapping_port_init();
+
+  // idle 데드라인 출처 — qmkGetIdleWaitMs() 가 가장 이른 것까지 잔다(port/deadline.h).
+  deadline_register(WAKE_REASON_ACTIVITY, activityGetWaitMs);
+  deadline_register(WAKE_REASON_EEPROM,   qmk_eeprom_wait_ms);
+  deadline_register(WAKE_REASON_TAPPING,  tapping_port_wait_ms);
+#ifdef COMBO_ENABLE
+  combo_port_init();   // 키맵 콤보 표로 후보 인덱스를 만든다
+  deadline_register(WAKE_REASON_COMBO,    combo_port_wait_ms);
+#endif
+  key_override_port_init();   // 키맵 key_overrides 로 트리거 인덱스를 만든다
+  layer_cache_init();         // 키별 유효 레이어 표는 첫 조회 때 만든다
+  mousekey_port_init();       // 마우스키 반복/틱을 transport 주기에 맞춘다
+#ifdef TAP_DANCE_ENABLE
+  deadline_register(WAKE_REASON_TAP_DANCE, tap_dance_port_wait_ms);
+#endif
+
+  viaPortInit();   // 동적 표(콤보/탭댄스/키 오버라이드)를 위 엔진들에 넘긴다 — 그래서 그 뒤에
+#ifdef RGB_MATRIX_ENABLE
+  rgb_governor_init();
+  deadline_register(WAKE_REASON_RGB_FRAME, qmk_rgb_wait_ms);
+#ifdef _USE_HW_WS2812
+  ws2812SetReadyFunc(qmk_wake_rgb_ready);   // RGB 레일이 안정됨 -> 기다리던 첫 프레임을 보내도록 깨움
+#endif
+#endif
 
   usbSetSuspendFunc(qmk_usb_suspend_cb);   // 호스트 PC 가 자면 RGB 소등
-  usbHidSetKbdLedFunc(qmkWake);            // LED 리포트 도착 -> led_task 가 돌도록 깨움   // EEPROM 에 저장된 전력 설정을 activity 에 적용 (activityInit 뒤여야 한다)
+  usbHidSetKbdLedFunc(qmk_wake_host_led);  // LED 리포트 도착 -> led_task 가 돌도록 깨움   // EEPROM 에 저장된 전력 설정을 activity 에 적용 (activityInit 뒤여야 한다)
 
   logPrintf("[OK] qmkInit()\n");
   logPrintf("     MATRIX %d x %d, DEBOUNCE %d\n", MATRIX_ROWS, MATRIX_COLS, DEBOUNCE);
+
+  bootProfMark(BOOT_PROF_QMK);
+  logPrintf("[  ] %s boot %d us (eeprom %d us, keyboard %d us)\n", KBD_NAME, bootProfGetUs(BOOT_PROF_QMK),
+            bootProfGetUs(BOOT_PROF_EEPROM), bootProfGetUs(BOOT_PROF_MATRIX));
   return true;
 }
 
-uint32_t qmkGetIdleWaitMs(void)
+#ifdef RGB_MATRIX_ENABLE
+/*
+ * 정적 효과가 이미 스트립에 떠 있으면 RGB 때문에 깨어날 이유가 없다.
+ *
+ * 두 조건을 다 본다:
+ *  1) 효과가 **시간에 의존하지 않는다** — 아래 목록은 rgb_matrix_config(hsv/speed)와 LED 좌표만
+ *     읽는다. 설정이 바뀌는 길(키 입력 / VIA)은 어차피 루프를 깨운다.
+ *  2) 마지막 flush 가 **같은 프레임이라 건너뛰어졌다**(ws2812 프레임 차분). 모드/색을 바꾼 직후엔
+ *     새 프레임이 한 번 나가야 하므로, 그 다음 프레임이 같다는 걸 확인한 뒤에야 잠든다.
+ * 시간 의존 효과(브리딩 등)는 여기 넣지 않는다 — 넣으면 멈춘다. 그쪽은 SPI 전송만 차분이 줄인다.
+ */
+static bool qmk_rgb_is_static(void)
 {
-  uint32_t wait_ms = activityGetWaitMs();
-
-  /*
-   * EEPROM 에 아직 안 쓴 변경이 있으면 오래 자면 안 된다.
-   * settle-flush 는 "마지막 쓰기 후 EE_FLUSH_DELAY_MS 조용하면 flush" 인데, 그 판정을
-   * eeprom_task() 가 한다 → 루프가 자면 flush 도 멈춘다. VIA 저장 직후 루프가 수십 초
-   * 블록해버려 그 사이 전원이 꺼지면 유실된다(실제로 겪음).
-   */
-  if (eeprom_is_dirty())
+#ifdef _USE_HW_WS2812
+  switch (rgb_matrix_get_mode())
   {
-    if (wait_ms == 0 || wait_ms > EEPROM_FLUSH_WAIT_MS)
-    {
-      wait_ms = EEPROM_FLUSH_WAIT_MS;
-    }
+    case RGB_MATRIX_SOLID_COLOR:
+#ifdef ENABLE_RGB_MATRIX_GRADIENT_UP_DOWN
+    case RGB_MATRIX_GRADIENT_UP_DOWN:
+#endif
+#ifdef ENABLE_RGB_MATRIX_GRADIENT_LEFT_RIGHT
+    case RGB_MATRIX_GRADIENT_LEFT_RIGHT:
+#endif
+      return ws2812IsFrameUnchanged();
+
+    // 키 반응형 — 감쇠가 다 끝나 프레임이 그대로면 다음 키 입력(매트릭스가 루프를 깨운다)까지 잔다.
+#ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
+    case RGB_MATRIX_SOLID_REACTIVE_SIMPLE:
+#endif
+#ifdef ENABLE_RGB_MATRIX_SPLASH
+    case RGB_MATRIX_SPLASH:
+#endif
+#if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
+    case RGB_MATRIX_TYPING_HEATMAP:
+#endif
+      return !rgb_reactive_is_active() && ws2812IsFrameUnchanged();
+
+    default:
+      break;
   }
+#endif
+  return false;
+}
+#endif
+
+/*
+ * EEPROM 에 아직 안 쓴 변경이 있으면 오래 자면 안 된다.
+ * settle-flush 는 "마지막 쓰기 후 EE_FLUSH_DELAY_MS 조용하면 flush" 인데, 그 판정을
+ * eeprom_task() 가 한다 → 루프가 자면 flush 도 멈춘다. VIA 저장 직후 루프가 수십 초
+ * 블록해버려 그 사이 전원이 꺼지면 유실된다(실제로 겪음).
+ */
+static uint32_t qmk_eeprom_wait_ms(void)
+{
+  return eeprom_is_dirty() ? EEPROM_FLUSH_WAIT_MS : 0;
+}
 
 #ifdef RGB_MATRIX_ENABLE
-  /*
-   * RGB 가 켜져 있으면 애니메이션이 돌아야 한다. activity 데드라인(수십 초)까지 자버리면 멈춘다.
-   *
-   * [주의] 여기서 RGB_MATRIX_LED_FLUSH_LIMIT(16ms)를 쓰면 안 된다. 그건 **프레임 주기**지
-   * task 주기가 아니다. rgb_matrix_task() 는 상태머신이고 RENDERING 이 청크 단위라
-   * (RGB_MATRIX_LED_PROCESS_LIMIT), 한 프레임에 여러 번 불려야 한다. 16ms 로 깨우면
-   * 프레임당 ~100ms 가 걸려 눈에 띄게 끊긴다(실제로 겪음).
-   * → **task 주기로 깨운다.** 프레임 주기 제한은 rgb_task_sync() 가 알아서 건다.
-   *
-   * 전력: RGB 자체가 10mA 단위라 이 웨이크업 비용(≈1mA)은 묻힌다. RGB 를 끄면 원래대로 돌아간다.
-   */
-  if (rgb_matrix_is_enabled() && !suspended)
+/*
+ * RGB 가 켜져 있으면 애니메이션이 돌아야 한다. activity 데드라인(수십 초)까지 자버리면 멈춘다.
+ *
+ * 예전엔 task 주기(2ms)로 깨웠다. rgb_matrix_task() 는 상태머신이라 한 프레임에 여러 번 불려야
+ * 하는데, 프레임 주기(16ms)로만 깨우면 프레임당 ~100ms 가 걸려 눈에 띄게 끊겼다(실제로 겪음).
+ * 지금은 rgb_governor_task() 가 프레임 시각에 **한 번에 한 프레임을 끝낸다** — 그래서 다음
+ * 프레임 시각까지 자도 된다(port/rgb_governor.h). 주기도 효과 속도/배터리에 맞춰 16~100ms 로 늘어난다.
+ *
+ * 정적 효과는 예외다 — 프레임이 안 바뀌면 깨울 게 없다(qmk_rgb_is_static).
+ */
+static uint32_t qmk_rgb_wait_ms(void)
+{
+  if (rgb_matrix_is_enabled() && !suspended && !qmk_rgb_is_static())
   {
-    if (wait_ms == 0 || wait_ms > QMK_TASK_PERIOD_MS)
-    {
-      wait_ms = QMK_TASK_PERIOD_MS;
-    }
+    return rgb_governor_wait_ms();
   }
+  return 0;
+}
 #endif
 
+/*
+ * 데드라인 출처는 qmkInit() 에서 port/deadline 에 등록한다 — 여기는 가장 이른 것을 고르기만 한다.
+ * 탭/홀드 판정(port/tapping/tapping_port.h)처럼 새로 시간에 기대는 기능은 등록 한 줄이면 되고,
+ * 이 함수는 손대지 않는다. 어느 출처가 이겼는지는 타임아웃으로 깼을 때 깨어남 회계(§6.13)가 센다.
+ */
+uint32_t qmkGetIdleWaitMs(void)
+{
+  wake_reason_t reason  = WAKE_REASON_OTHER;
+  uint32_t      wait_ms = deadline_next_ms(&reason);
+
+  wakeStatSetDeadline(reason);
   return wait_ms;
 }
 
+uint32_t qmkGetTickMs(void)
+{
+  return mousekey_port_tick_ms();
+}
+
+uint32_t qmkGetLoopCount(void)
+{
+  return loop_count;
+}
+
 void qmkUpdate(void)
 {
   /*
@@ -227,12 +364,24 @@ void qmkUpdate(void)
    * 부르지 않는다) **idle 데드라인 30초가 지나서야** LED 가 켜졌다(실제로 겪음).
    * 전환을 먼저 하면 같은 회차의 led_task 가 올바른 드라이버를 읽는다.
    */
+  loop_count++;
+
+  bleUpdate();   // BT 스택이 막 준비됐으면 여기서 광고를 올린다 — output_select_task() 가 같은 회차에 본다
   output_select_task();
 
   // 활성 구간에서 idle 이 풀리는(=키 눌림) 순간의 복귀도 여기서 잡는다.
   // output_select_task() 뒤여야 한다 — led_wakeup() 이 활성 드라이버의 LED 상태를 읽는다.
   qmkSuspendUpdate();
 
+  // VIA 명령은 여기서만 처리한다(port/via/via_hid.c). keyboard_task() **전**이라 VIA 가 바꾼
+  // 키맵/RGB 가 같은 회차에 반영되고, 그 뒤 eeprom_task() 가 settle-flush 를 판정한다.
+  via_hid_task();
+
   keyboard_task();
+  mousekey_port_task();  // 이번 회차 키 처리 뒤의 이동 상태로 다음 틱(qmkGetTickMs)을 정한다
+#ifdef RGB_MATRIX_ENABLE
+  rgb_governor_task();   // keyboard_task() 의 rgb_matrix_task() 가 시작한 프레임을 마저 끝낸다
+  rgb_indicator_task();  // Caps/레이어/프로파일이 바뀌었으면 오버레이를 바꾸고 한 번 flush — 프레임 뒤라 버퍼가 완성돼 있다
+#endif
   eeprom_task();
 }
@@ -6,15 +6,23 @@ extern "C" {
 #endif
 
 #include "quantum.h"
+#include "port/wake_stat.h"
 
 bool qmkInit(void);
 void qmkUpdate(void);
 
 // 저전력: 눌린 키가 없고 디바운스가 정착했으면 true → 메인 루프가 잠들어도 된다.
 bool qmkIsIdle(void);
+// 디바운스가 정착했으면(raw == 디바운스 결과) true. 키가 눌려 있어도 된다.
+bool qmkIsMatrixSettled(void);
 // 키 입력이 있을 때까지 블록(그 동안 CPU sleep). 입력 이벤트가 깨운다.
 // timeout_ms == 0 이면 무한 대기. activity 상태머신이 데드라인을 넘겨준다.
 void qmkWaitActivity(uint32_t timeout_ms);
+// 활성 구간의 한 주기(QMK_TASK_PERIOD_MS) 쉬기. 깨어남 회계(wake_stat)에 TICK 으로 남는다.
+void qmkWaitTick(uint32_t ms);
+
+// 부팅 후 qmkUpdate() 를 부른 횟수 = 메인 루프가 깨어난 횟수. 전력 비교용(native_sim 벤치, §7.2).
+uint32_t qmkGetLoopCount(void);
 
 // 마지막 키 입력 이후 경과 시간(ms). activity 상태머신이 idle/sleep 판정에 쓴다.
 uint32_t qmkGetInactiveMs(void);
@@ -35,6 +43,13 @@ uint32_t qmkGetInactiveMs(void);
 #define QMK_TASK_PERIOD_MS   2
 #endif
 
+/*
+ * 활성 구간에서 이번에 쉴 주기(ms). 평소엔 QMK_TASK_PERIOD_MS.
+ * 마우스키로 커서/휠이 움직이는 동안만 transport 주기로 바뀐다 — USB 1ms, BLE 연결 간격
+ * (port/mousekey_port.h). 리포트가 실제로 나가는 주기보다 촘촘히 깨어 봐야 CPU 만 깨운다.
+ */
+uint32_t qmkGetTickMs(void);
+
 /*
  * idle 일 때 얼마나 잘지(ms). 0 = 키 입력까지 무한 대기.
  *
@@ -70,8 +85,11 @@ void qmkSuspendForSleep(void);
  * 루프는 idle 이면 qmkWaitActivity() 에서 블록한다. **키 입력 말고도 루프를 다시 돌려야 하는
  * 경로**가 있으면 여기로 깨워야 한다 — 예: VIA 가 RGB 를 켜면 rgb_matrix_task() 가 돌아야
  * 불이 들어온다. 안 깨우면 사용자가 키를 누를 때까지 아무 일도 안 일어난다(실제로 겪음).
+ *
+ * reason 은 깨어남 회계(port/wake_stat.h)에 남는다 — 새 경로를 붙이면 이유도 새로 만든다.
+ * OTHER 로 뭉개 두면 "누가 배터리를 먹나" 를 물을 때 답이 안 나온다.
  */
-void qmkWake(void);
+void qmkWake(wake_reason_t reason);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,200 @@
+#include "lib8simd.h"
+
+#if defined(__ARM_FEATURE_SIMD32) && __ARM_FEATURE_SIMD32
+#include <arm_acle.h>
+#define LIB8SIMD_USE_SIMD32   1
+#else
+#define LIB8SIMD_USE_SIMD32   0
+#endif
+
+
+/*
+ * [스칼라 꼬리 / 폴백] lib8tion 의 *_C 구현과 같은 식이다. 워드로 안 떨어지는 나머지(len % 4)와
+ * SIMD32 가 없는 타깃이 쓴다.
+ */
+static inline uint8_t scale8_c(uint8_t i, uint8_t scale)
+{
+  return ((uint16_t)i * (uint16_t)scale) >> 8;
+}
+
+static inline uint8_t qadd8_c(uint8_t i, uint8_t j)
+{
+  uint16_t t = i + j;
+  return t > 255 ? 255 : t;
+}
+
+static inline uint8_t qsub8_c(uint8_t i, uint8_t j)
+{
+  return i > j ? i - j : 0;
+}
+
+/*
+ * FASTLED_BLEND_FIXED 가 없으면(QMK 기본) lib8tion 의 blend8 은 scale8 두 번의 합이다 — 정밀한
+ * (a * (255 - k) + b * k) >> 8 보다 1 작게 나오는 입력이 있다. 스칼라와 같아야 하므로 그 식을 따른다.
+ */
+static inline uint8_t blend8_c(uint8_t a, uint8_t b, uint8_t amount_of_b)
+{
+  return scale8_c(a, 255 - amount_of_b) + scale8_c(b, amount_of_b);
+}
+
+#if LIB8SIMD_USE_SIMD32
+// 비정렬 포인터도 된다 — memcpy 4바이트는 LDR/STR 한 개로 접힌다.
+static inline uint32_t ld32(const uint8_t *p)
+{
+  uint32_t v;
+  memcpy(&v, p, 4);
+  return v;
+}
+
+static inline void st32(uint8_t *p, uint32_t v)
+{
+  memcpy(p, &v, 4);
+}
+
+/*
+ * 4 레인 곱셈 — 곱셈 명령에 8비트 레인 SIMD 가 없어서 **16비트 레인 두 개로 나눠** 곱한다.
+ * UXTB16 으로 바이트 0,2 / 1,3 을 16비트 레인에 펼치면, 레인 값(<=255) x 계수(<=255) 가 65025 라
+ * 32비트 곱 한 번에 두 레인이 서로 넘치지 않고 들어간다. 그 뒤 각 레인의 상위 바이트(>> 8)만 남긴다.
+ */
+static inline uint32_t mul_hi8x4(uint32_t x, uint32_t k)
+{
+  uint32_t lo = __uxtb16(x) * k;
+  uint32_t hi = __uxtb16(x >> 8) * k;
+
+  return ((lo >> 8) & 0x00FF00FF) | (hi & 0xFF00FF00);
+}
+#endif
+
+
+void scale8_buffer(uint8_t *buf, uint32_t len, uint8_t scale)
+{
+  uint32_t i = 0;
+
+#if LIB8SIMD_USE_SIMD32
+  for (; i + 4 <= len; i += 4)
+  {
+    st32(&buf[i], mul_hi8x4(ld32(&buf[i]), scale));
+  }
+#endif
+  for (; i < len; i++)
+  {
+    buf[i] = scale8_c(buf[i], scale);
+  }
+}
+
+void qadd8_buffer(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+  uint32_t i = 0;
+
+#if LIB8SIMD_USE_SIMD32
+  for (; i + 4 <= len; i += 4)
+  {
+    st32(&dst[i], __uqadd8(ld32(&dst[i]), ld32(&src[i])));
+  }
+#endif
+  for (; i < len; i++)
+  {
+    dst[i] = qadd8_c(dst[i], src[i]);
+  }
+}
+
+void qsub8_buffer(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+  uint32_t i = 0;
+
+#if LIB8SIMD_USE_SIMD32
+  for (; i + 4 <= len; i += 4)
+  {
+    st32(&dst[i], __uqsub8(ld32(&dst[i]), ld32(&src[i])));
+  }
+#endif
+  for (; i < len; i++)
+  {
+    dst[i] = qsub8_c(dst[i], src[i]);
+  }
+}
+
+/*
+ * blend8 = (a * (255 - amount) + b * amount) >> 8.
+ * 레인마다 두 곱의 합도 255 * 255 = 65025 라 16비트 레인 안에 들어간다 — mul_hi8x4 와 같은 펼치기로
+ * 곱 4번에 4바이트. (SMLAD 로 (a,b)·(255-amount,amount) 를 하면 명령 한 번에 **1바이트**라 오히려 느리다.)
+ */
+void blend8_buffer(uint8_t *dst, const uint8_t *src, uint32_t len, uint8_t amount_of_b)
+{
+  uint32_t i = 0;
+
+#if LIB8SIMD_USE_SIMD32
+  uint32_t ka = 255 - amount_of_b;
+  uint32_t kb = amount_of_b;
+
+  for (; i + 4 <= len; i += 4)
+  {
+    uint32_t a  = ld32(&dst[i]);
+    uint32_t b  = ld32(&src[i]);
+    uint32_t sa = (((__uxtb16(a) * ka) >> 8) & 0x00FF00FF) | ((__uxtb16(a >> 8) * ka) & 0xFF00FF00);
+    uint32_t sb = (((__uxtb16(b) * kb) >> 8) & 0x00FF00FF) | ((__uxtb16(b >> 8) * kb) & 0xFF00FF00);
+
+    // 레인마다 scale8(a, ka) + scale8(b, kb) <= 254 라 레인 사이로 자리올림이 안 넘어간다.
+    st32(&dst[i], sa + sb);
+  }
+#endif
+  for (; i < len; i++)
+  {
+    dst[i] = blend8_c(dst[i], src[i], amount_of_b);
+  }
+}
+
+uint32_t sum8_buffer(const uint8_t *buf, uint32_t len)
+{
+  uint32_t i   = 0;
+  uint32_t sum = 0;
+
+#if LIB8SIMD_USE_SIMD32
+  for (; i + 4 <= len; i += 4)
+  {
+    sum = __usada8(ld32(&buf[i]), 0, sum);   // |x - 0| 의 4레인 합 = 바이트 합
+  }
+#endif
+  for (; i < len; i++)
+  {
+    sum += buf[i];
+  }
+  return sum;
+}
+
+/*
+ * |a - b| = qsub8(a, b) | qsub8(b, a) — 둘 중 하나는 0 이다.
+ * 레인별 최대는 max(m, d) = m + qsub8(d, m). USUB8 + SEL 로도 되지만 GE 플래그를 컴파일러가
+ * 명령 사이에 보존한다고 기대해야 해서, 플래그 없는 포화 연산만 쓴다(명령 수는 같다).
+ */
+uint8_t absdiff8_max(const uint8_t *a, const uint8_t *b, uint32_t len)
+{
+  uint32_t i = 0;
+  uint8_t  ret = 0;
+
+#if LIB8SIMD_USE_SIMD32
+  uint32_t m = 0;
+
+  for (; i + 4 <= len; i += 4)
+  {
+    uint32_t x = ld32(&a[i]);
+    uint32_t y = ld32(&b[i]);
+    uint32_t d = __uqsub8(x, y) | __uqsub8(y, x);
+
+    m = __uqadd8(m, __uqsub8(d, m));
+  }
+  for (int l = 0; l < 4; l++)
+  {
+    uint8_t d = (m >> (l * 8)) & 0xFF;
+
+    ret = d > ret ? d : ret;
+  }
+#endif
+  for (; i < len; i++)
+  {
+    uint8_t d = a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+
+    ret = d > ret ? d : ret;
+  }
+  return ret;
+}
@@ -0,0 +1,42 @@
+#ifndef LIB8SIMD_H_
+#define LIB8SIMD_H_
+
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+
+#include "def.h"
+
+
+/*
+ * lib8tion(src/lib/lib8tion) 의 8비트 연산을 **바이트 배열 단위**로 하는 배치 커널.
+ *
+ * Cortex-M4 의 SIMD32 명령(UQADD8/UQSUB8/UXTB16/USADA8)으로 한 번에 4바이트(4 레인)를 처리한다.
+ * __ARM_FEATURE_SIMD32 가 없으면(native_sim 등) 같은 식의 스칼라로 돈다.
+ *
+ * 결과는 lib8tion 의 스칼라 함수와 **비트 단위로 같다**(FASTLED_SCALE8_FIXED/FASTLED_BLEND_FIXED 미정의 기준):
+ *   scale8_buffer  : buf[i] = scale8(buf[i], scale)         = (buf[i] * scale) >> 8
+ *   qadd8_buffer   : dst[i] = qadd8(dst[i], src[i])
+ *   qsub8_buffer   : dst[i] = qsub8(dst[i], src[i])
+ *   blend8_buffer  : dst[i] = blend8(dst[i], src[i], amount)  = scale8(dst, 255 - amount) + scale8(src, amount)
+ * 검증은 CLI `rgb simd` / native_sim `--rgb-golden`(port/rgb_batch.c) — 스칼라 lib8tion 과 전수/난수 비교 + 시간.
+ *
+ * RGB 배열(packed 3바이트)은 그대로 바이트 배열로 넘기면 된다 — nscale8x3 를 픽셀마다 부르는 것과 같다.
+ * 포인터 정렬은 상관없다(M4 는 비정렬 워드 접근을 한다).
+ */
+void     scale8_buffer(uint8_t *buf, uint32_t len, uint8_t scale);
+void     qadd8_buffer(uint8_t *dst, const uint8_t *src, uint32_t len);
+void     qsub8_buffer(uint8_t *dst, const uint8_t *src, uint32_t len);
+void     blend8_buffer(uint8_t *dst, const uint8_t *src, uint32_t len, uint8_t amount_of_b);
+
+uint32_t sum8_buffer(const uint8_t *buf, uint32_t len);                      // 바이트 합(USADA8)
+uint8_t  absdiff8_max(const uint8_t *a, const uint8_t *b, uint32_t len);     // max |a[i] - b[i]|
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
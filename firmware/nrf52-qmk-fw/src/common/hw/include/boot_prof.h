@@ -0,0 +1,51 @@
+#ifndef BOOT_PROF_H_
+#define BOOT_PROF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "hw_def.h"
+
+#ifdef _USE_HW_BOOT_PROF
+
+/*
+ * 부팅 단계 타임스탬프.
+ *
+ * System OFF 에서 깨어나는 것 = 리셋 부팅이다(port/activity.c). 즉 **잠든 키보드의 첫 키 지연 =
+ * 부팅 시간**이라 사용자가 직접 느낀다. 각 단계 끝에서 bootProfMark() 를 부르면 커널 시작 기준
+ * µs 가 기록되고, 로그 / CLI `boot` / VIA(ID_QMK_BOOT_PROF) 로 꺼내 본다.
+ *
+ * 기준점은 커널 시계 시작(k_uptime 0)이다. 그 앞(리셋 → 스타트업 → HFXO/LFCLK)은 잴 수 없다.
+ * 같은 단계는 **처음 한 번만** 기록된다 — BOOT_PROF_FIRST_KEY 처럼 여러 번 지나가는 지점도
+ * 호출부에서 조건을 따질 필요가 없다.
+ */
+
+enum
+{
+  BOOT_PROF_MAIN = 0,     // main() 진입(hwInit 시작)
+  BOOT_PROF_HW,           // hwInit() 끝
+  BOOT_PROF_USB,          // usbInit() 끝
+  BOOT_PROF_EEPROM,       // EEPROM 미러 로드 끝
+  BOOT_PROF_MATRIX,       // keyboard_init() 끝 — 매트릭스/키맵 준비
+  BOOT_PROF_QMK,          // qmkInit() 끝
+  BOOT_PROF_LOOP,         // 메인 루프 첫 회차
+  BOOT_PROF_BLE,          // BT 스택 + 본딩 로드 끝(시스템 워크큐, 비동기)
+  BOOT_PROF_FIRST_KEY,    // 첫 키 리포트 송신(USB/BLE) — time-to-first-keystroke
+  BOOT_PROF_MAX,
+};
+
+bool     bootProfInit(void);
+void     bootProfMark(uint8_t phase);
+uint32_t bootProfGetUs(uint8_t phase);   // 0 = 아직 안 지나감
+uint32_t bootProfGetCount(void);         // 웜 리셋 사이에 이어지는 부팅 횟수
+bool     bootProfIsWakeFromOff(void);    // System OFF 웨이크(리셋 원인 OFF)
+void     bootProfPrint(void);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
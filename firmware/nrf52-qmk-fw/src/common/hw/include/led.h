@@ -28,9 +28,10 @@ void ledToggle(uint8_t ch);
 #else
 
 // LED 없는 보드에서도 호출부가 그대로 컴파일되게 한다(log.h 와 같은 방식).
+// ledInit/ledToSleep 는 반환값을 버리는 문장으로 불려서 매크로 (true) 면 -Wunused-value 가 난다.
 #define LED_MAX_CH            0
-#define ledInit()             (true)
-#define ledToSleep()          (true)
+static inline bool ledInit(void)    { return true; }
+static inline bool ledToSleep(void) { return true; }
 #define ledOn(ch)             ((void)0)
 #define ledOff(ch)            ((void)0)
 #define ledToggle(ch)         ((void)0)
@@ -20,9 +20,37 @@ extern "C" {
 #define WS2812_COLOR_OFF        WS2812_COLOR(  0,   0,   0)
 
 
-bool ws2812Init(void);
-void ws2812SetColor(uint32_t ch, uint32_t color);
-bool ws2812Refresh(void);
+bool     ws2812Init(void);
+void     ws2812SetColor(uint32_t ch, uint32_t color);
+bool     ws2812Refresh(void);             // 스트립에 떠 있는 프레임과 같으면 SPI 없이 true
+bool     ws2812IsFrameUnchanged(void);    // 마지막 Refresh 가 "같아서 건너뜀" 이었나
+uint32_t ws2812GetFrameCount(void);       // Refresh 누적 횟수(건너뛴 것 포함)
+uint8_t  ws2812GetFrameDelta(void);       // 마지막 Refresh 의 채널 최대 변화량(0~255)
+bool     ws2812IsFrameDeltaValid(void);   // 그 변화량이 직전 프레임과 비교한 값인가 — 첫 프레임/레일 복귀 직후는 false
+
+// 전송할 때만 모든 채널에 scale/256 을 곱한다(버퍼는 그대로). WS2812_SCALE_FULL = 안 줄임.
+#define WS2812_SCALE_FULL       256
+void     ws2812SetScale(uint16_t scale);
+uint32_t ws2812GetChannelSum(void);       // 보낼 프레임(버퍼 + 오버레이)의 r+g+b 합(스케일 전) — 전류 추정용
+
+/*
+ * 오버레이 — 인디케이터(Caps/레이어/BLE 프로파일)용 희소 목록 (ch, color).
+ *
+ * 버퍼(QMK 가 그리는 곳)는 안 건드리고 **전송 복사본**에 덮어쓴다 — 효과가 매 프레임
+ * 인디케이터를 다시 그릴 필요가 없고, 효과가 꺼져 있으면(버퍼 = 검정) 이것만 나간다.
+ * 덮은 뒤에 스케일하고 채널 합에도 들어가므로 전류 예산(SetScale)을 같이 받는다.
+ * 목록이 바뀌면 true 를 돌려주고, 다음 Refresh 는 버퍼가 같아도 보낸다. count 0 = 지움.
+ */
+#define WS2812_OVERLAY_MAX      8
+
+typedef struct
+{
+  uint8_t  ch;
+  uint32_t color;   // WS2812_COLOR(r, g, b)
+} ws2812_overlay_t;
+
+bool     ws2812SetOverlay(const ws2812_overlay_t *list, uint8_t count);
+uint8_t  ws2812GetOverlayCount(void);
 
 /*
  * 스트립 전원 + SPI 버스를 함께 켜고 끈다.
@@ -37,6 +65,14 @@ bool ws2812Refresh(void);
 void ws2812SetPower(bool enable);
 bool ws2812IsPowered(void);
 
+/*
+ * 켜기는 바로 돌아온다 — 레일은 워크 큐에서 올라오고(ws2812.c 주석), 그동안 Refresh 는 프레임을
+ * 버퍼에 남겨 둔 채 false 를 돌려준다. 레일이 안정되면 ready 콜백이 불린다(hw 가 QMK 를 직접
+ * 부르지 않게 콜백 — usbSetSuspendFunc 와 같은 패턴). 그 뒤 IsPending 이면 Refresh 를 다시 부르라.
+ */
+bool ws2812IsPending(void);
+void ws2812SetReadyFunc(void (*func)(void));
+
 
 #endif
 
@@ -0,0 +1,178 @@
+#include "boot_prof.h"
+
+#ifdef _USE_HW_BOOT_PROF
+#include "log.h"
+#include "cli.h"
+#include <zephyr/linker/section_tags.h>
+#include <hal/nrf_power.h>
+
+#if CLI_USE(HW_BOOT_PROF)
+static void cliBootProf(cli_args_t *args);
+#endif
+
+/*
+ * 기록은 __noinit RAM 에 둔다 — 웜 리셋(sys_reboot, 워치독, 리셋 핀, eeprom clean 재부팅)을 넘어
+ * **직전 부팅의 기록**이 남아 이번 부팅과 비교할 수 있다. magic 이 맞을 때만 믿는다.
+ *
+ * System OFF 웨이크는 예외다. sys_poweroff() 가 RAM 리텐션을 끄므로(port/activity.c) 그 경우엔
+ * 직전 기록이 없다 — 대신 리셋 원인(RESETREAS.OFF)으로 "깨어난 부팅"인지는 안다.
+ * 그게 바로 재야 할 경우라(잠든 키보드의 첫 키) 이번 부팅 기록만으로 충분하다.
+ */
+#define BOOT_PROF_MAGIC     0x42505246   // "BPRF"
+
+typedef struct
+{
+  uint32_t magic;
+  uint32_t count;
+  uint32_t reset_reason;
+  uint32_t t_us[BOOT_PROF_MAX];
+} boot_prof_rec_t;
+
+static __noinit boot_prof_rec_t rec_cur;
+static __noinit boot_prof_rec_t rec_prev;
+
+// 로그가 꺼진 빌드(logPrintf 가 no-op)에선 표를 아무도 안 읽는다 — 같이 뺀다.
+#ifdef _USE_HW_LOG
+static const char *phase_name[BOOT_PROF_MAX] = {
+  [BOOT_PROF_MAIN]      = "main",
+  [BOOT_PROF_HW]        = "hw init",
+  [BOOT_PROF_USB]       = "usb init",
+  [BOOT_PROF_EEPROM]    = "eeprom load",
+  [BOOT_PROF_MATRIX]    = "keyboard init",
+  [BOOT_PROF_QMK]       = "qmk init",
+  [BOOT_PROF_LOOP]      = "main loop",
+  [BOOT_PROF_BLE]       = "ble ready",
+  [BOOT_PROF_FIRST_KEY] = "first key",
+};
+#endif
+
+
+bool bootProfInit(void)
+{
+  uint32_t count = 0;
+
+  if (rec_cur.magic == BOOT_PROF_MAGIC)
+  {
+    rec_prev = rec_cur;
+    count    = rec_cur.count;
+  }
+  else
+  {
+    rec_prev.magic = 0;
+  }
+
+  memset(&rec_cur, 0, sizeof(rec_cur));
+  rec_cur.count        = count + 1;
+  rec_cur.reset_reason = nrf_power_resetreas_get(NRF_POWER);
+  nrf_power_resetreas_clear(NRF_POWER, rec_cur.reset_reason);   // 누적 레지스터 — 읽은 만큼 지운다
+  rec_cur.magic        = BOOT_PROF_MAGIC;
+
+  bootProfMark(BOOT_PROF_MAIN);
+
+#if CLI_USE(HW_BOOT_PROF)
+  cliAdd("boot", cliBootProf);
+#endif
+  return true;
+}
+
+void bootProfMark(uint8_t phase)
+{
+  if (phase >= BOOT_PROF_MAX || rec_cur.t_us[phase] != 0)
+  {
+    return;
+  }
+  // 0 은 "아직" 이라는 뜻이라 최소 1µs 로 남긴다.
+  rec_cur.t_us[phase] = MAX(micros(), 1);
+
+  if (phase == BOOT_PROF_FIRST_KEY)
+  {
+    logPrintf("[  ] boot: first key %d us%s\n", rec_cur.t_us[phase],
+              bootProfIsWakeFromOff() ? " (wake from System OFF)" : "");
+  }
+}
+
+uint32_t bootProfGetUs(uint8_t phase)
+{
+  if (phase >= BOOT_PROF_MAX)
+  {
+    return 0;
+  }
+  return rec_cur.t_us[phase];
+}
+
+uint32_t bootProfGetCount(void)
+{
+  return rec_cur.count;
+}
+
+bool bootProfIsWakeFromOff(void)
+{
+  return (rec_cur.reset_reason & NRF_POWER_RESETREAS_OFF_MASK) != 0;
+}
+
+static void boot_prof_print_rec(const boot_prof_rec_t *p_rec)
+{
+  uint32_t pre_us = 0;
+
+  for (int i = 0; i < BOOT_PROF_MAX; i++)
+  {
+    if (p_rec->t_us[i] == 0)
+    {
+      logPrintf("     %-14s : -\n", phase_name[i]);
+      continue;
+    }
+    // BLE/첫 키는 비동기라 직전 단계와의 차이가 의미 없다 — 절대값만.
+    if (i >= BOOT_PROF_BLE)
+    {
+      logPrintf("     %-14s : %7d us\n", phase_name[i], p_rec->t_us[i]);
+    }
+    else
+    {
+      logPrintf("     %-14s : %7d us (+%d)\n", phase_name[i], p_rec->t_us[i], p_rec->t_us[i] - pre_us);
+      pre_us = p_rec->t_us[i];
+    }
+  }
+}
+
+void bootProfPrint(void)
+{
+  logPrintf("[  ] boot #%d, reset 0x%X%s\n", rec_cur.count, rec_cur.reset_reason,
+            bootProfIsWakeFromOff() ? " (wake from System OFF)" : "");
+  boot_prof_print_rec(&rec_cur);
+}
+
+
+#if CLI_USE(HW_BOOT_PROF)
+void cliBootProf(cli_args_t *args)
+{
+  bool ret = false;
+
+  if (args->argc == 1 && args->isStr(0, "info"))
+  {
+    bootProfPrint();
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "prev"))
+  {
+    if (rec_prev.magic != BOOT_PROF_MAGIC)
+    {
+      cliPrintf("no previous record (cold boot / System OFF wake)\n");
+    }
+    else
+    {
+      logPrintf("[  ] boot #%d, reset 0x%X\n", rec_prev.count, rec_prev.reset_reason);
+      boot_prof_print_rec(&rec_prev);
+    }
+    ret = true;
+  }
+
+  if (ret == false)
+  {
+    cliPrintf("boot info\n");
+    cliPrintf("boot prev\n");
+  }
+}
+#endif
+
+#endif
@@ -17,10 +17,12 @@ LOG_MODULE_REGISTER(usb_hid);
 #define HID_KBD_NODE   DT_NODELABEL(usb_hid_kbd)
 #define HID_VIA_NODE   DT_NODELABEL(usb_hid_via)
 #define HID_EXK_NODE   DT_NODELABEL(usb_hid_exk)
+#define HID_MOUSE_NODE DT_NODELABEL(usb_hid_mouse)
 
-static const struct device *hid_kbd_dev = DEVICE_DT_GET(HID_KBD_NODE);
-static const struct device *hid_via_dev = DEVICE_DT_GET(HID_VIA_NODE);
-static const struct device *hid_exk_dev = DEVICE_DT_GET(HID_EXK_NODE);
+static const struct device *hid_kbd_dev   = DEVICE_DT_GET(HID_KBD_NODE);
+static const struct device *hid_via_dev   = DEVICE_DT_GET(HID_VIA_NODE);
+static const struct device *hid_exk_dev   = DEVICE_DT_GET(HID_EXK_NODE);
+static const struct device *hid_mouse_dev = DEVICE_DT_GET(HID_MOUSE_NODE);
 
 
 static const uint8_t hid_report_kbd_desc[] =
@@ -112,6 +114,46 @@ static uint8_t hid_report_exk_desc[] =
   0xC0                      // End Collection
 };
 
+/*
+ * 마우스 — QMK report_mouse_t(MOUSE_SHARED_EP / MOUSE_EXTENDED_REPORT 없음) 그대로 5B:
+ * buttons(8) + x, y(int8) + wheel(int8) + AC Pan(int8). 인터페이스가 따로라 Report ID 가 없다.
+ * BLE 는 같은 배치를 Report ID 2 로 싣는다(port/ble.c).
+ */
+static const uint8_t hid_report_mouse_desc[] =
+{
+  0x05, 0x01,               // Usage Page (Generic Desktop)
+  0x09, 0x02,               // Usage (Mouse)
+  0xA1, 0x01,               // Collection (Application)
+  0x09, 0x01,               //   Usage (Pointer)
+  0xA1, 0x00,               //   Collection (Physical)
+  0x05, 0x09,               //     Usage Page (Button)
+  0x19, 0x01,               //     Usage Minimum (Button 1)
+  0x29, 0x08,               //     Usage Maximum (Button 8)
+  0x15, 0x00,               //     Logical Minimum (0)
+  0x25, 0x01,               //     Logical Maximum (1)
+  0x95, 0x08,               //     Report Count (8)
+  0x75, 0x01,               //     Report Size (1)
+  0x81, 0x02,               //     Input (Data, Variable, Absolute)
+  0x05, 0x01,               //     Usage Page (Generic Desktop)
+  0x09, 0x30,               //     Usage (X)
+  0x09, 0x31,               //     Usage (Y)
+  0x09, 0x38,               //     Usage (Wheel)
+  0x15, 0x81,               //     Logical Minimum (-127)
+  0x25, 0x7F,               //     Logical Maximum (127)
+  0x95, 0x03,               //     Report Count (3)
+  0x75, 0x08,               //     Report Size (8)
+  0x81, 0x06,               //     Input (Data, Variable, Relative)
+  0x05, 0x0C,               //     Usage Page (Consumer)
+  0x0A, 0x38, 0x02,         //     Usage (AC Pan)
+  0x15, 0x81,               //     Logical Minimum (-127)
+  0x25, 0x7F,               //     Logical Maximum (127)
+  0x95, 0x01,               //     Report Count (1)
+  0x75, 0x08,               //     Report Size (8)
+  0x81, 0x06,               //     Input (Data, Variable, Relative)
+  0xC0,                     //   End Collection
+  0xC0                      // End Collection
+};
+
 
 enum kb_leds_idx
 {
@@ -144,10 +186,11 @@ UDC_STATIC_BUF_DEFINE(report, KB_REPORT_COUNT);
 static uint32_t kb_duration;
 static bool     kb_ready;
 static bool     via_ready;
+static bool     mouse_ready;
 static uint8_t  kb_led_state;
 
 // VIA raw HID 수신 콜백(호스트→디바이스 OUT 리포트). port/via_hid.c 가 등록.
-static void (*via_receive_cb)(uint8_t *data, uint8_t length);
+static bool (*via_receive_cb)(uint8_t *data, uint8_t length);
 
 // hid_device_submit_report() 는 report 버퍼가 정렬돼야 하고, input_report_done
 // 콜백이 없으면 동기(전송 완료까지 블록)로 처리된다. QMK 리포트를 정렬 버퍼로
@@ -158,6 +201,7 @@ static void (*via_receive_cb)(uint8_t *data, uint8_t length);
 static uint8_t __aligned(4) kbd_tx_buf[KB_REPORT_COUNT];
 static uint8_t __aligned(4) exk_tx_buf[8];
 static uint8_t __aligned(4) via_tx_buf[32];
+static uint8_t __aligned(4) mouse_tx_buf[8];
 
 /*
  * USB HID 전송 스레드.
@@ -188,6 +232,7 @@ enum
   USB_TX_KBD = 0,
   USB_TX_EXK,
   USB_TX_VIA,
+  USB_TX_MOUSE,
 };
 
 struct usb_tx_item
@@ -223,6 +268,11 @@ static void usbTxThread(void *p1, void *p2, void *p3)
         memcpy(via_tx_buf, item.data, item.len);
         hid_device_submit_report(hid_via_dev, item.len, via_tx_buf);
         break;
+
+      case USB_TX_MOUSE:
+        memcpy(mouse_tx_buf, item.data, item.len);
+        hid_device_submit_report(hid_mouse_dev, item.len, mouse_tx_buf);
+        break;
     }
   }
 }
@@ -367,44 +417,25 @@ static int via_get_report(const struct device *dev,
   return 0;
 }
 
-// VIA OUT 리포트 처리 큐. USB 수신 콜백(via_output_report) 안에서 응답(raw_hid_send →
-// hid_device_submit_report, 동기)을 바로 보내면 USB 스택 컨텍스트에서 재진입/블록되어
-// VIA 가 "Loading" 에서 멈춘다. 그래서 OUT 리포트를 큐에 넣고 전용 스레드가 처리한다.
-K_MSGQ_DEFINE(via_rx_msgq, 32, 8, 4);
-
-// 호스트→디바이스 32바이트 OUT 리포트를 큐에 적재(콜백 컨텍스트에서 즉시 반환).
-static void via_deliver(const uint8_t *const buf, const uint16_t len)
-{
-  uint8_t  msg[32];
-  uint16_t n = (len < sizeof(msg)) ? len : sizeof(msg);
-
-  memset(msg, 0, sizeof(msg));
-  memcpy(msg, buf, n);
-  k_msgq_put(&via_rx_msgq, msg, K_NO_WAIT);
-}
-
-// VIA 처리 스레드: 큐에서 OUT 리포트를 꺼내 raw_hid_receive 처리(응답 전송 포함)를
-// USB 콜백 밖에서 수행한다.
-static void via_process_thread(void *p1, void *p2, void *p3)
+/*
+ * VIA OUT 리포트 전달 — **복사만 하고 즉시 반환**한다.
+ *
+ * 이 콜백 안에서 응답(raw_hid_send → hid_device_submit_report)을 바로 보내면 USB 스택 컨텍스트에서
+ * 재진입/블록되어 VIA 가 "Loading" 에서 멈춘다(§3.2). 예전엔 여기서 msgq 에 넣고 전용 스레드가
+ * 처리했지만, 지금은 via_receive_cb(port/via/via_hid.c)가 공유 수신 풀 버퍼에 **한 번** 복사하고
+ * 메인 루프가 그 버퍼 안에서 처리한다 — QMK 상태를 만지는 쪽이 메인 루프 하나뿐이어야 해서다.
+ * 콜백은 블록하면 안 된다. 풀이 비면 false — SET_REPORT 경로는 호스트에 에러로 돌려준다.
+ * interrupt OUT 경로는 클래스가 반환 직후 OUT 을 다시 arm 해서 NAK 로 붙잡아 둘 수 없다.
+ */
+static bool via_deliver(const uint8_t *const buf, const uint16_t len)
 {
-  ARG_UNUSED(p1);
-  ARG_UNUSED(p2);
-  ARG_UNUSED(p3);
-
-  uint8_t buf[32];
-
-  for (;;)
+  if (via_receive_cb == NULL)
   {
-    k_msgq_get(&via_rx_msgq, buf, K_FOREVER);
-    if (via_receive_cb != NULL)
-    {
-      via_receive_cb(buf, sizeof(buf));
-    }
+    return true;
   }
+  return via_receive_cb((uint8_t *)buf, (len < 32) ? len : 32);
 }
 
-K_THREAD_DEFINE(via_tid, 2048, via_process_thread, NULL, NULL, NULL, 6, 0, 0);
-
 static int via_set_report(const struct device *dev,
                          const uint8_t type, const uint8_t id, const uint16_t len,
                          const uint8_t *const buf)
@@ -414,8 +445,8 @@ static int via_set_report(const struct device *dev,
     LOG_WRN("Unsupported report type");
     return -ENOTSUP;
   }
-  via_deliver(buf, len);   // control endpoint SET_REPORT 경로
-  return 0;
+  // control endpoint SET_REPORT 경로
+  return via_deliver(buf, len) ? 0 : -ENOMEM;
 }
 
 static void via_output_report(const struct device *dev, const uint16_t len, const uint8_t *const buf)
@@ -423,6 +454,20 @@ static void via_output_report(const struct device *dev, const uint16_t len, cons
   via_deliver(buf, len);   // interrupt OUT endpoint 경로(VIA 기본)
 }
 
+static void mouse_iface_ready(const struct device *dev, const bool ready)
+{
+  LOG_INF("Mouse device %s interface is %s", dev->name, ready ? "ready" : "not ready");
+  mouse_ready = ready;
+}
+
+static int mouse_get_report(const struct device *dev,
+                            const uint8_t type, const uint8_t id, const uint16_t len,
+                            uint8_t *const buf)
+{
+  LOG_WRN("Mouse Get Report not implemented, Type %u ID %u", type, id);
+  return 0;
+}
+
 struct hid_device_ops kbd_ops = 
 {
   .iface_ready   = kb_iface_ready,
@@ -445,6 +490,12 @@ struct hid_device_ops via_ops =
   .output_report = via_output_report,
 };
 
+struct hid_device_ops mouse_ops =
+{
+  .iface_ready   = mouse_iface_ready,
+  .get_report    = mouse_get_report,
+};
+
 // QMK host driver(port/driver_usb.c) 가 호출하는 전송 API.
 // 키보드 리포트(boot 8바이트: mods+reserved+keys[6])를 kbd HID IN 으로 전송.
 bool usbHidSendReport(uint8_t *data, uint16_t length)
@@ -474,6 +525,20 @@ bool usbHidSendReportEXK(uint8_t *data, uint16_t length)
   return usb_tx_put(USB_TX_EXK, data, length);
 }
 
+// 마우스 리포트(report_mouse_t 5B)를 mouse HID IN 으로 전송. 키보드처럼 큐를 거친다.
+bool usbHidSendReportMouse(uint8_t *data, uint16_t length)
+{
+  if (!mouse_ready)
+  {
+    return false;
+  }
+  if (length > sizeof(mouse_tx_buf))
+  {
+    length = sizeof(mouse_tx_buf);
+  }
+  return usb_tx_put(USB_TX_MOUSE, data, length);
+}
+
 uint8_t usbHidGetKbdLeds(void)
 {
   return kb_led_state;
@@ -485,7 +550,7 @@ bool usbHidIsReady(void)
 }
 
 // VIA 수신 콜백 등록 (port/via_hid.c 의 via_hid_receive).
-void usbHidSetViaReceiveFunc(void (*func)(uint8_t *data, uint8_t length))
+void usbHidSetViaReceiveFunc(bool (*func)(uint8_t *data, uint8_t length))
 {
   via_receive_cb = func;
 }
@@ -524,6 +589,11 @@ bool usbHidInit(void)
     LOG_ERR("USB EXK Device is not ready");
     return -EIO;
   }
+  if (!device_is_ready(hid_mouse_dev))
+  {
+    LOG_ERR("USB MOUSE Device is not ready");
+    return -EIO;
+  }
 
   ret = hid_device_register(hid_kbd_dev,
                             hid_report_kbd_desc, sizeof(hid_report_kbd_desc),
@@ -551,5 +621,14 @@ bool usbHidInit(void)
     LOG_ERR("Failed to register hid_kbd_dev, %d", ret);
     return ret;
   }  
+
+  ret = hid_device_register(hid_mouse_dev,
+                            hid_report_mouse_desc, sizeof(hid_report_mouse_desc),
+                            &mouse_ops);
+  if (ret != 0)
+  {
+    LOG_ERR("Failed to register hid_mouse_dev, %d", ret);
+    return ret;
+  }
   return true;
 }
\ No newline at end of file
@@ -10,10 +10,12 @@ bool usbHidInit(void);
 bool    usbHidSendReport(uint8_t *data, uint16_t length);
 bool    usbHidSendReportEXK(uint8_t *data, uint16_t length);
 bool    usbHidSendReportVia(uint8_t *data, uint16_t length);
+// 마우스 리포트(report_mouse_t: buttons, x, y, v, h)를 mouse HID IN 으로 전송.
+bool    usbHidSendReportMouse(uint8_t *data, uint16_t length);
 uint8_t usbHidGetKbdLeds(void);
 // 호스트가 키보드 인터페이스를 구성했는지(=USB 로 전송 가능한지)
 bool    usbHidIsReady(void);
-void    usbHidSetViaReceiveFunc(void (*func)(uint8_t *data, uint8_t length));
+void    usbHidSetViaReceiveFunc(bool (*func)(uint8_t *data, uint8_t length));
 
 /*
  * 호스트가 키보드 LED 리포트(CapsLock 등)를 보냈을 때 알림.
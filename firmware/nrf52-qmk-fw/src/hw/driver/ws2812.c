@@ -7,17 +7,30 @@
 #include <zephyr/device.h>
 #include <zephyr/drivers/led_strip.h>
 #include <zephyr/pm/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <stdlib.h>
+#include "lib8simd.h"
+#include "ws2812_spi.h"
 
 /*
- * 네오픽셀 — Zephyr 네이티브 led_strip(worldsemi,ws2812-spi) 백엔드.
+ * 네오픽셀 — 기본은 표 인코더(ws2812_spi.c), Kconfig KBD_WS2812_LUT=n 이면 Zephyr 네이티브
+ * led_strip(worldsemi,ws2812-spi). 어느 쪽이든 같은 DTS 노드(led_strip)의 값으로 같은 비트를 쏜다.
  * baram 의 hw 드라이버 API(ws2812SetColor/ws2812Refresh)를 그대로 유지해서
  * 키보드별 rgblight_drivers.c 가 baram 과 같은 모양이 되게 한다.
  *
  * 전원은 ext_power 레일이 공급한다 — 레일이 꺼져 있으면 SPI 를 쏴봐야 소용없다.
  */
-
+#ifdef CONFIG_KBD_WS2812_LUT
+#define strip_is_ready()        ws2812SpiInit()
+#define strip_update(px, n)     ws2812SpiUpdate(px, n)
+#else
 static const struct device  *strip_dev = DEVICE_DT_GET(DT_NODELABEL(led_strip));
 
+#define strip_is_ready()        device_is_ready(strip_dev)
+#define strip_update(px, n)     led_strip_update_rgb(strip_dev, px, n)
+#endif
+
 /*
  * 스트립이 매달린 **SPI 버스를 DTS 에서 유도한다** — 보드마다 다른 버스를 쓴다
  * (wish60 은 spi3, wish65 는 spi3 지만 595 가 spi2 에 있다). DT_PARENT 로 잡으면
@@ -31,17 +44,144 @@ static const struct device  *strip_dev = DEVICE_DT_GET(DT_NODELABEL(led_strip));
  * CONFIG_PM_DEVICE_RUNTIME(전송마다 자동 suspend)은 쓰지 않는다 — idle 이 69µA -> 652µA 로
  * 10배 악화됐다(실측). RGB on/off 시점에만 직접 건드린다.
  */
+#if DT_ON_BUS(DT_NODELABEL(led_strip), spi)
 static const struct device  *spi_dev   = DEVICE_DT_GET(DT_PARENT(DT_NODELABEL(led_strip)));
+#else
+static const struct device  *spi_dev   = NULL;   // native_sim 스텁 스트립 — 끌 버스가 없다(device_is_ready 가 거른다)
+#endif
 static struct led_rgb        pixels[WS2812_MAX_CH];
 static bool                  is_init = false;
 
+/*
+ * 프레임 차분 — 스트립에 **마지막으로 보낸 프레임**을 들고 있다가 같으면 SPI 를 건너뛴다.
+ *
+ * rgb_matrix 는 정적 효과(단색, 그라데이션)도 프레임마다 flush 한다. 그때마다 SPIM 이 깨어나
+ * EasyDMA 로 LED 당 24 심볼을 밀어낸다 — 값이 같으면 전부 헛일이다. 밝기가 낮은 브리딩처럼
+ * 8비트 양자화로 몇 프레임씩 값이 안 바뀌는 경우도 같이 걸러진다.
+ *
+ * 비교는 채널 바이트를 한 번 훑는 것뿐이다(LED 16~42개 = 48~126B). 해시는 쓰지 않는다 — 이 크기면
+ * 복사본이 해시 계산보다 싸고, 충돌로 프레임을 놓칠 일도 없다.
+ *
+ * 레일이 내려가면 LED 가 색을 잃으므로 복사본도 무효다(sent_valid) — 다시 올린 첫 프레임은 같아도 보낸다.
+ */
+static struct led_rgb        pixels_sent[WS2812_MAX_CH];
+static bool                  sent_valid  = false;
+static bool                  frame_same  = false;   // 마지막 Refresh 가 "같아서 건너뜀" 이었나
+static uint8_t               frame_delta = 0;       // 마지막 Refresh 의 채널 최대 변화량(0~255 전부 실제 값)
+static bool                  frame_delta_valid = false;   // 직전 프레임과 비교했나(레일을 올린 첫 프레임은 아니다)
+static uint32_t              stat_sent;
+static uint32_t              stat_skip;
+
+/*
+ * 전송 스케일 — 전류 예산(port/rgb_limiter.c)이 프레임을 통째로 줄일 때 쓴다.
+ * pixels 자체는 안 건드리고 **보낼 복사본**에만 적용한다. 제자리에서 줄이면 다음 프레임에 다시
+ * 안 그려지는 LED(플래그로 빠진 LED 등)가 프레임마다 또 줄어 0 으로 녹는다.
+ * 차분 비교는 스케일 전 값 + 스케일로 한다 — 스케일만 바뀌어도 다시 보낸다.
+ */
+static uint16_t              frame_scale = WS2812_SCALE_FULL;
+static uint16_t              scale_sent  = WS2812_SCALE_FULL;
+
+/*
+ * 인디케이터 오버레이 — 스케일과 같은 자리(전송 복사본)에서 합친다. 스케일 **앞**에서 덮고 채널 합
+ * (ws2812GetChannelSum)에도 넣는다 — 전류 예산은 실제로 나갈 프레임으로 잡아야 한다. 효과가 꺼진 채
+ * 인디케이터만 켜진 프레임도 예산을 받는다. 예산이 빠듯하면 인디케이터도 같은 비율로 어두워진다.
+ * 메인 루프에서만 쓰고 읽는다(Set / Refresh / GetChannelSum) — 잠금이 필요 없다.
+ */
+static ws2812_overlay_t      overlay[WS2812_OVERLAY_MAX];
+static uint8_t               overlay_cnt   = 0;
+static bool                  overlay_dirty = false;   // 바뀐 뒤 아직 안 보냈다
+
+// 같은 LED 가 목록에 또 나오면 나중 것이 이긴다(rgb_indicator.c) — 앞의 것은 덮인다.
+static bool overlay_is_shadowed(int i)
+{
+  for (int j = i + 1; j < overlay_cnt; j++)
+  {
+    if (overlay[j].ch == overlay[i].ch)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*
+ * 전송은 **ws2812_tx_thread** 가 한다 — Refresh 는 프레임을 넘기고 바로 돌아온다.
+ *
+ * 인코딩(LED 당 24비트를 SPI 심볼로 펼친다 — 표를 써도 복사 72바이트) 뒤 spi_write()
+ * 가 EasyDMA 완료까지 블록한다. 42개면 메인 루프(매트릭스 스캔과 같은 스레드)가 프레임마다 그만큼 멈췄다.
+ *
+ * 버퍼는 셋이다:
+ *  - pixels    : QMK 가 그리는 곳(back). **계속 유지된다** — 바뀐 LED 만 다시 그리는 효과
+ *                (rgb_reactive.c)와 플래그로 빠진 LED 가 이전 값을 그대로 가져야 한다.
+ *                그래서 포인터를 맞바꾸지 않는다.
+ *  - tx_buf[2] : 스레드가 보내는 곳(front). Refresh 가 보내는 쪽이 아닌 칸에 채우고(스케일 포함)
+ *                인덱스만 넘긴다. 채우는 복사는 예전에 전송 전 pixels_sent 로 하던 복사와 같은 크기다.
+ * 스레드가 바쁜 사이 프레임이 둘 오면 기다리던 쪽을 새 프레임이 덮는다(최신 프레임만 의미가 있다).
+ *
+ * 우선순위는 메인 루프보다 낮다 — 루프가 잠들거나 기다릴 때 인코딩하고, DMA 동안은 CPU 를 안 쓴다.
+ */
+static struct led_rgb        tx_buf[2][WS2812_MAX_CH];
+static int8_t                tx_active = -1;   // 스레드가 보내는 중인 칸
+static int8_t                tx_ready  = -1;   // 보내길 기다리는 칸(최신 하나)
+static struct k_spinlock     tx_lock;
+static K_SEM_DEFINE(tx_sem, 0, 1);
+static K_SEM_DEFINE(tx_idle_sem, 0, 1);
+
+#define WS2812_TX_WAIT_MS     20   // 끄기 전에 마지막(검은) 프레임을 기다리는 한도 — 42 LED 전송은 ~1.3ms
+
+// 타이밍 — CLI `ws2812 timing`. 루프가 Refresh 에 묶인 시간 / 스레드의 전송 시간 / 프레임 간격.
+static uint32_t              stat_drop;
+static uint32_t              stat_tx_err;
+static uint32_t              t_refresh_max;
+static uint32_t              t_refresh_sum;
+static uint32_t              t_refresh_cnt;
+static uint32_t              t_tx_last;
+static uint32_t              t_tx_max;
+static uint32_t              t_frame_pre;
+static uint32_t              t_frame_min = UINT32_MAX;
+static uint32_t              t_frame_max;
+
+/*
+ * 레일 켜기는 **비동기**다 — flush 는 메인 루프(매트릭스 스캔과 같은 스레드)에서 불린다.
+ *
+ * 예전엔 ws2812SetPower(true) 가 SPI resume -> extPowerEnable() -> delay(2) 를 그 자리에서 했다.
+ * regulator-fixed 는 enable 안에서 startup-delay-us 만큼 또 잔다. idle 소등 뒤 키를 누를 때마다
+ * 그 키의 처리가 수 ms 밀렸다. 지금은:
+ *
+ *   OFF --SetPower(true)--> STARTING --work: resume/enable--> SETTLING --work(+2ms)--> ON
+ *
+ * 그 사이 flush 는 버퍼에 첫 프레임을 **그려만 두고** 보내지 않는다(tx_pending). ON 이 되면
+ * p_ready_func(qmkWake) 로 루프를 깨우고, 루프가 ws2812IsPending() 을 보고 그 프레임을 보낸다.
+ * SPI 는 항상 메인 루프에서만 쏜다 — 워크 스레드는 레일과 PM 만 만진다.
+ *
+ * 끄기는 **동기**다. 검은 프레임을 보낸 뒤 부르므로 순서(검정 -> 레일 down)는 그대로고,
+ * 켜는 중이었다면 워크가 끝나길 기다린 뒤 내린다(끄는 쪽은 지연이 문제 안 된다).
+ */
+#define WS2812_RAIL_SETTLE_MS   2   // startup-delay-us 뒤 안정화. 바로 쏘면 첫 프레임이 깨진다
+
+enum
+{
+  RAIL_OFF,
+  RAIL_STARTING,
+  RAIL_SETTLING,
+  RAIL_ON,
+};
+
+static atomic_t              rail_state   = ATOMIC_INIT(RAIL_OFF);
+static bool                  rail_enabled = false;   // 워크가 실제로 extPowerEnable() 했나
+static bool                  tx_pending   = false;   // 레일을 기다리는 프레임이 버퍼에 있다
+static void                (*p_ready_func)(void) = NULL;
+
+static void rail_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(rail_work, rail_work_handler);
+
 #if CLI_USE(HW_WS2812)
 static void cliWs2812(cli_args_t *args);
 #endif
 
 bool ws2812Init(void)
 {
-  if (!device_is_ready(strip_dev))
+  if (!strip_is_ready())
   {
     logPrintf("[E_] ws2812Init() not ready\n");
     return false;
@@ -71,35 +211,140 @@ void ws2812SetColor(uint32_t ch, uint32_t color)
   pixels[ch].b = (color >>  0) & 0xFF;
 }
 
-void ws2812SetPower(bool enable)
+static void ws2812TxThread(void *p1, void *p2, void *p3)
 {
-  if (enable == extPowerIsEnabled())
+  while (1)
   {
-    return;
+    k_sem_take(&tx_sem, K_FOREVER);
+
+    k_spinlock_key_t key = k_spin_lock(&tx_lock);
+    int8_t           idx = tx_ready;
+
+    tx_active = idx;
+    tx_ready  = -1;
+    k_spin_unlock(&tx_lock, key);
+
+    if (idx < 0)
+    {
+      continue;   // Refresh 가 채우는 중에 거둬 갔다 — 곧 다시 준다
+    }
+
+    uint32_t pre = micros();
+
+    if (strip_update(tx_buf[idx], WS2812_MAX_CH) != 0)
+    {
+      sent_valid = false;   // 스트립 상태를 모른다 — 다음 Refresh 가 같아도 다시 보낸다
+      stat_tx_err++;
+    }
+    t_tx_last = micros() - pre;
+    t_tx_max  = MAX(t_tx_max, t_tx_last);
+
+    key       = k_spin_lock(&tx_lock);
+    tx_active = -1;
+    k_spin_unlock(&tx_lock, key);
+    k_sem_give(&tx_idle_sem);
   }
+}
 
-  if (enable)
+K_THREAD_DEFINE(ws2812_tx_thread,
+                _HW_DEF_RTOS_THREAD_MEM_WS2812_TX,
+                ws2812TxThread, NULL, NULL, NULL,
+                _HW_DEF_RTOS_THREAD_PRI_WS2812_TX, 0, 0);
+
+static bool ws2812TxBusy(void)
+{
+  k_spinlock_key_t key  = k_spin_lock(&tx_lock);
+  bool             busy = tx_ready >= 0 || tx_active >= 0;
+
+  k_spin_unlock(&tx_lock, key);
+  return busy;
+}
+
+// 넘긴 프레임이 스트립에 다 나갈 때까지. 레일을 내리기 전에 검은 프레임을 기다리는 데 쓴다.
+static void ws2812WaitTx(void)
+{
+  uint32_t pre = millis();
+
+  while (ws2812TxBusy() && millis() - pre < WS2812_TX_WAIT_MS)
+  {
+    k_sem_take(&tx_idle_sem, K_MSEC(WS2812_TX_WAIT_MS));
+  }
+}
+
+static void rail_work_handler(struct k_work *work)
+{
+  if (atomic_get(&rail_state) == RAIL_STARTING)
   {
     if (device_is_ready(spi_dev))
     {
       pm_device_action_run(spi_dev, PM_DEVICE_ACTION_RESUME);   // -EALREADY 는 정상
     }
-    extPowerEnable();
-    delay(2);   // DTS startup-delay-us 후 레일 안정화. 바로 쏘면 첫 프레임이 깨진다
+    rail_enabled = extPowerEnable();
+
+    if (atomic_cas(&rail_state, RAIL_STARTING, RAIL_SETTLING))
+    {
+      k_work_reschedule(&rail_work, K_MSEC(WS2812_RAIL_SETTLE_MS));
+    }
+    return;
+  }
+
+  // 그 사이 꺼졌으면 cas 가 실패한다 — OFF 를 ON 으로 덮어쓰지 않는다.
+  if (atomic_cas(&rail_state, RAIL_SETTLING, RAIL_ON) && p_ready_func != NULL)
+  {
+    p_ready_func();
   }
-  else
+}
+
+void ws2812SetPower(bool enable)
+{
+  if (enable)
   {
-    extPowerDisable();
-    if (device_is_ready(spi_dev))
+    if (atomic_cas(&rail_state, RAIL_OFF, RAIL_STARTING))
     {
-      pm_device_action_run(spi_dev, PM_DEVICE_ACTION_SUSPEND);  // SPIM uninit
+      sent_valid = false;   // 레일이 바뀌면 스트립 상태를 모른다
+      k_work_reschedule(&rail_work, K_NO_WAIT);
     }
+    return;
+  }
+
+  if (atomic_get(&rail_state) == RAIL_OFF)
+  {
+    return;
+  }
+  ws2812WaitTx();   // 방금 넘긴 검은 프레임이 나간 뒤에 내린다
+  atomic_set(&rail_state, RAIL_OFF);
+
+  // 워크가 extPowerEnable() 중일 수 있다 — 끝나야 레일 참조 카운트가 맞는다.
+  struct k_work_sync sync;
+
+  k_work_cancel_delayable_sync(&rail_work, &sync);
+
+  sent_valid = false;
+  tx_pending = false;
+  if (rail_enabled)
+  {
+    extPowerDisable();
+    rail_enabled = false;
+  }
+  if (device_is_ready(spi_dev))
+  {
+    pm_device_action_run(spi_dev, PM_DEVICE_ACTION_SUSPEND);  // SPIM uninit
   }
 }
 
 bool ws2812IsPowered(void)
 {
-  return extPowerIsEnabled();
+  return atomic_get(&rail_state) == RAIL_ON;
+}
+
+bool ws2812IsPending(void)
+{
+  return tx_pending && ws2812IsPowered();
+}
+
+void ws2812SetReadyFunc(void (*func)(void))
+{
+  p_ready_func = func;
 }
 
 bool ws2812Refresh(void)
@@ -109,11 +354,191 @@ bool ws2812Refresh(void)
     return false;
   }
   // 레일이 내려가 있으면 전송이 무의미하다(그리고 SPI 만 깨워 전력을 먹는다).
-  if (!extPowerIsEnabled())
+  // 올라오는 중이면 버퍼만 남겨 둔다 — 레일이 안정되면 루프가 이 프레임을 보낸다.
+  if (!ws2812IsPowered())
+  {
+    sent_valid = false;
+    frame_same = false;
+    tx_pending = atomic_get(&rail_state) != RAIL_OFF;
+    return false;
+  }
+  tx_pending = false;
+
+  uint32_t pre = micros();
+
+  // 같은지 보면서 채널 최대 변화량도 잰다 — 애니메이션이 프레임당 얼마나 움직이는지(rgb_governor.c).
+  // scratch 바이트가 없으면 pixels 는 r,g,b 가 빈틈없이 붙은 바이트 배열이라 SIMD 로 한 번에 훑는다.
+  // CONFIG_LED_STRIP_RGB_SCRATCH 면 드라이버가 쓰는 scratch 바이트가 끼어 있어 채널만 골라 본다.
+  uint8_t delta = 0;
+
+  if (sent_valid)
+  {
+#ifdef CONFIG_LED_STRIP_RGB_SCRATCH
+    for (int i = 0; i < WS2812_MAX_CH; i++)
+    {
+      delta = MAX(delta, abs(pixels[i].r - pixels_sent[i].r));
+      delta = MAX(delta, abs(pixels[i].g - pixels_sent[i].g));
+      delta = MAX(delta, abs(pixels[i].b - pixels_sent[i].b));
+    }
+#else
+    BUILD_ASSERT(sizeof(struct led_rgb) == 3, "led_rgb 가 packed r,g,b 가 아니다");
+    delta = absdiff8_max((const uint8_t *)pixels, (const uint8_t *)pixels_sent, sizeof(pixels));
+#endif
+  }
+
+  if (sent_valid && delta == 0 && frame_scale == scale_sent && !overlay_dirty)
+  {
+    frame_same        = true;
+    frame_delta       = 0;
+    frame_delta_valid = true;
+    stat_skip++;
+    return true;   // 스트립에 이미 떠 있다
+  }
+  frame_same        = false;
+  frame_delta       = delta;
+  frame_delta_valid = sent_valid;
+
+  memcpy(pixels_sent, pixels, sizeof(pixels));
+  scale_sent = frame_scale;
+
+  // 스레드가 안 보내는 칸을 고른다. 그 칸에 기다리던 프레임이 있으면 거둬 간다(채우는 동안 집어 가지 않게).
+  k_spinlock_key_t key = k_spin_lock(&tx_lock);
+  int8_t           idx = (tx_active == 0) ? 1 : 0;
+
+  if (tx_ready >= 0)
+  {
+    stat_drop++;   // 스레드가 못 따라와 한 프레임을 건너뛴다
+    tx_ready = -1;
+  }
+  k_spin_unlock(&tx_lock, key);
+
+  // led_strip API 는 버퍼를 덮어쓸 수 있다(드라이버 재량) — pixels 가 아니라 tx_buf 를 넘긴다.
+  memcpy(tx_buf[idx], pixels, sizeof(pixels));
+  for (int i = 0; i < overlay_cnt; i++)
+  {
+    if (overlay[i].ch >= WS2812_MAX_CH)
+    {
+      continue;
+    }
+    struct led_rgb *p = &tx_buf[idx][overlay[i].ch];
+
+    p->r = (overlay[i].color >> 16) & 0xFF;
+    p->g = (overlay[i].color >>  8) & 0xFF;
+    p->b = (overlay[i].color >>  0) & 0xFF;
+  }
+  overlay_dirty = false;
+  if (frame_scale < WS2812_SCALE_FULL)
+  {
+    // scratch 바이트가 있어도 같이 줄여도 된다 — 드라이버 작업 공간이라 값에 의미가 없다.
+    scale8_buffer((uint8_t *)tx_buf[idx], sizeof(tx_buf[idx]), frame_scale);
+  }
+
+  key      = k_spin_lock(&tx_lock);
+  tx_ready = idx;
+  k_spin_unlock(&tx_lock, key);
+  k_sem_give(&tx_sem);
+
+  sent_valid = true;
+  stat_sent++;
+
+  uint32_t now = micros();
+
+  if (t_frame_pre != 0)
+  {
+    t_frame_min = MIN(t_frame_min, now - t_frame_pre);
+    t_frame_max = MAX(t_frame_max, now - t_frame_pre);
+  }
+  t_frame_pre    = now;
+  t_refresh_max  = MAX(t_refresh_max, now - pre);
+  t_refresh_sum += now - pre;
+  t_refresh_cnt++;
+  return true;
+}
+
+void ws2812SetScale(uint16_t scale)
+{
+  frame_scale = MIN(scale, WS2812_SCALE_FULL);
+}
+
+/*
+ * 버퍼 합에서 오버레이가 덮는 LED 를 오버레이 색으로 바꿔 넣는다 — Refresh 가 보낼 프레임과 같은 합이다.
+ * 항목이 많아야 WS2812_OVERLAY_MAX 라 덮임 검사(이중 루프)도 프레임마다 수십 번 비교다.
+ */
+uint32_t ws2812GetChannelSum(void)
+{
+  uint32_t sum = 0;
+
+#ifdef CONFIG_LED_STRIP_RGB_SCRATCH
+  for (int i = 0; i < WS2812_MAX_CH; i++)
+  {
+    sum += pixels[i].r + pixels[i].g + pixels[i].b;
+  }
+#else
+  sum = sum8_buffer((const uint8_t *)pixels, sizeof(pixels));
+#endif
+
+  for (int i = 0; i < overlay_cnt; i++)
+  {
+    if (overlay[i].ch >= WS2812_MAX_CH || overlay_is_shadowed(i))
+    {
+      continue;
+    }
+    const struct led_rgb *p = &pixels[overlay[i].ch];
+
+    sum -= p->r + p->g + p->b;
+    sum += ((overlay[i].color >> 16) & 0xFF) + ((overlay[i].color >> 8) & 0xFF) + (overlay[i].color & 0xFF);
+  }
+  return sum;
+}
+
+bool ws2812SetOverlay(const ws2812_overlay_t *list, uint8_t count)
+{
+  bool changed;
+
+  count   = MIN(count, WS2812_OVERLAY_MAX);
+  changed = count != overlay_cnt;
+
+  for (int i = 0; i < count && !changed; i++)
+  {
+    changed = list[i].ch != overlay[i].ch || list[i].color != overlay[i].color;
+  }
+  if (!changed)
   {
     return false;
   }
-  return led_strip_update_rgb(strip_dev, pixels, WS2812_MAX_CH) == 0;
+
+  if (count > 0)
+  {
+    memcpy(overlay, list, count * sizeof(ws2812_overlay_t));
+  }
+  overlay_cnt   = count;
+  overlay_dirty = true;
+  return true;
+}
+
+uint8_t ws2812GetOverlayCount(void)
+{
+  return overlay_cnt;
+}
+
+uint32_t ws2812GetFrameCount(void)
+{
+  return stat_sent + stat_skip;
+}
+
+uint8_t ws2812GetFrameDelta(void)
+{
+  return frame_delta;
+}
+
+bool ws2812IsFrameDeltaValid(void)
+{
+  return frame_delta_valid;
+}
+
+bool ws2812IsFrameUnchanged(void)
+{
+  return frame_same;
 }
 
 
@@ -126,10 +551,47 @@ void cliWs2812(cli_args_t *args)
 {
   bool ret = false;
 
+  /*
+   * 보낸 프레임만 센다(같아서 건너뛴 건 빠진다). 프레임 간격 min/max 의 차가 지터다 —
+   * 거버너가 주기를 바꾼 구간이 섞이면 그만큼 벌어지므로 효과/전원을 고정하고 본다.
+   * 출력 후 창을 비운다.
+   */
+  if (args->argc == 1 && args->isStr(0, "timing"))
+  {
+    cliPrintf("loop block : avg %d us, max %d us (%d frames)\n",
+              t_refresh_cnt ? t_refresh_sum / t_refresh_cnt : 0, t_refresh_max, t_refresh_cnt);
+    cliPrintf("tx thread  : last %d us, max %d us, err %d\n", t_tx_last, t_tx_max, stat_tx_err);
+    cliPrintf("interval   : min %d us, max %d us, jitter %d us\n",
+              t_frame_min == UINT32_MAX ? 0 : t_frame_min, t_frame_max,
+              t_frame_min == UINT32_MAX ? 0 : t_frame_max - t_frame_min);
+    cliPrintf("dropped    : %d (tx busy)\n", stat_drop);
+
+    t_refresh_max = 0;
+    t_refresh_sum = 0;
+    t_refresh_cnt = 0;
+    t_tx_max      = 0;
+    t_frame_pre   = 0;
+    t_frame_min   = UINT32_MAX;
+    t_frame_max   = 0;
+    ret = true;
+  }
+
+#ifdef CONFIG_KBD_WS2812_LUT
+  if (args->argc == 1 && args->isStr(0, "bench"))
+  {
+    ws2812SpiBench();
+    ret = true;
+  }
+#endif
+
   if (args->argc == 1 && args->isStr(0, "info"))
   {
     cliPrintf("led count  : %d\n", WS2812_MAX_CH);
-    cliPrintf("ext power  : %s\n", extPowerIsEnabled() ? "ON" : "OFF");
+    cliPrintf("ext power  : %s, rail %s\n", extPowerIsEnabled() ? "ON" : "OFF",
+              ws2812IsPowered() ? "ready" : (atomic_get(&rail_state) == RAIL_OFF ? "off" : "starting"));
+    cliPrintf("frames     : sent %d, skipped %d (unchanged)\n", stat_sent, stat_skip);
+    cliPrintf("scale      : %d / %d\n", frame_scale, WS2812_SCALE_FULL);
+    cliPrintf("overlay    : %d LEDs\n", overlay_cnt);
     cliPrintf("\n네오픽셀은 검은색을 표시해도 개당 ~0.7mA 를 먹는다(16개 ≈ 11mA).\n");
     cliPrintf("안 쓸 땐 반드시 ext power 를 내릴 것 — idle 80.9µA 의 140배다.\n");
     ret = true;
@@ -142,8 +604,11 @@ void cliWs2812(cli_args_t *args)
     uint8_t g = args->getData(2);
     uint8_t b = args->getData(3);
 
-    extPowerEnable();
-    delay(5);   // DTS startup-delay-us 후 레일 안정화
+    ws2812SetPower(true);
+    for (int i = 0; i < 10 && !ws2812IsPowered(); i++)
+    {
+      delay(1);   // CLI 는 기다려도 된다 — 레일이 안정될 때까지
+    }
     for (int i = 0; i < WS2812_MAX_CH; i++)
     {
       ws2812SetColor(i, WS2812_COLOR(r, g, b));
@@ -159,8 +624,7 @@ void cliWs2812(cli_args_t *args)
       ws2812SetColor(i, WS2812_COLOR_OFF);
     }
     ws2812Refresh();
-    delay(5);
-    extPowerDisable();   // 레일까지 내려야 전류가 실제로 0 이 된다
+    ws2812SetPower(false);   // 레일까지 내려야 전류가 실제로 0 이 된다
     cliPrintf("off (ext power down)\n");
     ret = true;
   }
@@ -168,6 +632,10 @@ void cliWs2812(cli_args_t *args)
   if (ret == false)
   {
     cliPrintf("ws2812 info\n");
+    cliPrintf("ws2812 timing              : 루프 블록 / 전송 시간 / 프레임 지터 (보고 후 초기화)\n");
+#ifdef CONFIG_KBD_WS2812_LUT
+    cliPrintf("ws2812 bench               : 인코딩 시간, 비트 루프 vs 표 (18 / 42 LED)\n");
+#endif
     cliPrintf("ws2812 color [r] [g] [b]   : 예) ws2812 color 32 0 0 -> 빨강(어둡게)\n");
     cliPrintf("ws2812 off                 : 소등 + 레일 내림\n");
   }
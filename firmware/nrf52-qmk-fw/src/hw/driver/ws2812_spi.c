@@ -0,0 +1,154 @@
+#include "ws2812_spi.h"
+
+#if defined(_USE_HW_WS2812) && defined(CONFIG_KBD_WS2812_LUT)
+#include "log.h"
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/dt-bindings/led/led.h>
+#include <zephyr/sys/util.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WS2812_NODE         DT_NODELABEL(led_strip)
+#define WS2812_ONE          DT_PROP(WS2812_NODE, spi_one_frame)
+#define WS2812_ZERO         DT_PROP(WS2812_NODE, spi_zero_frame)
+#define WS2812_NUM_COLORS   DT_PROP_LEN(WS2812_NODE, color_mapping)
+#define WS2812_SYM_BYTES    8   // 색 비트 1개 = SPI 1바이트(바인딩의 frame 이 8비트다) -> 색 바이트당 8B
+
+BUILD_ASSERT(WS2812_ONE <= 0xFF && WS2812_ZERO <= 0xFF, "spi-one/zero-frame 은 8비트 프레임이어야 한다");
+BUILD_ASSERT(WS2812_NUM_COLORS == 3, "color-mapping 은 RGB 3색만 지원한다(RGBW 스트립 아님)");
+
+/*
+ * 바이트 -> 심볼 표. 행 b 의 k 번째 바이트 = b 의 (7-k) 비트(MSB 먼저)가 1 이면 one-frame.
+ * 전처리기가 DTS 값으로 256 행을 펼친다 — 런타임 초기화도, 생성 스크립트도 없다.
+ */
+#define WS2812_LUT_SYM(b, k)  ((((b) >> (k)) & 1) ? WS2812_ONE : WS2812_ZERO)
+#define WS2812_LUT_ROW(b, ...)                                              \
+  { WS2812_LUT_SYM(b, 7), WS2812_LUT_SYM(b, 6), WS2812_LUT_SYM(b, 5),       \
+    WS2812_LUT_SYM(b, 4), WS2812_LUT_SYM(b, 3), WS2812_LUT_SYM(b, 2),       \
+    WS2812_LUT_SYM(b, 1), WS2812_LUT_SYM(b, 0) }
+
+static const uint8_t ws2812_lut[256][WS2812_SYM_BYTES] __aligned(4) = {
+  LISTIFY(256, WS2812_LUT_ROW, (,))
+};
+
+// 스트립에 나가는 순서(GRB 등). led_rgb 의 어느 필드인지 바이트 오프셋으로 바꿔 둔다.
+#define WS2812_CH_OFFSET(idx)                                                              \
+  ((DT_PROP_BY_IDX(WS2812_NODE, color_mapping, idx) == LED_COLOR_ID_RED)   ? offsetof(struct led_rgb, r) : \
+   (DT_PROP_BY_IDX(WS2812_NODE, color_mapping, idx) == LED_COLOR_ID_GREEN) ? offsetof(struct led_rgb, g) : \
+                                                                             offsetof(struct led_rgb, b))
+
+static const uint8_t ch_offset[3] = {WS2812_CH_OFFSET(0), WS2812_CH_OFFSET(1), WS2812_CH_OFFSET(2)};
+
+static const struct spi_dt_spec spi_spec =
+  SPI_DT_SPEC_GET(WS2812_NODE, SPI_OP_MODE_MASTER | SPI_TRANSFER_MSB | SPI_WORD_SET(8), 0);
+
+static uint8_t sym_buf[HW_WS2812_MAX_CH * 3 * WS2812_SYM_BYTES] __aligned(4);
+
+
+// 8바이트 memcpy 는 워드 로드/스토어 두 쌍으로 접힌다(표와 버퍼 둘 다 4바이트 정렬).
+static void encode_lut(uint8_t *dst, const struct led_rgb *pixels, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    const uint8_t *p_px = (const uint8_t *)&pixels[i];
+
+    for (int c = 0; c < 3; c++)
+    {
+      memcpy(dst, ws2812_lut[p_px[ch_offset[c]]], WS2812_SYM_BYTES);
+      dst += WS2812_SYM_BYTES;
+    }
+  }
+}
+
+// 순정 드라이버(ws2812_spi_ser)와 같은 비트 루프 — 벤치의 "before" 이자 표의 검증 기준.
+static void encode_bitloop(uint8_t *dst, const struct led_rgb *pixels, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    const uint8_t *p_px = (const uint8_t *)&pixels[i];
+
+    for (int c = 0; c < 3; c++)
+    {
+      uint8_t color = p_px[ch_offset[c]];
+
+      for (int k = 0; k < 8; k++)
+      {
+        *dst++ = (color & BIT(7 - k)) ? WS2812_ONE : WS2812_ZERO;
+      }
+    }
+  }
+}
+
+bool ws2812SpiInit(void)
+{
+  if (!spi_is_ready_dt(&spi_spec))
+  {
+    logPrintf("[E_] ws2812SpiInit() spi not ready\n");
+    return false;
+  }
+  return true;
+}
+
+int ws2812SpiUpdate(struct led_rgb *pixels, size_t count)
+{
+  count = MIN(count, HW_WS2812_MAX_CH);
+  encode_lut(sym_buf, pixels, count);
+
+  const struct spi_buf     buf = {.buf = sym_buf, .len = count * 3 * WS2812_SYM_BYTES};
+  const struct spi_buf_set tx  = {.buffers = &buf, .count = 1};
+  int                      ret = spi_write_dt(&spi_spec, &tx);
+
+  k_usleep(DT_PROP(WS2812_NODE, reset_delay));   // 래치 — 순정과 같다
+  return ret;
+}
+
+
+#define WS2812_BENCH_LOOP   100
+#define WS2812_BENCH_MAX    42
+
+static void bench_one(const struct led_rgb *pixels, size_t count)
+{
+  uint8_t  out_bit[WS2812_BENCH_MAX * 3 * WS2812_SYM_BYTES] __aligned(4);
+  uint8_t  out_lut[WS2812_BENCH_MAX * 3 * WS2812_SYM_BYTES] __aligned(4);
+  uint32_t pre;
+  uint32_t t_bit;
+  uint32_t t_lut;
+
+  pre = micros();
+  for (int n = 0; n < WS2812_BENCH_LOOP; n++)
+  {
+    encode_bitloop(out_bit, pixels, count);
+  }
+  t_bit = micros() - pre;
+
+  pre = micros();
+  for (int n = 0; n < WS2812_BENCH_LOOP; n++)
+  {
+    encode_lut(out_lut, pixels, count);
+  }
+  t_lut = micros() - pre;
+
+  logPrintf("     %2d LEDs : bit loop %4d us, lut %4d us / %d frames  %s\n", count, t_bit, t_lut,
+            WS2812_BENCH_LOOP, memcmp(out_bit, out_lut, count * 3 * WS2812_SYM_BYTES) == 0 ? "OK" : "MISMATCH");
+}
+
+void ws2812SpiBench(void)
+{
+  static struct led_rgb pixels[WS2812_BENCH_MAX];
+
+  // 0~255 전 구간이 표를 한 번씩 지나가게 — 값이 고르면 분기 예측이 비트 루프를 과하게 돕는다.
+  for (int i = 0; i < WS2812_BENCH_MAX; i++)
+  {
+    pixels[i].r = rand();
+    pixels[i].g = rand();
+    pixels[i].b = rand();
+  }
+
+  logPrintf("[  ] ws2812 encode bench (one 0x%02X, zero 0x%02X, lut %d B)\n", WS2812_ONE, WS2812_ZERO,
+            sizeof(ws2812_lut));
+  bench_one(pixels, 18);
+  bench_one(pixels, 42);
+}
+
+#endif
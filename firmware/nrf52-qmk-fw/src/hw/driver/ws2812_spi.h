@@ -0,0 +1,25 @@
+#ifndef WS2812_SPI_H_
+#define WS2812_SPI_H_
+
+#include "hw_def.h"
+
+#if defined(_USE_HW_WS2812) && defined(CONFIG_KBD_WS2812_LUT)
+#include <zephyr/drivers/led_strip.h>
+
+/*
+ * 네오픽셀 SPI 인코더 — Zephyr worldsemi,ws2812-spi 대신 driver/ws2812.c 가 고른다(Kconfig KBD_WS2812_LUT).
+ *
+ * 순정 드라이버는 색 바이트마다 비트를 하나씩 보며 spi-one-frame / spi-zero-frame 을 골라 쓴다
+ * (LED 당 24번 분기). 여기서는 **바이트 -> 심볼 8바이트** 표(256 x 8B = 2KB, flash)를 빌드할 때
+ * DTS 값으로 만들어 두고 채널마다 8바이트를 복사만 한다. 전송 형식(비트당 SPI 1바이트,
+ * color-mapping 순서, reset-delay)은 순정과 같다 — 스트립 입장에서 바뀌는 건 없다.
+ */
+bool ws2812SpiInit(void);
+int  ws2812SpiUpdate(struct led_rgb *pixels, size_t count);   // led_strip_update_rgb() 자리
+
+// CLI `ws2812 bench` — 순정식 비트 루프 vs 표, 18 / 42 LED 인코딩 시간(전송 제외). 결과도 비교한다.
+void ws2812SpiBench(void);
+
+#endif
+
+#endif
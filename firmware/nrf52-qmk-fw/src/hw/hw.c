@@ -5,6 +5,7 @@
 
 bool hwInit(void)
 {
+  bootProfInit();   // 가장 먼저 — 이후 단계의 기준점
   bspInit();
 
   ledInit();   // LED 없는 보드에선 no-op (led.h)
@@ -40,5 +41,6 @@ bool hwInit(void)
   // 키 매트릭스는 Zephyr gpio-kbd-matrix 드라이버가 자동 초기화(DTS kbd_matrix).
   // QMK 쪽 연결은 qmkInit() -> matrix_init() 에서 수행.
 
+  bootProfMark(BOOT_PROF_HW);
   return true;
 }
@@ -31,6 +31,7 @@ extern "C" {
 #include "ext_power.h"
 #include "eeprom.h"
 #include "usb.h"
+#include "boot_prof.h"
 
 bool hwInit(void);
 
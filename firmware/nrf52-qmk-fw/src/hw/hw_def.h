@@ -26,6 +26,11 @@
 #define _HW_DEF_RTOS_THREAD_PRI_USB_TX        5
 #define _HW_DEF_RTOS_THREAD_MEM_USB_TX        (1024)
 
+// 네오픽셀 전송 스레드 — 메인 루프보다 **낮다**(루프가 잘 때 보낸다). driver/ws2812.c 주석.
+// led_strip 드라이버가 심볼 버퍼를 자기 쪽에 들고 있어 스택은 작아도 된다.
+#define _HW_DEF_RTOS_THREAD_PRI_WS2812_TX     10
+#define _HW_DEF_RTOS_THREAD_MEM_WS2812_TX     (1024)
+
 
 
 #define _USE_HW_QSPI
@@ -71,6 +76,10 @@
 #define      HW_WS2812_MAX_CH       DT_PROP(DT_NODELABEL(led_strip), chain_length)
 #endif
 
+// 부팅 단계 타임스탬프(time-to-first-keystroke). 콘솔 없는 빌드에서도 VIA 로 꺼내 보도록 상시 켠다
+// — 단계당 micros() 한 번이라 비용이 없다. driver/boot_prof.c
+#define _USE_HW_BOOT_PROF
+
 // [저전력] 디버그 콘솔(UART/CLI/로그).
 //
 // _USE_HW_DEBUG_CONSOLE 은 여기서 정의하지 않는다 — CMake 의 -DDEBUG_CONSOLE=y 가
@@ -120,6 +129,18 @@
 #define _USE_CLI_HW_ACTIVITY        1
 #define _USE_CLI_HW_BLE             1
 #define _USE_CLI_HW_WS2812          1
+#define _USE_CLI_HW_VIA             1
+#define _USE_CLI_HW_BOOT_PROF       1
+#define _USE_CLI_HW_RGB             1
+#define _USE_CLI_HW_WAKE            1
+#define _USE_CLI_HW_TAPPING         1
+#define _USE_CLI_HW_DEADLINE        1
+#define _USE_CLI_HW_COMBO           1
+#define _USE_CLI_HW_DYNAMIC         1
+#define _USE_CLI_HW_LAYER           1
+#define _USE_CLI_HW_HOST            1
+#define _USE_CLI_HW_MOUSE           1
+#define _USE_CLI_HW_MATRIX          1
 
 
 #endif
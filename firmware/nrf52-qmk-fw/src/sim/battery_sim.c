@@ -0,0 +1,59 @@
+#include "battery.h"
+#include "sim.h"
+#include "log.h"
+
+/*
+ * battery.c 의 대역 — 측정 없이 --battery-mv 를 그대로 돌려준다.
+ * 잔량은 3.3V~4.2V 직선이다. 실보드의 방전 곡선(battery.c)을 옮기지 않은 건 sim 에서 보는 게
+ * "잔량 부족이면 정책이 바뀌나"(rgb_governor, rgb_limiter) 이지 곡선의 모양이 아니라서다.
+ */
+#define SIM_BAT_MV_EMPTY   3300
+#define SIM_BAT_MV_FULL    4200
+
+static bool     is_init = false;
+static uint16_t bat_mv;
+static uint8_t  bat_pct;
+
+
+bool batteryInit(void)
+{
+  is_init = true;
+  batteryUpdate();
+
+  logPrintf("[OK] batteryInit() sim : %d mV, %d%%\n", bat_mv, bat_pct);
+  return true;
+}
+
+bool batteryUpdate(void)
+{
+  if (!is_init)
+  {
+    return false;
+  }
+
+  uint32_t mv = constrain(sim_battery_mv, SIM_BAT_MV_EMPTY, SIM_BAT_MV_FULL);
+
+  bat_mv  = (uint16_t)sim_battery_mv;
+  bat_pct = (uint8_t)((mv - SIM_BAT_MV_EMPTY) * 100 / (SIM_BAT_MV_FULL - SIM_BAT_MV_EMPTY));
+  return true;
+}
+
+bool batteryGetVoltage(uint16_t *p_mv)
+{
+  if (!is_init)
+  {
+    return false;
+  }
+  *p_mv = bat_mv;
+  return true;
+}
+
+bool batteryGetPercent(uint8_t *p_pct)
+{
+  if (!is_init)
+  {
+    return false;
+  }
+  *p_pct = bat_pct;
+  return true;
+}
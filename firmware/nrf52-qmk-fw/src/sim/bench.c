@@ -0,0 +1,442 @@
+#include "sim.h"
+#include "qmk/qmk.h"
+#include "qmk/port/combo/combo_port.h"
+#include "qmk/port/layer/layer_cache.h"
+#include "qmk/port/rgb_batch.h"
+#include "matrix.h"
+#include "cmdline.h"
+#include "posix_native_task.h"
+#include "posix_board_if.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <stdlib.h>
+#ifdef DEBOUNCE_RUNTIME
+#include "debounce_cfg.h"
+#endif
+
+/*
+ * 키 입력 지연 벤치 — `--bench` 일 때만 돈다.
+ *
+ * 매트릭스 스크립트(kbd_matrix_sim.c)가 엣지를 낼 때마다 기록하고, 그 뒤 나간 키보드/확장 리포트
+ * (hid_sink.c)가 **디바운스를 통과한** 대기 엣지를 해소한다 — 리포트 시점에 matrix_get_row() 의 그 비트가 엣지의
+ * 방향과 같아야 한다. 그렇지 않으면 앞 키의 리포트가 디바운스 중인 다음 키를 가져가 지연이 1ms 로 찍힌다
+ * (겹쳐 치는 타이핑에서 실제로 났다). 엣지 하나마다:
+ *   lat_us  : 엣지 -> 리포트, 시뮬레이션 시각(재현된다)
+ *   wakeups : 그 사이 메인 루프 회차(qmkUpdate 횟수 = 루프가 깨어난 횟수)
+ *   cpu_us  : 그 사이 호스트 프로세스 CPU 시간(상대 비교용 — 실행마다 조금씩 다르다)
+ *
+ * [한계] 리포트를 안 내는 키(MO 레이어, 이미 눌린 키와 같은 코드)는 **다음 리포트**에 묶인다 —
+ * 그 엣지의 지연은 "그 키의 지연" 이 아니다. 탭/홀드 키는 뗄 때 탭이 나가므로 누름 엣지의 지연에
+ * 누른 시간이 들어간다. 그래서 요약은 지연을 누름/뗌으로 나눠 보이고, 트레이스 간 비교는 같은 트레이스로만 한다.
+ *
+ * 출력은 한 줄에 JSON 하나, 접두어 "BENCH " (grep 후 잘라서 jq 등으로 읽는다):
+ *   BENCH {"key":0,"row":0,"col":1,"act":"d","t_us":500000,"lat_us":2000,"wakeups":2,"cpu_us":41}
+ *   BENCH {"summary":{...}}       <- 스크립트의 exit 에서(simBenchExit). --stop_at 으로 끊으면 요약은 없다
+ */
+#define BENCH_EDGE_MAX      4096
+#define BENCH_PENDING_MAX   64
+
+typedef struct
+{
+  uint32_t t_us;
+  uint32_t loop;
+  uint64_t cpu_us;
+  uint16_t idx;
+  uint8_t  row;
+  uint8_t  col;
+  bool     pressed;
+} bench_edge_t;
+
+static bool         bench_on = false;
+static bench_edge_t pending[BENCH_PENDING_MAX];
+static uint32_t     pending_cnt = 0;
+static uint32_t     edge_cnt    = 0;
+static uint32_t     report_cnt  = 0;
+static uint32_t     dropped_cnt = 0;   // 대기열이 넘쳐 못 잰 엣지
+static uint32_t     lat_down[BENCH_EDGE_MAX];
+static uint32_t     lat_up[BENCH_EDGE_MAX];
+static uint32_t     lat_down_cnt = 0;
+static uint32_t     lat_up_cnt   = 0;
+static uint32_t     start_loop;
+static uint64_t     start_cpu_us;
+
+
+void simBenchEdge(uint8_t row, uint8_t col, bool pressed)
+{
+  if (!bench_on)
+  {
+    return;
+  }
+  if (edge_cnt == 0)
+  {
+    start_loop   = qmkGetLoopCount();
+    start_cpu_us = simHostCpuUs();
+  }
+
+  if (pending_cnt >= BENCH_PENDING_MAX)
+  {
+    dropped_cnt++;
+    edge_cnt++;
+    return;
+  }
+
+  bench_edge_t *p_edge = &pending[pending_cnt++];
+
+  p_edge->t_us    = micros();
+  p_edge->loop    = qmkGetLoopCount();
+  p_edge->cpu_us  = simHostCpuUs();
+  p_edge->idx     = (uint16_t)edge_cnt++;
+  p_edge->row     = row;
+  p_edge->col     = col;
+  p_edge->pressed = pressed;
+}
+
+void simBenchReport(void)
+{
+  if (!bench_on || pending_cnt == 0)
+  {
+    return;
+  }
+
+  uint32_t now_us  = micros();
+  uint32_t now_lp  = qmkGetLoopCount();
+  uint64_t now_cpu = simHostCpuUs();
+  uint32_t keep    = 0;
+  bool     done[BENCH_PENDING_MAX];
+
+  // 같은 키의 뒤 엣지가 통과했으면 앞 엣지도 통과했다 — 탭 키는 뗄 때에야 리포트가 나가
+  // 그 시점의 매트릭스는 누름 엣지와 반대다. 뒤에서부터 보며 물려준다.
+  for (int32_t i = (int32_t)pending_cnt - 1; i >= 0; i--)
+  {
+    done[i] = ((matrix_get_row(pending[i].row) >> pending[i].col) & 1) == pending[i].pressed;
+    for (uint32_t j = (uint32_t)i + 1; j < pending_cnt && !done[i]; j++)
+    {
+      done[i] = done[j] && pending[j].row == pending[i].row && pending[j].col == pending[i].col;
+    }
+  }
+
+  report_cnt++;
+  for (uint32_t i = 0; i < pending_cnt; i++)
+  {
+    const bench_edge_t *p_edge = &pending[i];
+    uint32_t            lat_us = now_us - p_edge->t_us;
+
+    if (!done[i])
+    {
+      pending[keep++] = *p_edge;   // 아직 디바운스 중 — 이 리포트는 그 키의 것이 아니다
+      continue;
+    }
+
+    printk("BENCH {\"key\":%u,\"row\":%u,\"col\":%u,\"act\":\"%c\",\"t_us\":%u,\"lat_us\":%u,"
+           "\"wakeups\":%u,\"cpu_us\":%u}\n",
+           p_edge->idx, p_edge->row, p_edge->col, p_edge->pressed ? 'd' : 'u', p_edge->t_us, lat_us,
+           now_lp - p_edge->loop, (uint32_t)(now_cpu - p_edge->cpu_us));
+
+    if (p_edge->pressed && lat_down_cnt < BENCH_EDGE_MAX)
+    {
+      lat_down[lat_down_cnt++] = lat_us;
+    }
+    if (!p_edge->pressed && lat_up_cnt < BENCH_EDGE_MAX)
+    {
+      lat_up[lat_up_cnt++] = lat_us;
+    }
+  }
+  pending_cnt = keep;
+}
+
+
+static int bench_cmp_u32(const void *a, const void *b)
+{
+  uint32_t va = *(const uint32_t *)a;
+  uint32_t vb = *(const uint32_t *)b;
+
+  return (va > vb) - (va < vb);
+}
+
+// 정렬된 표에서 백분위(최근접 순위). 비어 있으면 0.
+static uint32_t bench_pct(const uint32_t *tbl, uint32_t cnt, uint32_t pct)
+{
+  if (cnt == 0)
+  {
+    return 0;
+  }
+  return tbl[((cnt - 1) * pct + 50) / 100];
+}
+
+static void bench_print_lat(const char *name, uint32_t *tbl, uint32_t cnt)
+{
+  qsort(tbl, cnt, sizeof(uint32_t), bench_cmp_u32);
+  printk("\"%s\":{\"n\":%u,\"p50_us\":%u,\"p90_us\":%u,\"p99_us\":%u,\"max_us\":%u}", name, cnt,
+         bench_pct(tbl, cnt, 50), bench_pct(tbl, cnt, 90), bench_pct(tbl, cnt, 99),
+         cnt ? tbl[cnt - 1] : 0);
+}
+
+/*
+ * 스크립트의 exit 줄에서(kbd_matrix_sim.c, posix_exit 직전) 스크립트 스레드가 부른다 — 펌웨어 상태를
+ * 읽으므로 native_sim 종료 훅(ON_EXIT_PRE, 스레드 밖)이 아니라 **스레드 안**에서 요약한다.
+ * 비교할 노브(태스크 주기, 디바운스, 태핑)를 같이 찍어 두어 결과 파일만 보고도 조건을 안다.
+ */
+void simBenchExit(void)
+{
+  if (!bench_on)
+  {
+    return;
+  }
+
+  uint32_t loops = qmkGetLoopCount() - start_loop;
+#ifdef DEBOUNCE_RUNTIME
+  uint32_t debounce_ms = debounce_time_get();   // VIA 로 바꾼 값이 EEPROM(--eeprom 파일)에 남아 있을 수 있다
+#else
+  uint32_t debounce_ms = DEBOUNCE;
+#endif
+
+  printk("BENCH {\"summary\":{\"edges\":%u,\"reports\":%u,\"unresolved\":%u,\"dropped\":%u,",
+         edge_cnt, report_cnt, pending_cnt, dropped_cnt);
+  bench_print_lat("press", lat_down, lat_down_cnt);
+  printk(",");
+  bench_print_lat("release", lat_up, lat_up_cnt);
+  printk(",\"wakeups\":%u,\"wakeups_per_edge\":%u.%02u,\"cpu_us\":%u,", loops,
+         edge_cnt ? loops / edge_cnt : 0, edge_cnt ? (loops * 100 / edge_cnt) % 100 : 0,
+         edge_cnt ? (uint32_t)(simHostCpuUs() - start_cpu_us) : 0);
+  printk("\"config\":{\"task_period_ms\":%u,\"debounce_ms\":%u,\"tapping_term_ms\":%u}}}\n",
+         QMK_TASK_PERIOD_MS, debounce_ms, TAPPING_TERM);
+}
+
+
+/*
+ * 콤보 후보 인덱스 벤치 — `--combo-bench` 일 때 벤치 스레드가 한 번 돌린다(port/combo/combo_port.h, 아래 bench_thread).
+ *
+ * 합성 콤보 16/64/256 개(2키, 글자/숫자/F키 48개 풀)를 깔고, 같은 타이핑 스트림(글자 + 스페이스)을
+ * process_combo() 에 직접 넣어 이벤트당 호스트 CPU 시간을 잰다. 인덱스와 순정 전수 검사를 번갈아
+ * 같은 스트림으로 돌린다 — 절대값은 호스트마다 다르니 **두 줄의 비율과 N 에 따른 기울기**를 본다.
+ *
+ * 레코드의 keycode 는 KC_TRNS 다 — 후보 키를 뗄 때 순정이 버퍼를 일반 키로 내보내는데(dump_key_buffer),
+ * 그게 실제 리포트로 나가면 HID 싱크 출력이 섞인다. 콤보는 다 채워지지 않아(한 번에 한 키) 발동하지 않는다.
+ *   BENCH {"combo":{"n":64,"events":20000,"indexed":true,"index_ns":<ns>,"scan_ns":<ns>}}
+ */
+#define COMBO_BENCH_MAX     256
+#define COMBO_BENCH_EVENTS  20000
+
+static bool combo_bench_on = false;
+
+static uint64_t bench_combo_run(const uint16_t *stream, uint32_t stream_len)
+{
+  uint64_t start_us = simHostCpuUs();
+
+  for (uint32_t i = 0; i < COMBO_BENCH_EVENTS; i++)
+  {
+    keyrecord_t record = {
+      .event   = MAKE_KEYEVENT(0, 0, (i & 1) == 0),
+      .keycode = KC_TRNS,
+    };
+
+    process_combo(stream[(i / 2) % stream_len], &record);
+  }
+  return simHostCpuUs() - start_us;
+}
+
+static void bench_combo(void)
+{
+  static const uint16_t text[] = {
+    KC_T, KC_H, KC_E, KC_SPC, KC_Q, KC_U, KC_I, KC_C, KC_K, KC_SPC, KC_B, KC_R, KC_O, KC_W, KC_N, KC_SPC,
+    KC_F, KC_O, KC_X, KC_SPC, KC_J, KC_U, KC_M, KC_P, KC_S, KC_SPC, KC_O, KC_V, KC_E, KC_R, KC_SPC,
+    KC_L, KC_A, KC_Z, KC_Y, KC_SPC, KC_D, KC_O, KC_G, KC_SPC,
+  };
+  static const uint16_t n_tbl[] = {16, 64, 256};
+  static uint16_t       pool[48];
+  static uint16_t       keys[COMBO_BENCH_MAX][3];
+  static combo_t        combos[COMBO_BENCH_MAX];
+
+  if (!combo_bench_on)
+  {
+    return;
+  }
+
+  for (uint8_t i = 0; i < 48; i++)
+  {
+    pool[i] = (i < 26) ? KC_A + i : (i < 36) ? KC_1 + (i - 26) : KC_F1 + (i - 36);
+  }
+  // 콤보 i = {pool[i % 48], pool[(i % 48 + i / 48 + 1) % 48]} — 256 개까지 두 키가 늘 다르다.
+  for (uint16_t i = 0; i < COMBO_BENCH_MAX; i++)
+  {
+    keys[i][0] = pool[i % 48];
+    keys[i][1] = pool[(i % 48 + i / 48 + 1) % 48];
+    keys[i][2] = COMBO_END;
+    combos[i]  = (combo_t)COMBO_ACTION(keys[i]);
+  }
+
+  for (uint8_t n = 0; n < ARRAY_SIZE(n_tbl); n++)
+  {
+    combo_port_set_table(combos, n_tbl[n]);
+
+    combo_port_set_scan(false);
+    uint64_t index_us = bench_combo_run(text, ARRAY_SIZE(text));
+    combo_port_set_scan(true);
+    uint64_t scan_us  = bench_combo_run(text, ARRAY_SIZE(text));
+    combo_port_set_scan(false);
+
+    printk("BENCH {\"combo\":{\"n\":%u,\"events\":%u,\"indexed\":%s,\"index_ns\":%u,\"scan_ns\":%u}}\n",
+           n_tbl[n], COMBO_BENCH_EVENTS, combo_port_is_indexed() ? "true" : "false",
+           (uint32_t)(index_us * 1000 / COMBO_BENCH_EVENTS), (uint32_t)(scan_us * 1000 / COMBO_BENCH_EVENTS));
+  }
+  combo_port_set_table(NULL, 0);   // 키맵 표로 되돌린다
+}
+
+
+/*
+ * 레이어 조회 캐시 벤치 — `--layer-bench` 일 때 벤치 스레드가 한 번 돌린다(port/layer/layer_cache.h).
+ *
+ * 보드 키맵 그대로 MO 를 굴린다: 레이어 1 -> 2 -> ... -> 7 을 겹쳐 누르고(다음 것을 켠 뒤 앞의 것을 끈다)
+ * 한 레이어에 있는 동안 키 몇 개를 친다. 키마다 store_or_get_action() — 누를 때 action.c 가 타는 길 —
+ * 을 부른다. 캐시 켬/끔을 같은 시퀀스로 돌리고, 고른 레이어의 체크섬이 같아야 한다(match).
+ *   BENCH {"layer":{"layers":8,"lookups":20000,"cached_ns":<ns>,"vendor_ns":<ns>,"match":true}}
+ * cached_ns 에는 레이어가 바뀔 때 따라가는 비용(layer_cache_update)도 들어 있다.
+ */
+#define LAYER_BENCH_LOOKUPS   20000
+#define LAYER_BENCH_PER_HOLD  4       // 레이어 하나를 누른 동안 치는 키 수
+
+static bool layer_bench_on = false;
+
+static uint64_t bench_layer_run(uint32_t *sum)
+{
+  uint64_t start_us = simHostCpuUs();
+  uint32_t keys     = MATRIX_ROWS * MATRIX_COLS;
+  uint8_t  layer    = 0;
+
+  *sum = 0;
+  layer_clear();
+  for (uint32_t i = 0; i < LAYER_BENCH_LOOKUPS; i++)
+  {
+    if (i % LAYER_BENCH_PER_HOLD == 0)
+    {
+      uint8_t next = (layer + 1 < MAX_LAYER) ? layer + 1 : 1;
+
+      layer_on(next);
+      layer_off(layer);
+      layer = next;
+    }
+
+    uint32_t k   = (i * 7) % keys;
+    keypos_t key = MAKE_KEYPOS(k / MATRIX_COLS, k % MATRIX_COLS);
+
+    *sum = *sum * 31 + store_or_get_action(true, key).code;
+  }
+  layer_clear();
+
+  return simHostCpuUs() - start_us;
+}
+
+static void bench_layer(void)
+{
+  uint32_t cached_sum;
+  uint32_t vendor_sum;
+
+  if (!layer_bench_on)
+  {
+    return;
+  }
+
+  layer_cache_set_enable(true);
+  uint64_t cached_us = bench_layer_run(&cached_sum);
+  layer_cache_set_enable(false);
+  uint64_t vendor_us = bench_layer_run(&vendor_sum);
+  layer_cache_set_enable(true);
+
+  printk("BENCH {\"layer\":{\"layers\":%u,\"lookups\":%u,\"cached_ns\":%u,\"vendor_ns\":%u,\"match\":%s}}\n",
+         MAX_LAYER, LAYER_BENCH_LOOKUPS, (uint32_t)(cached_us * 1000 / LAYER_BENCH_LOOKUPS),
+         (uint32_t)(vendor_us * 1000 / LAYER_BENCH_LOOKUPS), cached_sum == vendor_sum ? "true" : "false");
+}
+
+
+/*
+ * --rgb-golden : 배치 커널(HSV->RGB, scale8/qadd8/qsub8/blend8)을 lib8tion/color.c 스칼라와 비교한다
+ * (rgb_batch_selftest, CLI `rgb simd` 와 같은 것). 불일치가 하나라도 있으면 종료 코드 1 — CI 가 본다.
+ * native_sim 은 __ARM_FEATURE_SIMD32 가 없어 커널의 스칼라 경로를 보는 것이고, SIMD32 경로는 보드에서
+ * `rgb simd` 로 본다.
+ */
+static bool rgb_golden_on = false;
+
+static uint32_t bench_rgb_golden(void)
+{
+  if (!rgb_golden_on)
+  {
+    return 0;
+  }
+
+  uint32_t err = rgb_batch_selftest();
+
+  printk("BENCH {\"rgb_golden\":{\"mismatch\":%u}}\n", err);
+  return err;
+}
+
+
+/*
+ * --combo-bench / --layer-bench / --rgb-golden 은 트레이스 없이 이 스레드가 돌리고 끝낸다. 부팅이 정착한 뒤(스크립트
+ * 트레이스와 같은 자리) 스케줄러를 잠그고 돌린다 — 메인 루프가 같은 콤보/레이어 상태를 중간에 만지지 않게.
+ */
+#define BENCH_START_MS    1000
+
+static void bench_thread(void *p1, void *p2, void *p3)
+{
+  ARG_UNUSED(p1);
+  ARG_UNUSED(p2);
+  ARG_UNUSED(p3);
+
+  if (!combo_bench_on && !layer_bench_on && !rgb_golden_on)
+  {
+    return;
+  }
+
+  k_sched_lock();
+  bench_combo();
+  bench_layer();
+  uint32_t err = bench_rgb_golden();
+  k_sched_unlock();
+
+  posix_exit(err ? 1 : 0);
+}
+
+K_THREAD_DEFINE(bench_tid,
+                _HW_DEF_RTOS_THREAD_MEM_SIM_BENCH,
+                bench_thread, NULL, NULL, NULL,
+                _HW_DEF_RTOS_THREAD_PRI_SIM_BENCH, 0, BENCH_START_MS);
+
+
+static void bench_add_options(void)
+{
+  static struct args_struct_t bench_args[] = {
+    {
+      .is_switch = true,
+      .option    = "bench",
+      .type      = 'b',
+      .dest      = (void *)&bench_on,
+      .descript  = "Measure edge-to-report latency per key and print BENCH lines",
+    },
+    {
+      .is_switch = true,
+      .option    = "combo-bench",
+      .type      = 'b',
+      .dest      = (void *)&combo_bench_on,
+      .descript  = "After boot, time process_combo() per event with 16/64/256 synthetic combos, then exit",
+    },
+    {
+      .is_switch = true,
+      .option    = "layer-bench",
+      .type      = 'b',
+      .dest      = (void *)&layer_bench_on,
+      .descript  = "After boot, time the per-key layer lookup during an 8-layer MO roll, cached and upstream, then exit",
+    },
+    {
+      .is_switch = true,
+      .option    = "rgb-golden",
+      .type      = 'b',
+      .dest      = (void *)&rgb_golden_on,
+      .descript  = "After boot, compare the batch RGB kernels against lib8tion/color.c, then exit (1 on mismatch)",
+    },
+    ARG_TABLE_ENDMARKER
+  };
+
+  native_add_command_line_opts(bench_args);
+}
+
+NATIVE_TASK(bench_add_options, PRE_BOOT_1, 10);
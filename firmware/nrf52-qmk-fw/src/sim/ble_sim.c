@@ -0,0 +1,177 @@
+#include "ble.h"
+#include "sim.h"
+#include "log.h"
+#include "boot_prof.h"
+
+/*
+ * port/ble.c 의 대역 — BT 스택 없이 ble.h 의 API 만.
+ *
+ * 호스트는 `--ble` 일 때 프로파일 0 에 하나 붙어 있는 것으로 친다(본딩 = 연결). 프로파일을 바꾸면
+ * 실보드처럼 그 프로파일의 호스트로만 보낸다 — 다른 프로파일엔 아무도 없으니 리포트가 안 나간다.
+ * 연결 이벤트 간격(7.5~15ms)과 slave latency 는 흉내 내지 않는다 — 리포트 시각은 루프가 넘긴 시각이다.
+ * 본딩/프로파일은 영속화하지 않는다(settings 가 없다). 실행마다 처음 상태다.
+ */
+static bool    is_init        = false;
+static uint8_t active_profile = 0;
+static uint8_t bonded_mask    = 0;   // 비트 i = 프로파일 i 에 호스트가 있다(sim 에선 = 연결)
+static int8_t  tx_power_dbm   = 0;
+static bool  (*ble_via_receive_cb)(uint8_t *data, uint8_t length) = NULL;
+
+
+bool bleInit(void)
+{
+  bonded_mask = sim_ble_on ? BIT(0) : 0;
+  is_init     = true;
+
+  bootProfMark(BOOT_PROF_BLE);
+  logPrintf("[OK] bleInit() sim, profile %d/%d %s\n", active_profile, BLE_PROFILE_COUNT,
+            bleProfileIsOpen(active_profile) ? "(open)" : "(bonded)");
+  return true;
+}
+
+// 실보드에선 스택 준비 뒤 광고를 올리는 자리. sim 은 bleInit() 에서 이미 준비돼 있다.
+void bleUpdate(void)
+{
+}
+
+bool bleIsConnected(void)
+{
+  return is_init && bleProfileIsConnected(active_profile);
+}
+
+bool bleSendKeyboard(report_keyboard_t *report)
+{
+  if (!bleIsConnected())
+  {
+    return false;
+  }
+  simHidRecord("ble", "kbd", (const uint8_t *)report, KEYBOARD_REPORT_SIZE);
+  return true;
+}
+
+// HOG 는 characteristic 으로 ID 를 가르고 usage 만 싣지만, 싱크는 USB 와 같은 모양(ID 포함)으로 남긴다.
+bool bleSendExtra(report_extra_t *report)
+{
+  if (!bleIsConnected())
+  {
+    return false;
+  }
+  simHidRecord("ble", "exk", (const uint8_t *)report, sizeof(report_extra_t));
+  return true;
+}
+
+bool bleSendMouse(report_mouse_t *report)
+{
+  if (!bleIsConnected())
+  {
+    return false;
+  }
+  simHidRecord("ble", "mouse", (const uint8_t *)report, sizeof(report_mouse_t));
+  return true;
+}
+
+// 연결 간격은 흉내 내지 않는다(위) — 0 = 모름, 부르는 쪽(mousekey_port.c)이 기본 주기로 돈다.
+uint32_t bleGetConnIntervalUs(void)
+{
+  return 0;
+}
+
+uint8_t bleGetKbdLeds(void)
+{
+  return simHostGetLeds();
+}
+
+void bleSetViaReceiveFunc(bool (*func)(uint8_t *data, uint8_t length))
+{
+  ble_via_receive_cb = func;
+}
+
+// 실보드에선 BT RX 스레드가 VIA output 리포트마다 부르는 자리. --via-stress 스레드가 부른다.
+bool simBleViaReceive(uint8_t *data, uint8_t length)
+{
+  if (ble_via_receive_cb == NULL || !bleIsConnected())
+  {
+    return false;
+  }
+  return ble_via_receive_cb(data, length);
+}
+
+bool bleSendVia(uint8_t *data, uint8_t len)
+{
+  if (!bleIsConnected())
+  {
+    return false;
+  }
+  simHidRecord("ble", "via", data, len);
+  return true;
+}
+
+
+uint8_t bleProfileGetActive(void)
+{
+  return active_profile;
+}
+
+bool bleProfileSelect(uint8_t index)
+{
+  if (!is_init || index >= BLE_PROFILE_COUNT || index == active_profile)
+  {
+    return false;
+  }
+  active_profile = index;
+  logPrintf("[  ] ble profile %d %s\n", index, bleProfileIsOpen(index) ? "(open)" : "(bonded)");
+  return true;
+}
+
+bool bleProfileNext(void)
+{
+  return bleProfileSelect((active_profile + 1) % BLE_PROFILE_COUNT);
+}
+
+bool bleProfilePrev(void)
+{
+  return bleProfileSelect((active_profile + BLE_PROFILE_COUNT - 1) % BLE_PROFILE_COUNT);
+}
+
+bool bleProfileClear(uint8_t index)
+{
+  if (!is_init || index >= BLE_PROFILE_COUNT)
+  {
+    return false;
+  }
+  bonded_mask &= ~BIT(index);
+  return true;
+}
+
+bool bleProfileClearActive(void)
+{
+  return bleProfileClear(active_profile);
+}
+
+void bleProfileClearAll(void)
+{
+  bonded_mask    = 0;
+  active_profile = 0;
+}
+
+bool bleProfileIsOpen(uint8_t index)
+{
+  return index < BLE_PROFILE_COUNT && (bonded_mask & BIT(index)) == 0;
+}
+
+bool bleProfileIsConnected(uint8_t index)
+{
+  return index < BLE_PROFILE_COUNT && (bonded_mask & BIT(index)) != 0;
+}
+
+
+bool bleSetTxPower(int8_t dbm)
+{
+  tx_power_dbm = dbm;
+  return true;
+}
+
+int8_t bleGetTxPower(void)
+{
+  return tx_power_dbm;
+}
@@ -0,0 +1,39 @@
+#include "sim.h"
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+/*
+ * 호스트가 받았을 리포트를 한 줄씩 남긴다:
+ *
+ *   HID <t_us> <usb|ble> <kbd|exk|mouse|via> <hex bytes...>
+ *
+ * logPrintf 가 아니라 printk 다 — 로그는 DEBUG_CONSOLE 빌드에만 있고, 이 줄은 sim 의 **출력 자체**라
+ * 릴리스 설정에서도 나와야 한다(native_sim 의 printk 는 stdout 이다). 접두어 "HID " 로 grep 해서
+ * 로그와 섞여도 가른다. 시각은 시뮬레이션 시각이라 같은 스크립트면 같은 값이 나온다.
+ */
+void simHidRecord(const char *transport, const char *kind, const uint8_t *data, uint16_t len)
+{
+  // --tap-vectors / --tap-bench 가 리포트를 잡는 중이면 줄로 찍지 않는다(수만 줄이 벤치 시간을 덮는다).
+  if (simTapReport(transport, kind, data, len))
+  {
+    return;
+  }
+
+  printk("HID %u %s %s", micros(), transport, kind);
+  for (uint16_t i = 0; i < len; i++)
+  {
+    printk(" %02x", data[i]);
+  }
+  printk("\n");
+
+  // VIA 응답은 키 엣지와 무관하다 — 지연 벤치는 키보드/확장/마우스 리포트로만 해소한다.
+  if (strcmp(kind, "via") != 0)
+  {
+    simBenchReport();
+  }
+  else
+  {
+    simViaStressResponse(transport, data, len);
+    simViaBenchResponse(transport, data, len);
+  }
+}
@@ -0,0 +1,20 @@
+/*
+ * 호스트 쪽(native_simulator 러너)에서 컴파일된다 — 호스트 libc 의 clock_gettime 을 쓰려고.
+ * 펌웨어 쪽은 sim.h 의 simHostCpuUs() 선언만 보고 링크 때 붙는다.
+ * CMakeLists.txt 가 target_sources(native_simulator ...) 로 넣는다(src/sim/*.c glob 에 안 걸리게 하위 폴더).
+ */
+#include <stdint.h>
+#include <time.h>
+
+/*
+ * 프로세스가 실제로 쓴 CPU 시간(µs). native_sim 은 모든 스레드가 쉬면 시각만 건너뛰고 CPU 를 안 쓴다
+ * — 그래서 구간 차이가 "그동안 펌웨어가 일한 양" 이다. 시뮬레이션 시각과 달리 호스트마다, 실행마다
+ * 조금씩 다르다.
+ */
+uint64_t simHostCpuUs(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+/*
+ * native_sim 용 빈 자리 — bsp.h 가 이 헤더를 include 한다.
+ * nrf_gpio_* 를 실제로 부르는 건 driver/led.c 뿐이고 그건 DTS 에 led 노드가 있을 때만 켜진다
+ * (hw_def.h). sim overlay 에는 led 노드가 없으므로 선언이 필요 없다.
+ */
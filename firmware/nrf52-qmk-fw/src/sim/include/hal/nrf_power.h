@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * native_sim 용 nrf_power 대역 — 부팅 프로파일(boot_prof.c)과 UF2 진입(bootloader.c)이 쓰는 것만.
+ * 리셋 원인은 "없음"(=전원 인가 부팅)이고 GPREGRET 은 버린다. sim 에는 System OFF 웨이크도,
+ * 부트로더도 없다. VBUS 는 여기서 흉내 내지 않는다 — usb.c 를 통째로 usb_sim.c 로 바꾼다.
+ */
+#define NRF_POWER                       ((void *)0)
+#define NRF_POWER_RESETREAS_OFF_MASK    (1UL << 16)
+
+static inline uint32_t nrf_power_resetreas_get(void *p_reg)
+{
+  (void)p_reg;
+  return 0;
+}
+
+static inline void nrf_power_resetreas_clear(void *p_reg, uint32_t mask)
+{
+  (void)p_reg;
+  (void)mask;
+}
+
+static inline void nrf_power_gpregret_set(void *p_reg, uint8_t reg_num, uint32_t val)
+{
+  (void)p_reg;
+  (void)reg_num;
+  (void)val;
+}
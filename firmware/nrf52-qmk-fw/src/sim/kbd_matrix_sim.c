@@ -0,0 +1,264 @@
+/*
+ * native_sim 용 키 매트릭스 — 스크립트 파일을 시각표대로 재생한다.
+ *
+ * gpio-kbd-matrix 와 **같은 input 이벤트**를 낸다(INPUT_ABS_X = 구동, INPUT_ABS_Y = 입력,
+ * INPUT_BTN_TOUCH = 눌림/뗌, 마지막에 sync). 그래서 port/matrix.c 의 콜백, 활동 세마포어, idle 판정이
+ * 실보드와 같은 길을 탄다. 디바운스도 실보드처럼 QMK 가 한다(여기서 거르지 않는다).
+ *
+ * 스크립트 한 줄 = 이벤트 하나, 시각은 부팅 기준 ms(오름차순):
+ *
+ *   # 주석
+ *   500  1 2 d      <ms> <row> <col> d|u   QMK 좌표로 누름/뗌
+ *   700  leds 2     <ms> leds <n>          호스트 LED 리포트(비트 1 = CapsLock)
+ *   900  exit       <ms> exit              프로세스 종료(exit code 0)
+ *
+ * 경로는 --matrix-script=<file>. 없으면 아무 키도 누르지 않는다(--stop_at 으로 끝낸다).
+ * 파일은 부팅 때 한 번에 읽는다 — 재생 중 호스트 I/O 가 끼면 시각이 흔들린다.
+ */
+
+#define DT_DRV_COMPAT baram_sim_kbd_matrix
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/input/input.h>
+#include <zephyr/sys/printk.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
+#include "sim.h"
+#include "cmdline.h"
+#include "posix_native_task.h"
+#include "posix_board_if.h"
+#include "nsi_host_trampolines.h"
+
+#define SIM_SCRIPT_BUF_MAX    (64*1024)
+#define SIM_SCRIPT_EVT_MAX    4096
+
+enum
+{
+  SIM_EVT_KEY,
+  SIM_EVT_LEDS,
+  SIM_EVT_EXIT,
+};
+
+typedef struct
+{
+  uint32_t ms;
+  uint8_t  type;
+  uint8_t  row;
+  uint8_t  col;
+  uint8_t  value;   // KEY: 1 = 누름, LEDS: 비트맵
+} sim_evt_t;
+
+static const struct device *kbd_dev     = DEVICE_DT_INST_GET(0);
+static char                *script_path = NULL;
+static char                 script_buf[SIM_SCRIPT_BUF_MAX];
+static sim_evt_t            evt_tbl[SIM_SCRIPT_EVT_MAX];
+static uint32_t             evt_cnt = 0;
+
+
+static char *sim_next_token(char **p_line)
+{
+  char *p = *p_line;
+
+  while (*p == ' ' || *p == '\t' || *p == '\r')
+  {
+    p++;
+  }
+  if (*p == 0)
+  {
+    *p_line = p;
+    return NULL;
+  }
+
+  char *tok = p;
+
+  while (*p != 0 && *p != ' ' && *p != '\t' && *p != '\r')
+  {
+    p++;
+  }
+  if (*p != 0)
+  {
+    *p++ = 0;
+  }
+  *p_line = p;
+  return tok;
+}
+
+static bool sim_parse_line(char *line, sim_evt_t *p_evt)
+{
+  char *tok[4];
+  int   cnt = 0;
+
+  while (cnt < 4 && (tok[cnt] = sim_next_token(&line)) != NULL)
+  {
+    cnt++;
+  }
+  if (cnt < 2)
+  {
+    return false;
+  }
+
+  p_evt->ms = strtoul(tok[0], NULL, 0);
+
+  if (cnt == 2 && strcmp(tok[1], "exit") == 0)
+  {
+    p_evt->type = SIM_EVT_EXIT;
+    return true;
+  }
+  if (cnt == 3 && strcmp(tok[1], "leds") == 0)
+  {
+    p_evt->type  = SIM_EVT_LEDS;
+    p_evt->value = (uint8_t)strtoul(tok[2], NULL, 0);
+    return true;
+  }
+  if (cnt == 4 && (tok[3][0] == 'd' || tok[3][0] == 'u'))
+  {
+    p_evt->type  = SIM_EVT_KEY;
+    p_evt->row   = (uint8_t)strtoul(tok[1], NULL, 0);
+    p_evt->col   = (uint8_t)strtoul(tok[2], NULL, 0);
+    p_evt->value = (tok[3][0] == 'd');
+    return true;
+  }
+  return false;
+}
+
+static void sim_script_load(void)
+{
+  int  fd;
+  long len;
+
+  if (script_path == NULL)
+  {
+    return;
+  }
+
+  fd = nsi_host_open(script_path, 0);   // O_RDONLY
+  if (fd < 0)
+  {
+    printk("[E_] matrix script: can't open %s\n", script_path);
+    posix_exit(1);
+  }
+  len = nsi_host_read(fd, script_buf, sizeof(script_buf) - 1);
+  nsi_host_close(fd);
+  if (len < 0)
+  {
+    len = 0;
+  }
+  script_buf[len] = 0;
+
+  uint32_t line_no = 0;
+  char    *line    = script_buf;
+
+  while (line != NULL && *line != 0)
+  {
+    char *next = strchr(line, '\n');
+
+    if (next != NULL)
+    {
+      *next++ = 0;
+    }
+    line_no++;
+
+    char *comment = strchr(line, '#');
+
+    if (comment != NULL)
+    {
+      *comment = 0;
+    }
+
+    sim_evt_t evt;
+    char     *p = line;
+
+    while (*p == ' ' || *p == '\t' || *p == '\r')
+    {
+      p++;
+    }
+    if (*p != 0)
+    {
+      // 틀린 줄을 건너뛰면 스크립트가 조용히 다른 걸 잰다 — 바로 멈춘다.
+      if (!sim_parse_line(line, &evt) || evt_cnt >= SIM_SCRIPT_EVT_MAX ||
+          (evt_cnt > 0 && evt.ms < evt_tbl[evt_cnt - 1].ms))
+      {
+        printk("[E_] matrix script: %s:%u bad line\n", script_path, line_no);
+        posix_exit(1);
+      }
+      evt_tbl[evt_cnt++] = evt;
+    }
+    line = next;
+  }
+}
+
+static void sim_kbd_report(const sim_evt_t *p_evt)
+{
+  const bool drive_is_col = DT_INST_PROP(0, drive_is_col);
+  uint8_t    drive        = drive_is_col ? p_evt->col : p_evt->row;
+  uint8_t    sense        = drive_is_col ? p_evt->row : p_evt->col;
+
+  input_report_abs(kbd_dev, INPUT_ABS_X, drive, false, K_FOREVER);
+  input_report_abs(kbd_dev, INPUT_ABS_Y, sense, false, K_FOREVER);
+  input_report_key(kbd_dev, INPUT_BTN_TOUCH, p_evt->value, true, K_FOREVER);
+}
+
+static void sim_kbd_thread(void *p1, void *p2, void *p3)
+{
+  sim_script_load();
+
+  for (uint32_t i = 0; i < evt_cnt; i++)
+  {
+    const sim_evt_t *p_evt = &evt_tbl[i];
+    int64_t          now   = k_uptime_get();
+
+    if (p_evt->ms > now)
+    {
+      k_sleep(K_MSEC(p_evt->ms - now));
+    }
+
+    switch (p_evt->type)
+    {
+      case SIM_EVT_KEY:
+        sim_kbd_report(p_evt);
+        simBenchEdge(p_evt->row, p_evt->col, p_evt->value);
+        break;
+
+      case SIM_EVT_LEDS:
+        simHostSetLeds(p_evt->value);
+        break;
+
+      case SIM_EVT_EXIT:
+        printk("SIM %u exit\n", micros());
+        simBenchExit();
+        posix_exit(0);
+        break;
+    }
+  }
+}
+
+K_THREAD_DEFINE(sim_kbd_tid,
+                _HW_DEF_RTOS_THREAD_MEM_SIM_KBD,
+                sim_kbd_thread, NULL, NULL, NULL,
+                _HW_DEF_RTOS_THREAD_PRI_SIM_KBD, 0, 0);
+
+DEVICE_DT_INST_DEFINE(0, NULL, NULL, NULL, NULL, POST_KERNEL, CONFIG_INPUT_INIT_PRIORITY, NULL);
+
+
+static void sim_kbd_add_options(void)
+{
+  static struct args_struct_t sim_kbd_args[] = {
+    {
+      .option   = "matrix-script",
+      .name     = "file",
+      .type     = 's',
+      .dest     = (void *)&script_path,
+      .descript = "Key matrix script: '<ms> <row> <col> d|u', '<ms> leds <n>', '<ms> exit'",
+    },
+    ARG_TABLE_ENDMARKER
+  };
+
+  native_add_command_line_opts(sim_kbd_args);
+}
+
+NATIVE_TASK(sim_kbd_add_options, PRE_BOOT_1, 10);
+
+#endif   // DT_HAS_COMPAT_STATUS_OKAY(baram_sim_kbd_matrix)
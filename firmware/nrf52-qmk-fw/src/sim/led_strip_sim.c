@@ -0,0 +1,82 @@
+/*
+ * native_sim 용 네오픽셀 — led_strip API 를 받아 마지막 프레임만 들고 있는다.
+ *
+ * ws2812.c 는 실보드와 같은 경로(프레임 차분, 전송 스레드, 레일 워크)를 그대로 탄다 — 여기는 SPI
+ * 대신 받는 자리일 뿐이다. `--led-trace` 면 받은 프레임을 한 줄씩 남긴다:
+ *
+ *   LED <t_us> <n> <rrggbb> ...
+ *
+ * hid_sink.c 의 HID 줄과 같은 규칙(printk, 시뮬레이션 시각)이라 한 파일에서 시간순으로 섞어 본다.
+ */
+
+#define DT_DRV_COMPAT baram_sim_led_strip
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/led_strip.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+#if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
+#include "sim.h"
+#include "cmdline.h"
+#include "posix_native_task.h"
+
+#define SIM_STRIP_LEN   DT_INST_PROP(0, chain_length)
+
+static struct led_rgb frame[SIM_STRIP_LEN];
+static bool           led_trace = false;
+
+
+static int sim_strip_update_rgb(const struct device *dev, struct led_rgb *pixels, size_t num_pixels)
+{
+  ARG_UNUSED(dev);
+
+  num_pixels = MIN(num_pixels, SIM_STRIP_LEN);
+  memcpy(frame, pixels, num_pixels * sizeof(struct led_rgb));
+
+  if (led_trace)
+  {
+    printk("LED %u %u", micros(), (uint32_t)num_pixels);
+    for (size_t i = 0; i < num_pixels; i++)
+    {
+      printk(" %02x%02x%02x", frame[i].r, frame[i].g, frame[i].b);
+    }
+    printk("\n");
+  }
+  return 0;
+}
+
+static size_t sim_strip_length(const struct device *dev)
+{
+  ARG_UNUSED(dev);
+  return SIM_STRIP_LEN;
+}
+
+static DEVICE_API(led_strip, sim_strip_api) = {
+  .update_rgb = sim_strip_update_rgb,
+  .length     = sim_strip_length,
+};
+
+DEVICE_DT_INST_DEFINE(0, NULL, NULL, NULL, NULL, POST_KERNEL, CONFIG_LED_STRIP_INIT_PRIORITY, &sim_strip_api);
+
+
+static void sim_strip_add_options(void)
+{
+  static struct args_struct_t sim_strip_args[] = {
+    {
+      .is_switch = true,
+      .option    = "led-trace",
+      .type      = 'b',
+      .dest      = (void *)&led_trace,
+      .descript  = "Print every frame sent to the LED strip",
+    },
+    ARG_TABLE_ENDMARKER
+  };
+
+  native_add_command_line_opts(sim_strip_args);
+}
+
+NATIVE_TASK(sim_strip_add_options, PRE_BOOT_1, 10);
+
+#endif   // DT_HAS_COMPAT_STATUS_OKAY(baram_sim_led_strip)
@@ -0,0 +1,44 @@
+#include "sim.h"
+#include "cmdline.h"
+#include "posix_native_task.h"
+
+/*
+ * 실행 인자 — native_sim 의 명령행 파서(cmdline.h)에 붙인다. `zephyr.exe --help` 에 같이 나온다.
+ * 기본값은 "USB 로 PC 에 꽂힌 키보드" 다 — 회귀 테스트가 가장 많이 보는 경우라서.
+ */
+bool     sim_usb_off    = false;
+bool     sim_ble_on     = false;
+uint32_t sim_battery_mv = 4000;
+
+
+static void sim_add_options(void)
+{
+  static struct args_struct_t sim_args[] = {
+    {
+      .is_switch = true,
+      .option    = "usb-off",
+      .type      = 'b',
+      .dest      = (void *)&sim_usb_off,
+      .descript  = "No VBUS / no USB host (battery only)",
+    },
+    {
+      .is_switch = true,
+      .option    = "ble",
+      .type      = 'b',
+      .dest      = (void *)&sim_ble_on,
+      .descript  = "Start with a host connected on BLE profile 0",
+    },
+    {
+      .option    = "battery-mv",
+      .name      = "mv",
+      .type      = 'u',
+      .dest      = (void *)&sim_battery_mv,
+      .descript  = "Battery voltage in mV (default 4000)",
+    },
+    ARG_TABLE_ENDMARKER
+  };
+
+  native_add_command_line_opts(sim_args);
+}
+
+NATIVE_TASK(sim_add_options, PRE_BOOT_1, 10);
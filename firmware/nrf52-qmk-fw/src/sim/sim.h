@@ -0,0 +1,64 @@
+#ifndef SIM_H_
+#define SIM_H_
+
+#include "hw_def.h"
+
+/*
+ * native_sim — 펌웨어 전체를 리눅스 프로세스로 돌린다(docs/PORTING-NOTES.md §7.2).
+ *
+ * apMain() / qmkUpdate() / activityUpdate() 는 **실보드와 같은 코드**다. 바뀌는 건 그 아래뿐이다:
+ *   - 키 매트릭스 : baram,sim-kbd-matrix — 스크립트가 gpio-kbd-matrix 와 같은 input 이벤트를 낸다
+ *   - EEPROM      : native_sim 의 zephyr,sim-eeprom — 호스트 파일(--eeprom, 기본 eeprom.bin)
+ *   - 네오픽셀    : baram,sim-led-strip — 프레임을 받아 두기만 한다(--led-trace 면 출력)
+ *   - USB / BLE   : usb.c, usb_hid.c, port/ble.c 대신 usb_sim.c / ble_sim.c — 같은 API 로
+ *                   리포트를 받아 hid_sink.c 가 시각과 함께 stdout 에 한 줄씩 남긴다
+ *   - 배터리      : battery.c 대신 battery_sim.c — 고정 전압(--battery-mv)
+ * 어느 파일을 빼고 넣는지는 최상위 CMakeLists.txt 의 SIM_BUILD 가 정한다.
+ *
+ * 시각은 전부 **시뮬레이션 시각**(k_uptime 기준 µs)이다 — 호스트 부하와 무관하게 재현된다.
+ */
+
+#define _HW_DEF_RTOS_THREAD_PRI_SIM_KBD       0      // gpio-kbd-matrix 스캔 스레드와 같은 자리
+#define _HW_DEF_RTOS_THREAD_MEM_SIM_KBD       (2*1024)
+#define _HW_DEF_RTOS_THREAD_PRI_SIM_VIA       0      // usbd_next / BT RX 스레드 자리 — VIA 수신 콜백을 부른다(--via-stress, --via-bench)
+#define _HW_DEF_RTOS_THREAD_MEM_SIM_VIA       (2*1024)
+#define _HW_DEF_RTOS_THREAD_PRI_SIM_BENCH     0      // --combo-bench / --layer-bench / --tap-vectors 를 돌리고 종료한다
+#define _HW_DEF_RTOS_THREAD_MEM_SIM_BENCH     (2*1024)
+
+
+// 실행 인자(sim.c)
+extern bool     sim_usb_off;      // --usb-off    : VBUS 없음(배터리 단독)
+extern bool     sim_ble_on;       // --ble        : 프로파일 0 호스트가 연결된 채 시작
+extern uint32_t sim_battery_mv;   // --battery-mv : 배터리 전압
+
+// HID 싱크(hid_sink.c). transport = "usb" | "ble", kind = "kbd" | "exk" | "mouse" | "via"
+void simHidRecord(const char *transport, const char *kind, const uint8_t *data, uint16_t len);
+
+// 호스트가 보낸 LED 리포트(CapsLock 등). 스크립트의 `leds` 줄이 부른다(usb_sim.c).
+void    simHostSetLeds(uint8_t leds);
+uint8_t simHostGetLeds(void);
+
+// 호스트가 보낸 VIA 리포트 — 실보드의 수신 콜백 자리(usb_sim.c / ble_sim.c). false = 풀이 찼다/연결 없음.
+bool simUsbViaReceive(uint8_t *data, uint8_t length);
+bool simBleViaReceive(uint8_t *data, uint8_t length);
+
+// VIA 수신 스트레스(via_stress.c, --via-stress). 응답은 hid_sink.c 가 알린다.
+void simViaStressResponse(const char *transport, const uint8_t *data, uint16_t len);
+// VIA 처리량 벤치(via_bench.c, --via-bench). 응답은 hid_sink.c 가 알린다.
+void simViaBenchResponse(const char *transport, const uint8_t *data, uint16_t len);
+// via_hid.c 의 소비자 단계 사이(VIA_RX_RACE_POINT) — 스트레스 중이면 시각을 흘려 USB ISR 이 끼어들게 한다.
+void simViaRacePoint(void);
+
+// 탭/홀드 벡터·벤치(tap_vectors.c, --tap-vectors / --tap-bench). true = 리포트를 가져갔다(HID 줄 없음).
+bool simTapReport(const char *transport, const char *kind, const uint8_t *data, uint16_t len);
+
+// 키 입력 지연 벤치(bench.c, --bench). 엣지는 kbd_matrix_sim.c, 리포트는 hid_sink.c 가 알린다.
+void simBenchEdge(uint8_t row, uint8_t col, bool pressed);
+void simBenchReport(void);
+// 스크립트의 exit 줄에서 요약을 찍는다(스크립트 스레드, posix_exit 직전).
+void simBenchExit(void);
+
+// 호스트 프로세스 CPU 시간(µs) — host/cpu_time_bottom.c, 호스트 libc 쪽에서 컴파일된다.
+uint64_t simHostCpuUs(void);
+
+#endif
@@ -0,0 +1,670 @@
+#include "sim.h"
+#include "qmk/qmk.h"
+#include "qmk/port/tapping/tapping_port.h"
+#include "dynamic_keymap.h"
+#include "via.h"
+#include "cmdline.h"
+#include "posix_native_task.h"
+#include "posix_board_if.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+#ifdef HOLD_OKP_RUNTIME
+#include "qmk/port/via/hold_okp.h"
+#endif
+
+/*
+ * 탭/홀드 리졸버 검증(port/tapping/tapping_port.h) — 부팅 뒤 이 스레드가 돌리고 끝낸다.
+ *
+ *   --tap-vectors : QMK 탭핑 테스트 벡터(tests/tap_hold_configurations, tests/basic/test_tapping 의
+ *                   기본 설정 경우)를 리졸버와 순정 엔진 **둘 다**로 돌려 기대 리포트와 맞춘다.
+ *                   이어서 무작위 입력(누름/뗌/간격/hold-on-other-key)을 두 엔진에 같이 넣어 리포트가
+ *                   하나라도 다르면 실패(차분). 실패가 있으면 exit 1.
+ *   --tap-bench   : 롤오버/홈로우 모드 입력을 ms 틱과 함께 두 엔진에 재생하고 이벤트당 CPU 시간을 잰다.
+ *   --tap-vendor  : 부팅부터 순정 엔진으로 — bench.sh 가 같은 트레이스를 두 엔진으로 돌려 HID 줄을 비교한다.
+ *
+ * 키는 행 0 의 0~9 열을 시험용 키코드로 잠시 바꿔 쓴다(끝나면 되돌린다 — EEPROM 은 --eeprom 임시 파일로):
+ *   레이어 0 : LSFT_T(A)  LT(1,B)  C  D  LCTL_T(E)  F  G  H  I  J
+ *   레이어 1 : -          -        1  2  -          -  -  -  -  -      (- = KC_TRNS)
+ * 콤보는 끄고 돌린다 — 후보 키가 콤보 버퍼에 잡히면 탭핑 전에 순서가 바뀐다.
+ *
+ * 시각은 레코드에 직접 넣는 가상 ms 다(MAKE_KEYEVENT 의 timer_read() 대신) — 벡터의 간격이 그대로
+ * 판정 시각이 되고, 틱은 1ms 마다 하나(keyboard_task 의 generate_tick_event 와 같은 빈도)다.
+ * 리포트는 hid_sink.c 가 simTapReport() 로 넘기고, 여기서 "수식+키" 문자열로 줄여 모은다:
+ *   C/S/A/G = 왼쪽 Ctrl/Shift/Alt/Gui, R 뒤는 오른쪽, a~z 0~9 = 키, - = 빈 리포트. 예) "a Sc S -"
+ *
+ *   BENCH {"tap_vectors":{"vectors":12,"fail":0,"fuzz":400,"fuzz_diff":0,"skipped":0}}
+ *   BENCH {"tap":{"trace":"rollover","events":..,"ticks":..,"resolver_ns":..,"vendor_ns":..,"match":true}}
+ */
+#define TAP_VEC_START_MS    1000
+#define TAP_VEC_ROW         0
+#define TAP_VEC_KEYS        10
+#define TAP_VEC_LOG_MAX     1024
+#define TAP_VEC_STEPS_MAX   512
+#define TAP_VEC_SETTLE_MS   (TAPPING_TERM * 3)   // 벡터 사이 — 뗌 상태가 끝나고 상태머신이 비도록
+#define TAP_FUZZ_RUNS       400
+#define TAP_FUZZ_EVENTS     24
+#define TAP_BENCH_EVENTS    20000
+#define TAP_BENCH_REPEAT    10
+
+typedef struct
+{
+  const char *name;
+  const char *steps;    // dN/uN = (0,N) 누름/뗌, wN = N ms(틱 N 개), sN = N ms(틱 없이), oN = hold-on-other-key 0/1
+  const char *expect;
+} tap_vector_t;
+
+typedef struct
+{
+  uint32_t ms;          // 재생 시작 기준
+  uint8_t  col;
+  bool     pressed;
+} tap_bench_evt_t;
+
+static bool tap_vectors_on = false;
+static bool tap_bench_on   = false;
+static bool tap_vendor_on  = false;
+
+static const uint16_t tv_keymap[2][TAP_VEC_KEYS] = {
+  {LSFT_T(KC_A), LT(1, KC_B), KC_C, KC_D, LCTL_T(KC_E), KC_F, KC_G, KC_H, KC_I, KC_J},
+  {KC_TRNS, KC_TRNS, KC_1, KC_2, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS},
+};
+
+/*
+ * 기대값은 순정 엔진(= QMK)의 동작이다. hold-on-other-key 는 보드 기본이 ON(port/via/hold_okp.c)이라
+ * QMK 기본(OFF)을 보는 벡터는 o0 으로 시작한다.
+ */
+static const tap_vector_t tv_table[] = {
+  // 탭: TAPPING_TERM 안에 떼면 탭 키
+  {"mt_tap",              "d0 w50 u0",                          "a -"},
+  {"lt_tap",              "d1 w50 u1",                          "b -"},
+  // 홀드: TAPPING_TERM 을 넘기면 틱이 홀드로 확정한다
+  {"mt_hold",             "d0 w250 u0",                         "S -"},
+  {"mt_hold_then_key",    "d0 w250 d2 w20 u2 w20 u0",           "S Sc S -"},
+  {"lt_hold_then_key",    "d1 w250 d2 w20 u2 w20 u1",           "1 -"},
+  // TAPPING_TERM 안에서 다른 키를 눌렀다 떼고 탭 키를 떼면 — 기본은 탭(중첩 탭)
+  {"mt_nested_tap",       "o0 d0 w20 d2 w20 u2 w20 u0",         "a ac a -"},
+  {"mt_nested_mt",        "o0 d0 w20 d4 w20 u4 w20 u0",         "a ae a -"},
+  // 같은 입력, 다른 키가 눌린 채 탭 키를 먼저 떼면(롤) 탭 뒤에 그 키
+  {"lt_roll",             "o0 d1 w20 d2 w20 u1 w20 u2",         "b bc c -"},
+  // 다른 키를 친 뒤 TAPPING_TERM 이 지나면 홀드, 큐에 있던 키는 그 뒤에
+  {"mt_typed_timeout",    "o0 d0 w20 d2 w20 u2 w250 u0",        "S Sc S -"},
+  // hold-on-other-key: 다른 키를 누르는 순간 홀드
+  {"mt_other_key_okp",    "o1 d0 w20 d2 w20 u2 w20 u0",         "S Sc S -"},
+  {"lt_roll_okp",         "o1 d1 w20 d2 w20 u1 w20 u2",         "1 -"},
+  // 연타: 탭 뒤 QUICK_TAP_TERM 안에 다시 누르면 탭 키를 누른 채로
+  {"mt_double_tap_hold",  "d0 w30 u0 w30 d0 w300 u0",           "a - a -"},
+  // 탭 뒤 다른 키가 끼면 연타가 아니다 — 다시 누른 건 새 판정(여기선 홀드)
+  {"mt_tap_interrupted",  "o0 d0 w20 u0 w20 d2 w10 u2 w10 d0 w250 u0", "a - c - S -"},
+};
+
+static bool     tv_capture = false;
+static char     tv_log[TAP_VEC_LOG_MAX];
+static uint32_t tv_log_len;
+static uint32_t tv_log_hash;
+static uint32_t tv_log_cnt;
+static char     tv_last[24];
+static uint16_t tv_now;                   // 가상 ms
+static uint32_t tv_ticks;
+static uint16_t tv_saved[2][TAP_VEC_KEYS];
+static bool     tv_combo_was_on;
+static bool     tv_okp_saved;
+static uint32_t tv_seed = 1;
+
+
+// hid_sink.c 가 리포트마다 부른다. 잡는 중이면 줄여서 모으고 true(HID 줄로는 안 찍는다).
+bool simTapReport(const char *transport, const char *kind, const uint8_t *data, uint16_t len)
+{
+  static const char mod_chr[4] = {'C', 'S', 'A', 'G'};
+  char     token[sizeof(tv_last)];
+  uint32_t n = 0;
+  uint8_t  keys[6];
+  uint8_t  key_cnt = 0;
+
+  if (!tv_capture || strcmp(kind, "kbd") != 0 || len < 8)
+  {
+    return false;
+  }
+  ARG_UNUSED(transport);
+
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    if (data[0] & (1 << i))
+    {
+      if (i >= 4)
+      {
+        token[n++] = 'R';
+      }
+      token[n++] = mod_chr[i % 4];
+    }
+  }
+  // 6KRO 부트 리포트 [mods, 0, k0..k5] — 키 순서는 슬롯 배치라 정렬해서 비교한다.
+  for (uint8_t i = 2; i < 8; i++)
+  {
+    if (data[i] != 0)
+    {
+      uint8_t j = key_cnt++;
+
+      while (j > 0 && keys[j - 1] > data[i])
+      {
+        keys[j] = keys[j - 1];
+        j--;
+      }
+      keys[j] = data[i];
+    }
+  }
+  for (uint8_t i = 0; i < key_cnt; i++)
+  {
+    if (keys[i] >= KC_A && keys[i] <= KC_Z)
+    {
+      token[n++] = 'a' + (keys[i] - KC_A);
+    }
+    else if (keys[i] >= KC_1 && keys[i] <= KC_0)
+    {
+      token[n++] = (keys[i] == KC_0) ? '0' : '1' + (keys[i] - KC_1);
+    }
+    else
+    {
+      token[n++] = '?';
+    }
+  }
+  if (n == 0)
+  {
+    token[n++] = '-';
+  }
+  token[n] = 0;
+
+  // 같은 리포트가 연달아 나가면(전송 경로가 다시 보낸 것) 하나로 본다.
+  if (strcmp(token, tv_last) == 0)
+  {
+    return true;
+  }
+  strcpy(tv_last, token);
+
+  for (uint32_t i = 0; i <= n; i++)
+  {
+    tv_log_hash = (tv_log_hash ^ (uint8_t)(i < n ? token[i] : ' ')) * 16777619u;
+  }
+  tv_log_cnt++;
+  if (tv_log_len + n + 2 < sizeof(tv_log))
+  {
+    if (tv_log_len > 0)
+    {
+      tv_log[tv_log_len++] = ' ';
+    }
+    memcpy(&tv_log[tv_log_len], token, n + 1);
+    tv_log_len += n;
+  }
+  return true;
+}
+
+static void tv_log_clear(void)
+{
+  tv_log[0]   = 0;
+  tv_log_len  = 0;
+  tv_log_hash = 2166136261u;
+  tv_log_cnt  = 0;
+  tv_last[0]  = 0;
+}
+
+static void tv_key(uint8_t col, bool pressed)
+{
+  action_exec((keyevent_t){
+    .key     = MAKE_KEYPOS(TAP_VEC_ROW, col),
+    .pressed = pressed,
+    .time    = tv_now,
+    .type    = KEY_EVENT,
+  });
+}
+
+static void tv_tick(void)
+{
+  tv_now++;
+  tv_ticks++;
+  action_exec((keyevent_t){.time = tv_now, .type = TICK_EVENT});
+}
+
+static void tv_wait(uint32_t ms)
+{
+  for (uint32_t i = 0; i < ms; i++)
+  {
+    tv_tick();
+  }
+}
+
+static bool tv_okp_get(void)
+{
+#ifdef HOLD_OKP_RUNTIME
+  uint8_t data[5] = {id_custom_get_value, 0, 1 /* id_qmk_hold_okp_enable */, 0, 0};
+
+  via_qmk_hold_okp_command(data, sizeof(data));
+  return data[3] != 0;
+#else
+  return false;
+#endif
+}
+
+// false = 이 빌드에선 못 바꾼다(HOLD_OKP_RUNTIME 없음) — 그 벡터는 건너뛴다.
+static bool tv_okp_set(bool enable)
+{
+#ifdef HOLD_OKP_RUNTIME
+  uint8_t data[5] = {id_custom_set_value, 0, 1 /* id_qmk_hold_okp_enable */, enable ? 1 : 0, 0};
+
+  via_qmk_hold_okp_command(data, sizeof(data));
+  return true;
+#else
+  return false;
+#endif
+}
+
+// 상태를 비우고 엔진을 고른다(그 사이 리포트는 잡아서 버린다). 판정이 남아 있어 엔진을 못 바꾸면 false.
+static bool tv_begin(bool resolver)
+{
+  tv_capture = true;
+  tv_wait(TAP_VEC_SETTLE_MS);
+  clear_keyboard();
+  layer_clear();
+  tv_log_clear();
+  return tapping_port_set_enable(resolver);
+}
+
+static void tv_end(void)
+{
+  tv_wait(TAP_VEC_SETTLE_MS);
+  tv_capture = false;
+}
+
+// steps 를 재생한다. false = 이 빌드에서 못 돌리는 단계가 있다.
+static bool tv_play(const char *steps)
+{
+  const char *p = steps;
+
+  while (*p != 0)
+  {
+    char     op = *p++;
+    uint32_t n  = 0;
+
+    while (*p >= '0' && *p <= '9')
+    {
+      n = n * 10 + (*p++ - '0');
+    }
+    switch (op)
+    {
+      case 'd': tv_key(n, true);  break;
+      case 'u': tv_key(n, false); break;
+      case 'w': tv_wait(n);       break;
+      case 's': tv_now += n;      break;
+      case 'o':
+        if (!tv_okp_set(n != 0))
+        {
+          return false;
+        }
+        break;
+    }
+    while (*p == ' ')
+    {
+      p++;
+    }
+  }
+  return true;
+}
+
+static void tv_keymap_swap(bool install)
+{
+  for (uint8_t layer = 0; layer < 2; layer++)
+  {
+    for (uint8_t col = 0; col < TAP_VEC_KEYS; col++)
+    {
+      if (install)
+      {
+        tv_saved[layer][col] = dynamic_keymap_get_keycode(layer, TAP_VEC_ROW, col);
+      }
+      dynamic_keymap_set_keycode(layer, TAP_VEC_ROW, col, install ? tv_keymap[layer][col] : tv_saved[layer][col]);
+    }
+  }
+  if (install)
+  {
+    tv_okp_saved = tv_okp_get();
+#ifdef COMBO_ENABLE
+    tv_combo_was_on = is_combo_enabled();
+    combo_disable();
+#endif
+  }
+  else
+  {
+    tv_okp_set(tv_okp_saved);
+#ifdef COMBO_ENABLE
+    if (tv_combo_was_on)
+    {
+      combo_enable();
+    }
+#endif
+  }
+}
+
+static uint32_t tv_rand(uint32_t n)
+{
+  tv_seed = tv_seed * 1103515245u + 12345u;
+  return (tv_seed >> 16) % n;
+}
+
+
+static uint32_t tap_vectors_run(void)
+{
+  static char steps[TAP_VEC_STEPS_MAX];
+  static char log_a[TAP_VEC_LOG_MAX];
+  uint32_t    fail    = 0;
+  uint32_t    skipped = 0;
+  uint32_t    diff    = 0;
+
+  for (uint32_t i = 0; i < ARRAY_SIZE(tv_table); i++)
+  {
+    for (uint8_t engine = 0; engine < 2; engine++)
+    {
+      bool resolver = (engine == 0);
+      bool ok       = tv_begin(resolver);
+
+      if (ok && !tv_play(tv_table[i].steps))
+      {
+        tv_end();
+        skipped++;
+        continue;
+      }
+      tv_end();
+      if (!ok || strcmp(tv_log, tv_table[i].expect) != 0)
+      {
+        printk("BENCH {\"tap_vector\":{\"name\":\"%s\",\"engine\":\"%s\",\"expect\":\"%s\",\"got\":\"%s\"}}\n",
+               tv_table[i].name, resolver ? "resolver" : "vendor", tv_table[i].expect, ok ? tv_log : "busy");
+        fail++;
+      }
+    }
+  }
+
+  // 차분 — 키 7개(탭 키 3개 + 일반 4개), 간격은 TAPPING_TERM 경계 근처를 자주 고른다. 간격의 1/4 은
+  // 틱 없이 건너뛴다 — 루프가 자다가 키 입력으로 깨면 판정 시각이 지난 뒤 틱보다 이벤트가 먼저 온다.
+  static const uint16_t gap_tbl[] = {0, 1, 5, 20, 60, 150, TAPPING_TERM - 1, TAPPING_TERM, TAPPING_TERM + 1, 300};
+
+  for (uint32_t run = 0; run < TAP_FUZZ_RUNS; run++)
+  {
+    bool     down[7] = {false};
+    uint32_t n       = 0;
+
+    n += snprintk(&steps[n], sizeof(steps) - n, "o%u", tv_rand(2));
+    for (uint32_t e = 0; e < TAP_FUZZ_EVENTS; e++)
+    {
+      uint8_t col = tv_rand(7);
+
+      n += snprintk(&steps[n], sizeof(steps) - n, " %c%u %c%u", down[col] ? 'u' : 'd', col,
+                    tv_rand(4) ? 'w' : 's', gap_tbl[tv_rand(ARRAY_SIZE(gap_tbl))]);
+      down[col] = !down[col];
+    }
+    for (uint8_t col = 0; col < 7; col++)
+    {
+      if (down[col])
+      {
+        n += snprintk(&steps[n], sizeof(steps) - n, " u%u w%u", col, tv_rand(30));
+      }
+    }
+
+    uint32_t hash_a;
+    uint32_t cnt_a;
+    bool     ok = tv_begin(true);
+
+    ok = ok && tv_play(steps);
+    tv_end();
+    strcpy(log_a, tv_log);
+    hash_a = tv_log_hash;
+    cnt_a  = tv_log_cnt;
+
+    ok = ok && tv_begin(false);
+    ok = ok && tv_play(steps);
+    tv_end();
+
+    if (!ok)
+    {
+      skipped++;
+    }
+    else if (hash_a != tv_log_hash || cnt_a != tv_log_cnt)
+    {
+      if (diff < 3)
+      {
+        printk("BENCH {\"tap_fuzz\":{\"steps\":\"%s\",\"resolver\":\"%s\",\"vendor\":\"%s\"}}\n", steps, log_a, tv_log);
+      }
+      diff++;
+    }
+  }
+
+  printk("BENCH {\"tap_vectors\":{\"vectors\":%u,\"fail\":%u,\"fuzz\":%u,\"fuzz_diff\":%u,\"skipped\":%u}}\n",
+         (uint32_t)ARRAY_SIZE(tv_table), fail, TAP_FUZZ_RUNS, diff, skipped);
+  return fail + diff;
+}
+
+
+/*
+ * 벤치 입력 두 가지 — 단어마다 키 몇 개를 겹쳐 누르고(앞 키를 떼기 전에 다음 키) 단어 사이를 띄운다.
+ *   rollover : 일반 키 롤 사이사이 탭 키(MT/LT)를 빠르게 탭한다. hold-on-other-key ON(보드 기본).
+ *   hold_mod : 홈로우 모드 — MT/LT 를 누른 채 단어를 친다. hold-on-other-key OFF 라 판정까지 이벤트가
+ *              큐에 쌓인다(순정은 그동안 틱마다 큐 앞을 다시 판정한다).
+ */
+static uint32_t tap_bench_make(tap_bench_evt_t *evt, uint32_t max, bool hold_mod)
+{
+  static const uint8_t tap_keys[3]   = {0, 1, 4};
+  static const uint8_t plain_keys[7] = {2, 3, 5, 6, 7, 8, 9};
+  uint32_t cnt = 0;
+  uint32_t t   = 10;
+
+  while (cnt + 16 < max)
+  {
+    uint8_t  words = hold_mod ? 2 + tv_rand(2) : 3 + tv_rand(4);
+    uint8_t  start = tv_rand(ARRAY_SIZE(plain_keys));
+    uint32_t end   = t;
+    int      mod   = hold_mod ? tap_keys[tv_rand(3)] : -1;
+    uint32_t first = cnt;
+
+    if (mod >= 0)
+    {
+      evt[cnt++] = (tap_bench_evt_t){.ms = t, .col = mod, .pressed = true};
+      t += 20 + tv_rand(40);
+    }
+    for (uint8_t i = 0; i < words; i++)
+    {
+      // 롤오버 단어에는 탭 키가 섞인다 — 누른 시간이 짧아 대개 탭이다.
+      uint8_t  col = (!hold_mod && i == 1 && tv_rand(2)) ? tap_keys[tv_rand(3)] : plain_keys[(start + i) % 7];
+      uint32_t dur = 30 + tv_rand(60);
+
+      evt[cnt++] = (tap_bench_evt_t){.ms = t, .col = col, .pressed = true};
+      evt[cnt++] = (tap_bench_evt_t){.ms = t + dur, .col = col, .pressed = false};
+      end = MAX(end, t + dur);
+      t += 15 + tv_rand(40);
+    }
+    if (mod >= 0)
+    {
+      end += 10 + tv_rand(30);
+      evt[cnt++] = (tap_bench_evt_t){.ms = end, .col = mod, .pressed = false};
+    }
+
+    // 시각 순으로(같은 시각이면 만든 순서대로)
+    for (uint32_t i = first + 1; i < cnt; i++)
+    {
+      tap_bench_evt_t e = evt[i];
+      uint32_t        j = i;
+
+      while (j > first && evt[j - 1].ms > e.ms)
+      {
+        evt[j] = evt[j - 1];
+        j--;
+      }
+      evt[j] = e;
+    }
+    t = end + 40 + tv_rand(300);
+  }
+  return cnt;
+}
+
+/*
+ * 틱은 메인 루프가 깨어 있는 구간에만 1ms 마다 넣는다 — 키가 눌려 있거나 마지막 이벤트 뒤 TAPPING_TERM
+ * 안. 그 밖에선 루프가 다음 입력(또는 데드라인)까지 자므로 다음 이벤트 직전에 틱 하나만 넣는다.
+ */
+static uint64_t tap_bench_replay(const tap_bench_evt_t *evt, uint32_t cnt)
+{
+  uint32_t now      = 0;
+  uint32_t awake_to = 0;
+  uint32_t down     = 0;
+  uint64_t start_us = simHostCpuUs();
+
+  tv_ticks = 0;
+  for (uint32_t i = 0; i < cnt;)
+  {
+    uint32_t ms = evt[i].ms;
+
+    while (now + 1 < ms && (down > 0 || now < awake_to))
+    {
+      now++;
+      tv_tick();
+    }
+    if (now + 1 < ms)
+    {
+      tv_now += ms - 1 - now;   // 자는 구간 — 틱 없이 건너뛴다
+      now = ms - 1;
+    }
+    if (now < ms)
+    {
+      now++;
+      tv_tick();
+    }
+    for (; i < cnt && evt[i].ms == ms; i++)
+    {
+      tv_key(evt[i].col, evt[i].pressed);
+      down += evt[i].pressed ? 1 : -1;
+    }
+    awake_to = ms + TAPPING_TERM;
+  }
+  return simHostCpuUs() - start_us;
+}
+
+static uint32_t tap_bench_run(void)
+{
+  static tap_bench_evt_t evt[TAP_BENCH_EVENTS];
+  static const char     *name_tbl[] = {"rollover", "hold_mod"};
+  uint32_t               err        = 0;
+
+  for (uint8_t k = 0; k < ARRAY_SIZE(name_tbl); k++)
+  {
+    bool     hold_mod = (k == 1);
+    uint32_t cnt      = tap_bench_make(evt, TAP_BENCH_EVENTS, hold_mod);
+    uint64_t us[2]    = {0, 0};
+    uint32_t hash[2];
+    uint32_t reports[2];
+    uint32_t ticks = 0;
+    bool     ok    = true;
+
+    for (uint8_t engine = 0; engine < 2; engine++)
+    {
+      ok = ok && tv_begin(engine == 0);
+      ok = ok && tv_okp_set(!hold_mod);
+      for (uint32_t r = 0; ok && r < TAP_BENCH_REPEAT; r++)
+      {
+        tv_wait(TAP_VEC_SETTLE_MS);
+        us[engine] += tap_bench_replay(evt, cnt);
+        ticks = tv_ticks;
+      }
+      tv_end();
+      hash[engine]    = tv_log_hash;
+      reports[engine] = tv_log_cnt;
+    }
+
+    bool match = ok && hash[0] == hash[1] && reports[0] == reports[1];
+
+    printk("BENCH {\"tap\":{\"trace\":\"%s\",\"events\":%u,\"ticks\":%u,\"reports\":%u,"
+           "\"resolver_ns\":%u,\"vendor_ns\":%u,\"match\":%s}}\n",
+           name_tbl[k], cnt, ticks, reports[0] / TAP_BENCH_REPEAT,
+           (uint32_t)(us[0] * 1000 / (cnt * TAP_BENCH_REPEAT)), (uint32_t)(us[1] * 1000 / (cnt * TAP_BENCH_REPEAT)),
+           match ? "true" : "false");
+    err += match ? 0 : 1;
+  }
+  return err;
+}
+
+
+/*
+ * 스케줄러를 잠그고 돌린다 — 메인 루프가 같은 탭핑/레이어 상태를 중간에 만지지 않게(bench.c 와 같다).
+ * 가상 시각은 지금 시각에서 시작한다.
+ */
+static void tap_vectors_thread(void *p1, void *p2, void *p3)
+{
+  uint32_t err = 0;
+
+  ARG_UNUSED(p1);
+  ARG_UNUSED(p2);
+  ARG_UNUSED(p3);
+
+  if (!tap_vectors_on && !tap_bench_on)
+  {
+    return;
+  }
+
+  k_sched_lock();
+  tv_now = timer_read();
+  tv_keymap_swap(true);
+  if (tap_vectors_on)
+  {
+    err += tap_vectors_run();
+  }
+  if (tap_bench_on)
+  {
+    err += tap_bench_run();
+  }
+  tv_keymap_swap(false);
+  tapping_port_set_enable(!tap_vendor_on);
+  k_sched_unlock();
+
+  posix_exit(err ? 1 : 0);
+}
+
+K_THREAD_DEFINE(tap_vectors_tid,
+                _HW_DEF_RTOS_THREAD_MEM_SIM_BENCH,
+                tap_vectors_thread, NULL, NULL, NULL,
+                _HW_DEF_RTOS_THREAD_PRI_SIM_BENCH, 0, TAP_VEC_START_MS);
+
+
+static void tap_vectors_add_options(void)
+{
+  static struct args_struct_t tap_vectors_args[] = {
+    {
+      .is_switch = true,
+      .option    = "tap-vectors",
+      .type      = 'b',
+      .dest      = (void *)&tap_vectors_on,
+      .descript  = "After boot, run the QMK tapping vectors and a random differential on both tap engines, then exit (1 on failure)",
+    },
+    {
+      .is_switch = true,
+      .option    = "tap-bench",
+      .type      = 'b',
+      .dest      = (void *)&tap_bench_on,
+      .descript  = "After boot, time the tap/hold engines per event on rollover and home-row-mod input, then exit",
+    },
+    {
+      .is_switch = true,
+      .option    = "tap-vendor",
+      .type      = 'b',
+      .dest      = (void *)&tap_vendor_on,
+      .descript  = "Use the upstream tap/hold engine instead of the resolver (A/B against traces)",
+    },
+    ARG_TABLE_ENDMARKER
+  };
+
+  native_add_command_line_opts(tap_vectors_args);
+}
+
+// 인자는 PRE_BOOT_1 과 PRE_BOOT_2 사이에 읽힌다 — 엔진은 부팅 전에 고른다(판정이 걸릴 틈이 없다).
+static void tap_vendor_apply(void)
+{
+  if (tap_vendor_on)
+  {
+    tapping_port_set_enable(false);
+  }
+}
+
+NATIVE_TASK(tap_vectors_add_options, PRE_BOOT_1, 10);
+NATIVE_TASK(tap_vendor_apply, PRE_BOOT_2, 10);
@@ -0,0 +1,129 @@
+#include "usb.h"
+#include "usb_hid/usb_hid.h"
+#include "sim.h"
+#include "log.h"
+#include "boot_prof.h"
+
+/*
+ * usb.c / usb_hid.c 의 대역 — 같은 API, 전송은 hid_sink 로.
+ *
+ * 실보드의 "열거 완료(kb_ready)" 는 VBUS 가 있으면 처음부터 참으로 둔다. 열거 지연(§3.1)이나
+ * 서스펜드는 흉내 내지 않는다 — 그건 usbd_next 의 동작이라 여기서 만들면 거짓 재현이 된다.
+ * 전송은 블록하지 않는다(실보드는 usb_tx_thread 가 호스트를 기다린다) — 리포트 시각은 루프가
+ * 넘긴 시각이고, 호스트 폴링 간격(1ms)은 들어가지 않는다.
+ */
+static void (*p_suspend_func)(bool suspended) = NULL;
+static void (*p_kbd_led_func)(void)           = NULL;
+static bool (*via_receive_cb)(uint8_t *data, uint8_t length) = NULL;
+static uint8_t host_leds = 0;
+
+
+bool usbInit(void)
+{
+  usbHidInit();
+  logPrintf("[OK] usbInit() sim, host %s\n", sim_usb_off ? "none" : "configured");
+  return true;
+}
+
+bool usbIsVbusPresent(void)
+{
+  return !sim_usb_off;
+}
+
+void usbSetSuspendFunc(void (*func)(bool suspended))
+{
+  p_suspend_func = func;
+}
+
+bool usbHidInit(void)
+{
+  return true;
+}
+
+bool usbHidSendReport(uint8_t *data, uint16_t length)
+{
+  if (!usbHidIsReady())
+  {
+    return false;
+  }
+  simHidRecord("usb", "kbd", data, length);
+  return true;
+}
+
+bool usbHidSendReportEXK(uint8_t *data, uint16_t length)
+{
+  if (!usbHidIsReady())
+  {
+    return false;
+  }
+  simHidRecord("usb", "exk", data, length);
+  return true;
+}
+
+bool usbHidSendReportMouse(uint8_t *data, uint16_t length)
+{
+  if (!usbHidIsReady())
+  {
+    return false;
+  }
+  simHidRecord("usb", "mouse", data, length);
+  return true;
+}
+
+bool usbHidSendReportVia(uint8_t *data, uint16_t length)
+{
+  if (!usbHidIsReady())
+  {
+    return false;
+  }
+  simHidRecord("usb", "via", data, length);
+  return true;
+}
+
+uint8_t usbHidGetKbdLeds(void)
+{
+  return host_leds;
+}
+
+bool usbHidIsReady(void)
+{
+  return !sim_usb_off;
+}
+
+void usbHidSetViaReceiveFunc(bool (*func)(uint8_t *data, uint8_t length))
+{
+  via_receive_cb = func;
+}
+
+void usbHidSetKbdLedFunc(void (*func)(void))
+{
+  p_kbd_led_func = func;
+}
+
+
+// 스크립트의 `leds` 줄 — 실보드의 kb_set_report() 와 같게 바뀐 때만 알린다.
+void simHostSetLeds(uint8_t leds)
+{
+  bool changed = (host_leds != leds);
+
+  host_leds = leds;
+  if (changed && p_kbd_led_func != NULL)
+  {
+    p_kbd_led_func();
+  }
+}
+
+// 실보드에선 usbd_next 가 VIA OUT 리포트마다 부르는 자리. --via-stress 의 타이머 ISR 이 부른다.
+bool simUsbViaReceive(uint8_t *data, uint8_t length)
+{
+  if (via_receive_cb == NULL || !usbHidIsReady())
+  {
+    return false;
+  }
+  return via_receive_cb(data, length);
+}
+
+uint8_t simHostGetLeds(void)
+{
+  return host_leds;
+}
@@ -0,0 +1,421 @@
+#include "sim.h"
+#include "qmk/qmk.h"
+#include "qmk/port/via/via_bulk.h"
+#include "via.h"
+#include "dynamic_keymap.h"
+#include "cmdline.h"
+#include "posix_native_task.h"
+#include "posix_board_if.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+/*
+ * VIA 처리량 벤치 — `--via-bench` 면 USB 대역 위에서 호스트 하나를 흉내 내 **키맵 전체**를 두 방식으로
+ * 읽고 쓴다:
+ *   percmd : 순정 VIA 처럼 id_dynamic_keymap_get_buffer / set_buffer(28B) 를 보내고 응답을 기다린다
+ *   bulk   : via_bulk(0xB0~) 의 READ / WRITE — 윈도우 VIA_BULK_WINDOW_MAX, 누적 ACK, 끝에 CRC32
+ *
+ * 호스트 쪽은 보드 DTS 의 VIA 엔드포인트(in/out-polling-period-us = 1000)대로 **1ms 프레임마다 OUT 하나,
+ * IN 하나**만 옮긴다. 디바이스 쪽은 실보드와 같은 코드다 — 수신 콜백(simUsbViaReceive) → 풀/링 →
+ * 메인 루프의 via_hid_task() → raw_hid_send. 응답은 hid_sink.c 가 simViaBenchResponse() 로 넘기고,
+ * 여기서 IN 엔드포인트 큐(usb_hid.c 의 usb_tx_q 와 같은 깊이 8)에 쌓았다가 프레임마다 하나씩 꺼낸다.
+ * 큐가 차서 버린 응답은 in_drop 으로 센다(실보드도 K_NO_WAIT 로 버린다).
+ *
+ * 프레임 규칙 두 가지가 왕복 비용을 만든다:
+ *   - 프레임 t 의 OUT 으로 생긴 응답은 t+1 의 IN 부터 나간다(디바이스가 처리한 뒤에야 큐에 있다)
+ *   - 프레임 t 의 IN 을 보고 보내는 OUT 은 t+1 부터다(호스트 앱이 읽은 뒤에 다음 요청을 낸다)
+ * 그래서 순정 명령 하나는 2 프레임이고, 벌크는 윈도우가 이 왕복을 가리는 만큼 빨라진다. 벌크 READ 는
+ * 청크마다 누적 ACK 를 보내 윈도우를 밀고(프로토콜상 아무 때나 보내도 된다), WRITE 는 디바이스가
+ * 윈도우마다 ACK 하므로 호스트는 확인 안 된 청크가 윈도우만큼 쌓이면 ACK 를 기다린다.
+ *
+ * 시각은 시뮬레이션 시각이다 — 메인 루프가 깨어 처리하는 지연은 들어가고 호스트 CPU 속도는 안 들어간다.
+ * 쓴 내용은 다른 방식으로 다시 읽어 맞춰 보고, 어긋나면 exit 1:
+ *   BENCH {"via":{"bytes":..,"read":{"percmd_us":..,"bulk_us":..,"percmd_reports":..,"bulk_reports":..},
+ *          "write":{...},"in_drop":0,"match":true}}
+ * 키맵 쓰기는 EEPROM 파일(--eeprom)에 남는다 — 빈 임시 파일로 돌릴 것.
+ */
+#define VIA_BENCH_START_MS    1000    // 부팅 정착 뒤에 시작한다(트레이스와 같은 자리)
+#define VIA_BENCH_FRAME_US    1000    // 보드 DTS 의 VIA in/out-polling-period-us
+#define VIA_BENCH_TIMEOUT_US  100000  // 응답 하나를 기다리는 한도
+#define VIA_BENCH_IN_DEPTH    8       // usb_hid.c usb_tx_q 깊이
+#define VIA_BENCH_MAX_BYTES   4096
+#define VIA_BENCH_CMD_DATA    28      // 순정 get/set_buffer 한 번에 옮기는 바이트(32 - [id off(2) size])
+#define VIA_BENCH_CHUNK       30      // via_bulk.c BULK_CHUNK_SIZE
+
+typedef struct
+{
+  uint32_t us;
+  uint32_t reports;     // OUT + IN
+} via_bench_run_t;
+
+static bool     via_bench_on = false;
+static uint32_t out_next_us;          // 다음 OUT 을 보낼 수 있는 프레임
+static uint32_t in_next_us;           // 다음 IN 을 꺼낼 수 있는 프레임
+static uint32_t report_cnt;
+static uint32_t in_drop;
+static uint8_t  buf_a[VIA_BENCH_MAX_BYTES];
+static uint8_t  buf_b[VIA_BENCH_MAX_BYTES];
+
+typedef struct
+{
+  uint32_t queued_us;   // 디바이스가 보낸 시각 — 그 다음 프레임부터 호스트가 꺼낼 수 있다
+  uint8_t  data[32];
+} via_bench_in_t;
+
+K_MSGQ_DEFINE(via_bench_in_q, sizeof(via_bench_in_t), VIA_BENCH_IN_DEPTH, 4);
+
+
+// hid_sink.c 가 VIA 응답마다 부른다 — IN 엔드포인트 큐. --via-bench 가 아니면 아무것도 안 한다.
+void simViaBenchResponse(const char *transport, const uint8_t *data, uint16_t len)
+{
+  via_bench_in_t item = {0};
+
+  if (!via_bench_on || transport[0] != 'u')
+  {
+    return;
+  }
+
+  item.queued_us = micros();
+  memcpy(item.data, data, MIN(len, sizeof(item.data)));
+  if (k_msgq_put(&via_bench_in_q, &item, K_NO_WAIT) != 0)
+  {
+    in_drop++;
+  }
+}
+
+// us 가 든 프레임의 시작. 올림이면 안 된다 — k_usleep 은 틱 하나를 더 자서(상대 타임아웃 +1 틱)
+// 깨어난 시각이 늘 프레임 경계를 살짝 넘고, 올리면 호스트가 OUT 뒤마다 프레임 하나를 버린다.
+static uint32_t frame_at(uint32_t us)
+{
+  return (us / VIA_BENCH_FRAME_US) * VIA_BENCH_FRAME_US;
+}
+
+static void sleep_until(uint32_t us)
+{
+  uint32_t now = micros();
+
+  if ((int32_t)(us - now) > 0)
+  {
+    k_usleep(us - now);
+  }
+}
+
+// OUT 프레임 하나. 풀이 차서 받지 않으면 다음 프레임에 다시 보낸다(실보드는 NAK 없이 버리지만,
+// 여기선 규약대로 도는 호스트를 재려는 것이라 재시도로 둔다).
+static void host_out(const uint8_t *data)
+{
+  uint8_t report[32];
+
+  for (;;)
+  {
+    uint32_t t = frame_at(MAX(micros(), out_next_us));
+
+    sleep_until(t);
+    out_next_us = t + VIA_BENCH_FRAME_US;
+
+    memcpy(report, data, sizeof(report));
+    if (simUsbViaReceive(report, sizeof(report)))
+    {
+      report_cnt++;
+      return;
+    }
+  }
+}
+
+// IN 프레임마다 하나씩 꺼낸다. 이 프레임이 시작하기 전에 큐에 든 것만 — 한도 안에 없으면 false.
+static bool host_in(uint8_t *data)
+{
+  uint32_t       start = micros();
+  via_bench_in_t item;
+
+  while (micros() - start < VIA_BENCH_TIMEOUT_US)
+  {
+    uint32_t t = frame_at(MAX(micros(), in_next_us));
+
+    sleep_until(t);
+    in_next_us = t + VIA_BENCH_FRAME_US;
+
+    if (k_msgq_peek(&via_bench_in_q, &item) == 0 && (int32_t)(t - item.queued_us) > 0)
+    {
+      k_msgq_get(&via_bench_in_q, &item, K_NO_WAIT);
+      memcpy(data, item.data, sizeof(item.data));
+      out_next_us = MAX(out_next_us, t + VIA_BENCH_FRAME_US);
+      report_cnt++;
+      return true;
+    }
+  }
+  return false;
+}
+
+// 보낸 명령의 응답까지 기다린다(순정 VIA 호스트처럼 요청 하나에 응답 하나).
+static bool host_xfer(uint8_t *data)
+{
+  uint8_t id = data[0];
+
+  host_out(data);
+  while (host_in(data))
+  {
+    if (data[0] == id)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+static bool percmd_read(uint8_t *dst, uint16_t len)
+{
+  uint8_t data[32];
+
+  for (uint16_t off = 0; off < len; off += VIA_BENCH_CMD_DATA)
+  {
+    uint8_t n = MIN(VIA_BENCH_CMD_DATA, len - off);
+
+    memset(data, 0, sizeof(data));
+    data[0] = id_dynamic_keymap_get_buffer;
+    data[1] = off >> 8;
+    data[2] = off & 0xFF;
+    data[3] = n;
+    if (!host_xfer(data))
+    {
+      return false;
+    }
+    memcpy(&dst[off], &data[4], n);
+  }
+  return true;
+}
+
+static bool percmd_write(uint8_t *src, uint16_t len)
+{
+  uint8_t data[32];
+
+  for (uint16_t off = 0; off < len; off += VIA_BENCH_CMD_DATA)
+  {
+    uint8_t n = MIN(VIA_BENCH_CMD_DATA, len - off);
+
+    memset(data, 0, sizeof(data));
+    data[0] = id_dynamic_keymap_set_buffer;
+    data[1] = off >> 8;
+    data[2] = off & 0xFF;
+    data[3] = n;
+    memcpy(&data[4], &src[off], n);
+    if (!host_xfer(data))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool bulk_end(const uint8_t *buf, uint16_t len)
+{
+  uint8_t  data[32] = {0};
+  uint32_t crc      = crc32_ieee(buf, len);
+
+  data[0] = ID_QMK_BULK_END;
+  data[1] = crc >> 24;
+  data[2] = crc >> 16;
+  data[3] = crc >> 8;
+  data[4] = crc >> 0;
+  return host_xfer(data) && data[1] == VIA_BULK_OK;
+}
+
+static bool bulk_read(uint8_t *dst, uint16_t len)
+{
+  uint8_t  data[32] = {0};
+  uint16_t chunks;
+  uint16_t next = 0;
+
+  data[0] = ID_QMK_BULK_READ;
+  data[1] = VIA_BULK_REGION_KEYMAP;
+  data[4] = len >> 8;
+  data[5] = len & 0xFF;
+  data[6] = VIA_BULK_WINDOW_MAX;
+  if (!host_xfer(data) || data[1] != VIA_BULK_OK)
+  {
+    return false;
+  }
+  chunks = (data[2] << 8) | data[3];
+
+  while (next < chunks)
+  {
+    if (!host_in(data))
+    {
+      return false;
+    }
+    if (data[0] != ID_QMK_BULK_DATA || data[1] != (uint8_t)next)
+    {
+      continue;
+    }
+    memcpy(&dst[next * VIA_BENCH_CHUNK], &data[2], MIN(VIA_BENCH_CHUNK, len - next * VIA_BENCH_CHUNK));
+    next++;
+
+    // 청크마다 누적 ACK — 디바이스가 윈도우를 밀어 다음 청크를 흘린다.
+    memset(data, 0, sizeof(data));
+    data[0] = ID_QMK_BULK_ACK;
+    data[1] = (uint8_t)next;
+    host_out(data);
+  }
+  return bulk_end(dst, len);
+}
+
+static bool bulk_write(uint8_t *src, uint16_t len)
+{
+  uint8_t  data[32] = {0};
+  uint16_t chunks   = (len + VIA_BENCH_CHUNK - 1) / VIA_BENCH_CHUNK;
+  uint16_t next     = 0;
+
+  data[0] = ID_QMK_BULK_WRITE;
+  data[1] = VIA_BULK_REGION_KEYMAP;
+  data[4] = len >> 8;
+  data[5] = len & 0xFF;
+  data[6] = VIA_BULK_WINDOW_MAX;
+  if (!host_xfer(data) || data[1] != VIA_BULK_OK)
+  {
+    return false;
+  }
+
+  while (next < chunks)
+  {
+    uint16_t win_end = MIN(next + VIA_BULK_WINDOW_MAX, chunks);
+
+    for (; next < win_end; next++)
+    {
+      memset(data, 0, sizeof(data));
+      data[0] = ID_QMK_BULK_DATA;
+      data[1] = (uint8_t)next;
+      memcpy(&data[2], &src[next * VIA_BENCH_CHUNK], MIN(VIA_BENCH_CHUNK, len - next * VIA_BENCH_CHUNK));
+      host_out(data);
+    }
+
+    // 윈도우마다 디바이스 ACK 를 기다린다. rewind 면 디바이스가 받은 곳부터 다시
+    // (청크 수 <= VIA_BENCH_MAX_BYTES / 30 < 256 이라 seq 가 곧 청크 인덱스다).
+    do
+    {
+      if (!host_in(data))
+      {
+        return false;
+      }
+    } while (data[0] != ID_QMK_BULK_ACK);
+
+    if (data[2] & 0x01)
+    {
+      next = data[1];
+    }
+  }
+  return bulk_end(src, len);
+}
+
+
+static bool via_bench_run(bool (*fn)(uint8_t *, uint16_t), uint8_t *buf, uint16_t len, via_bench_run_t *run)
+{
+  uint32_t start;
+  bool     ok;
+
+  k_msgq_purge(&via_bench_in_q);
+  report_cnt = 0;
+  start      = frame_at(micros()) + VIA_BENCH_FRAME_US;   // 다음 프레임 경계에서 시작
+  sleep_until(start);
+  out_next_us = start;
+  in_next_us  = start;
+
+  ok = fn(buf, len);
+
+  run->us      = micros() - start;
+  run->reports = report_cnt;
+  return ok;
+}
+
+static void via_bench_print(const char *name, via_bench_run_t *percmd, via_bench_run_t *bulk)
+{
+  printk("\"%s\":{\"percmd_us\":%u,\"bulk_us\":%u,\"percmd_reports\":%u,\"bulk_reports\":%u}",
+         name, percmd->us, bulk->us, percmd->reports, bulk->reports);
+}
+
+static void via_bench_thread(void *p1, void *p2, void *p3)
+{
+  via_bench_run_t rd[2] = {0};
+  via_bench_run_t wr[2] = {0};
+  uint16_t        len = dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+  bool            ok  = true;
+
+  ARG_UNUSED(p1);
+  ARG_UNUSED(p2);
+  ARG_UNUSED(p3);
+
+  if (!via_bench_on)
+  {
+    return;
+  }
+  if (sim_usb_off || len > VIA_BENCH_MAX_BYTES)
+  {
+    printk("[E_] via bench: needs USB, keymap %u B\n", len);
+    posix_exit(1);
+  }
+
+  // 읽기: 두 방식이 같은 바이트를 내야 한다.
+  ok = ok && via_bench_run(percmd_read, buf_a, len, &rd[0]);
+  ok = ok && via_bench_run(bulk_read, buf_b, len, &rd[1]);
+  ok = ok && memcmp(buf_a, buf_b, len) == 0;
+
+  // 쓰기: 방식마다 다른 무늬를 쓰고 반대 방식으로 읽어 맞춘다. 끝에 원래 키맵을 되돌린다.
+  for (uint16_t i = 0; i < len; i++)
+  {
+    buf_b[i] = (uint8_t)(i * 7 + 1);
+  }
+  ok = ok && via_bench_run(percmd_write, buf_b, len, &wr[0]);
+  ok = ok && bulk_read(buf_b, len);
+  for (uint16_t i = 0; i < len; i++)
+  {
+    ok = ok && buf_b[i] == (uint8_t)(i * 7 + 1);
+    buf_b[i] = (uint8_t)(i * 13 + 5);
+  }
+  ok = ok && via_bench_run(bulk_write, buf_b, len, &wr[1]);
+  ok = ok && percmd_read(buf_b, len);
+  for (uint16_t i = 0; i < len; i++)
+  {
+    ok = ok && buf_b[i] == (uint8_t)(i * 13 + 5);
+  }
+  ok = ok && bulk_write(buf_a, len);
+
+  if (!ok)
+  {
+    printk("BENCH {\"via\":{\"bytes\":%u,\"in_drop\":%u,\"match\":false}}\n", len, in_drop);
+    posix_exit(1);
+  }
+
+  printk("BENCH {\"via\":{\"bytes\":%u,", len);
+  via_bench_print("read", &rd[0], &rd[1]);
+  printk(",");
+  via_bench_print("write", &wr[0], &wr[1]);
+  printk(",\"in_drop\":%u,\"match\":true}}\n", in_drop);
+
+  posix_exit(0);
+}
+
+K_THREAD_DEFINE(via_bench_tid,
+                _HW_DEF_RTOS_THREAD_MEM_SIM_VIA,
+                via_bench_thread, NULL, NULL, NULL,
+                _HW_DEF_RTOS_THREAD_PRI_SIM_VIA, 0, VIA_BENCH_START_MS);
+
+
+static void via_bench_add_options(void)
+{
+  static struct args_struct_t via_bench_args[] = {
+    {
+      .is_switch = true,
+      .option    = "via-bench",
+      .type      = 'b',
+      .dest      = (void *)&via_bench_on,
+      .descript  = "After boot, read and write the keymap over USB VIA per command and in bulk at 1ms frames, then exit",
+    },
+    ARG_TABLE_ENDMARKER
+  };
+
+  native_add_command_line_opts(via_bench_args);
+}
+
+NATIVE_TASK(via_bench_add_options, PRE_BOOT_1, 10);
@@ -0,0 +1,279 @@
+#include "sim.h"
+#include "qmk/qmk.h"
+#include "via.h"
+#include "cmdline.h"
+#include "posix_native_task.h"
+#include "posix_board_if.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+/*
+ * VIA 수신 스트레스 — `--via-stress=<n>` 일 때 USB 와 BLE 양쪽에서 VIA 리포트를 n 개씩 **동시에** 밀어 넣는다.
+ *
+ * 생산자는 실보드의 수신 컨텍스트 자리에서 수신 콜백을 부른다(simUsbViaReceive / simBleViaReceive):
+ *   USB : k_timer 만료 함수 = **ISR**. 실보드의 usbd_next 스레드처럼 메인 루프보다 높아 소비자를 선점한다
+ *   BLE : 스레드(BT RX 자리) — 블록/양보 지점에서만 바뀐다
+ * 처리는 실보드처럼 메인 루프의 via_hid_task() 다(§3.2).
+ * 요청은 통로마다 자기 키 하나씩(마지막 레이어, USB = row 0, BLE = row 1)에 set_keycode -> get_keycode 를
+ * 번갈아 보낸다. 응답은 hid_sink.c 가 simViaStressResponse() 로 넘기고, 여기서 순서대로 맞춰 본다:
+ *   - 응답 수 = 받아들여진 요청 수(통로별)
+ *   - k 번째 응답은 k 번째 요청의 명령이고, get 은 **그 통로가 방금 쓴 키코드**를 돌려준다
+ * 응답이 다른 통로로 새거나, 풀 버퍼가 처리 중에 덮이거나, 링이 순서를 잃으면 mismatch 로 잡힌다.
+ *
+ * USB 는 150µs 마다, BLE 는 0~400µs 로 흔든 간격으로 보낸다 — 간격이 짧게 이어지면 버스트가 풀(8)을 채워
+ * 수신 콜백이 false 를 돌려준다. 그건 실패가 아니라 nobuf 로 세고 같은 요청을 다시 보낸다(규약대로 도는
+ * 호스트가 재시도하는 것과 같다). 다 끝나면 요약 한 줄을 찍고 종료한다 — mismatch 나 빠진 응답이 있으면 exit 1:
+ *   VIA {"stress":{"n":2000,"preempt":..,"usb":{"sent":2000,"nobuf":..,"resp":2000,"mismatch":0},"ble":{...}}}
+ *
+ * [선점] native_sim 은 코드가 도는 동안 시뮬레이션 시각이 흐르지 않아 ISR 도 소비자 한가운데엔 못 온다.
+ * 그래서 via_hid.c 가 소비자 단계 사이(tail 읽기 / head 비교 / 슬롯 읽기 / tail 공개 / 처리 / unref)에
+ * VIA_RX_RACE_POINT() 를 두고, 여기서 그때마다 0~60µs 를 k_busy_wait 로 흘린다. native_sim 의 busy wait 는
+ * CPU 를 잡은 채 시각을 보내고 그 사이 온 인터럽트를 바로 처리한다 — USB 타이머 ISR 이 그 틈에 끼어든다.
+ * 끼어든 횟수를 preempt 로 센다. 0 이면 경쟁을 한 번도 못 만든 실행이라 실패로 본다.
+ * 경쟁의 판정 기준은 위와 같다: 응답 순서·개수·값. 생산자 쪽(슬롯 쓰기 -> head 공개)은 소비자가 더 낮은
+ * 우선순위라 실보드에서도 선점당하지 않으므로 여기서 흔들지 않는다.
+ * 키맵 쓰기는 EEPROM 파일(--eeprom)에 남는다 — 빈 임시 파일로 돌릴 것.
+ */
+#define VIA_STRESS_START_MS   1000    // 부팅 정착 뒤에 시작한다(트레이스와 같은 자리)
+#define VIA_STRESS_DRAIN_MS   1000    // 마지막 요청 뒤 응답을 기다리는 한도
+#define VIA_STRESS_ISR_US     150     // USB 타이머 ISR 주기 — 리포트 하나씩
+#define VIA_STRESS_RACE_US    60      // 선점 자리마다 흘리는 시각의 상한
+
+enum
+{
+  VIA_STRESS_USB = 0,
+  VIA_STRESS_BLE,
+  VIA_STRESS_MAX,
+};
+
+typedef struct
+{
+  uint32_t sent;       // 받아들여진 요청
+  uint32_t nobuf;      // 수신 콜백이 false — 다시 보냈다
+  uint32_t resp;
+  uint32_t mismatch;
+} via_stress_stat_t;
+
+static uint32_t          via_stress_n = 0;
+static via_stress_stat_t stat[VIA_STRESS_MAX];
+static atomic_t          done_cnt;
+static volatile bool     usb_isr_on  = false;
+static uint32_t          race_cnt    = 0;
+static uint32_t          preempt_cnt = 0;   // 선점 자리에서 USB ISR 이 실제로 끼어든 횟수
+
+
+// i 번째 요청: 짝수 = set_keycode, 홀수 = 바로 앞 set 의 키를 get. 키코드는 통로마다 다른 범위다.
+static uint8_t via_stress_col(uint32_t i)
+{
+  return (i / 2) % MATRIX_COLS;
+}
+
+static uint16_t via_stress_keycode(uint8_t t, uint32_t i)
+{
+  return (t == VIA_STRESS_USB) ? KC_A + (i / 2) % 26 : KC_1 + (i / 2) % 10;
+}
+
+// is_reply 면 그 요청에 와야 할 응답 — set 은 그대로 돌아오고, get 은 빈 자리에 키코드가 채워진다.
+static void via_stress_build(uint8_t t, uint32_t i, uint8_t *data, bool is_reply)
+{
+  uint16_t kc = via_stress_keycode(t, i);
+
+  memset(data, 0, 32);
+  data[0] = (i & 1) ? id_dynamic_keymap_get_keycode : id_dynamic_keymap_set_keycode;
+  data[1] = DYNAMIC_KEYMAP_LAYER_COUNT - 1;
+  data[2] = (t == VIA_STRESS_USB) ? 0 : 1;
+  data[3] = via_stress_col(i);
+  if ((i & 1) == 0 || is_reply)
+  {
+    data[4] = kc >> 8;
+    data[5] = kc & 0xFF;
+  }
+}
+
+// hid_sink.c 가 VIA 응답마다 부른다. --via-stress 가 아니면 아무것도 안 한다.
+void simViaStressResponse(const char *transport, const uint8_t *data, uint16_t len)
+{
+  if (via_stress_n == 0)
+  {
+    return;
+  }
+
+  uint8_t            t  = (transport[0] == 'u') ? VIA_STRESS_USB : VIA_STRESS_BLE;
+  via_stress_stat_t *st = &stat[t];
+  uint32_t           i  = st->resp++;
+  uint8_t            expect[32];
+
+  via_stress_build(t, i, expect, true);
+  if (len < 6 || memcmp(data, expect, 6) != 0)
+  {
+    st->mismatch++;
+  }
+}
+
+static void via_stress_summary(void)
+{
+  bool ok = true;
+
+  printk("VIA {\"stress\":{\"n\":%u,\"preempt\":%u", via_stress_n, preempt_cnt);
+  for (uint8_t t = 0; t < VIA_STRESS_MAX; t++)
+  {
+    via_stress_stat_t *st = &stat[t];
+
+    printk(",\"%s\":{\"sent\":%u,\"nobuf\":%u,\"resp\":%u,\"mismatch\":%u}", t == VIA_STRESS_USB ? "usb" : "ble",
+           st->sent, st->nobuf, st->resp, st->mismatch);
+    ok = ok && st->mismatch == 0 && st->resp == st->sent;
+  }
+  printk("}}\n");
+
+  posix_exit((ok && preempt_cnt > 0) ? 0 : 1);
+}
+
+// via_hid.c 의 소비자 단계 사이(VIA_RX_RACE_POINT). USB ISR 이 도는 동안만 시각을 흘린다.
+void simViaRacePoint(void)
+{
+  if (!usb_isr_on)
+  {
+    return;
+  }
+
+  uint32_t sent = stat[VIA_STRESS_USB].sent + stat[VIA_STRESS_USB].nobuf;
+
+  race_cnt++;
+  k_busy_wait((race_cnt * 37) % (VIA_STRESS_RACE_US + 1));
+  if (stat[VIA_STRESS_USB].sent + stat[VIA_STRESS_USB].nobuf != sent)
+  {
+    preempt_cnt++;
+  }
+}
+
+// USB 생산자 — 타이머 ISR 에서 리포트 하나. 풀이 차면 세고 다음 만료에 같은 요청을 다시 보낸다.
+static void via_stress_usb_isr(struct k_timer *timer)
+{
+  via_stress_stat_t *st = &stat[VIA_STRESS_USB];
+  uint8_t            data[32];
+
+  if (st->sent >= via_stress_n)
+  {
+    k_timer_stop(timer);
+    usb_isr_on = false;
+    return;
+  }
+
+  via_stress_build(VIA_STRESS_USB, st->sent, data, false);
+  if (simUsbViaReceive(data, sizeof(data)))
+  {
+    st->sent++;
+  }
+  else
+  {
+    st->nobuf++;
+  }
+}
+
+K_TIMER_DEFINE(via_stress_usb_timer, via_stress_usb_isr, NULL);
+
+// 통로의 요청을 다 넣은 뒤 응답을 기다리고, 나중에 끝난 쪽이 요약한다.
+static void via_stress_finish(via_stress_stat_t *st)
+{
+  for (uint32_t ms = 0; st->resp < st->sent && ms < VIA_STRESS_DRAIN_MS; ms++)
+  {
+    k_msleep(1);
+  }
+
+  if (atomic_inc(&done_cnt) == VIA_STRESS_MAX - 1)
+  {
+    via_stress_summary();
+  }
+}
+
+static void via_stress_thread(void *p1, void *p2, void *p3)
+{
+  uint8_t            t  = (uint8_t)(uintptr_t)p1;
+  via_stress_stat_t *st = &stat[t];
+  uint8_t            data[32];
+
+  ARG_UNUSED(p2);
+  ARG_UNUSED(p3);
+
+  if (via_stress_n == 0)
+  {
+    return;
+  }
+  if (sim_usb_off || !sim_ble_on)
+  {
+    printk("[E_] via stress: needs USB and --ble\n");
+    posix_exit(1);
+  }
+
+  if (t == VIA_STRESS_USB)
+  {
+    // USB 는 ISR 이 보낸다. 이 스레드는 시작시키고 끝나길 기다릴 뿐이다.
+    usb_isr_on = true;
+    k_timer_start(&via_stress_usb_timer, K_USEC(VIA_STRESS_ISR_US), K_USEC(VIA_STRESS_ISR_US));
+    while (usb_isr_on)
+    {
+      k_msleep(1);
+    }
+    via_stress_finish(st);
+    return;
+  }
+
+  for (uint32_t i = 0; i < via_stress_n; i++)
+  {
+    via_stress_build(t, i, data, false);
+
+    if (!simBleViaReceive(data, sizeof(data)))
+    {
+      // 풀이 찼다 — 메인 루프가 비울 때까지 비켜 준다. 수신 콜백이 이미 데이터를 복사했으니 data 는 그대로다.
+      st->nobuf++;
+      i--;
+      k_sleep(K_USEC(100));
+      continue;
+    }
+    st->sent++;
+
+    uint32_t gap_us = ((i * 37 + t * 11) % 5) * 100;
+
+    if (gap_us > 0)
+    {
+      k_sleep(K_USEC(gap_us));
+    }
+    else
+    {
+      k_yield();
+    }
+  }
+
+  via_stress_finish(st);
+}
+
+K_THREAD_DEFINE(via_stress_usb_tid,
+                _HW_DEF_RTOS_THREAD_MEM_SIM_VIA,
+                via_stress_thread, (void *)VIA_STRESS_USB, NULL, NULL,
+                _HW_DEF_RTOS_THREAD_PRI_SIM_VIA, 0, VIA_STRESS_START_MS);
+
+K_THREAD_DEFINE(via_stress_ble_tid,
+                _HW_DEF_RTOS_THREAD_MEM_SIM_VIA,
+                via_stress_thread, (void *)VIA_STRESS_BLE, NULL, NULL,
+                _HW_DEF_RTOS_THREAD_PRI_SIM_VIA, 0, VIA_STRESS_START_MS);
+
+
+static void via_stress_add_options(void)
+{
+  static struct args_struct_t via_stress_args[] = {
+    {
+      .option    = "via-stress",
+      .name      = "n",
+      .type      = 'u',
+      .dest      = (void *)&via_stress_n,
+      .descript  = "Push n VIA reports each from a USB timer ISR and a BLE thread, check every reply, then exit",
+    },
+    ARG_TABLE_ENDMARKER
+  };
+
+  native_add_command_line_opts(via_stress_args);
+}
+
+NATIVE_TASK(via_stress_add_options, PRE_BOOT_1, 10);